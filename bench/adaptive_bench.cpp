@@ -0,0 +1,112 @@
+#include "physics/adaptive.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Steps/ray and wall time: fixed-step RK4 vs adaptive DOPRI5
+//  Accuracy of both is measured against a tight-tolerance
+//  (rtol 1e-12) adaptive reference; the cheapest tolerance that
+//  is at least as accurate as the fixed-step path is flagged.
+// ============================================================
+
+static std::vector<Physics::Photon> makeRays(int width, int height) {
+    vec3 cam(0.0, 4.5, 14.0);
+    vec3 fwd = (vec3(0, 0, 0) - cam).normalize();
+    vec3 right = fwd.cross(vec3(0, 1, 0)).normalize();
+    vec3 up = right.cross(fwd);
+
+    std::vector<Physics::Photon> rays;
+    rays.reserve(static_cast<std::size_t>(width) * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double u = ((x + 0.5) / width * 2.0 - 1.0) * width / height;
+            double v = 1.0 - (y + 0.5) / height * 2.0;
+            rays.push_back({ cam, (fwd + right * u + up * v).normalize() });
+        }
+    }
+    return rays;
+}
+
+struct Row {
+    double seconds = 0.0;
+    Physics::TraceStats stats;
+    int mismatched = 0;
+    double maxDiskErr = 0.0;
+    double maxDirErr = 0.0;
+};
+
+template<typename Trace>
+static Row measure(const std::vector<Physics::Photon>& rays, const std::vector<Physics::HitRecord>& ref, Trace trace) {
+    Row row;
+    std::vector<Physics::HitRecord> hits(rays.size());
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < rays.size(); i++) hits[i] = trace(rays[i], row.stats);
+    row.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    for (std::size_t i = 0; i < rays.size(); i++) {
+        if (hits[i].target != ref[i].target) { row.mismatched++; continue; }
+        if (ref[i].target == Physics::HitTarget::ACCRETION_DISK)
+            row.maxDiskErr = std::max(row.maxDiskErr, std::abs(hits[i].diskR - ref[i].diskR));
+        if (ref[i].target == Physics::HitTarget::BACKGROUND_SKY)
+            row.maxDirErr = std::max(row.maxDirErr, (hits[i].dir - ref[i].dir).length());
+    }
+    return row;
+}
+
+static void printRow(const char* name, const Row& row, double n, bool matched) {
+    std::printf("  %-14s %9.1f %8.2f %9.3f %9.3g %9.3g %6d %s\n", name,
+                row.stats.steps / n, row.stats.rejected / n, row.seconds * 1e3,
+                row.maxDiskErr, row.maxDirErr, row.mismatched, matched ? "<- matched" : "");
+}
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 160;
+    int height = argc > 2 ? std::atoi(argv[2]) : 120;
+
+    std::vector<Physics::Photon> rays = makeRays(width, height);
+    const double n = static_cast<double>(rays.size());
+
+    Physics::AdaptiveSettings tight;
+    tight.rtol = 1e-12;
+    tight.atol = 1e-14;
+    std::vector<Physics::HitRecord> ref;
+    ref.reserve(rays.size());
+    for (const auto& p : rays) ref.push_back(Physics::tracePhotonAdaptive(p, tight));
+
+    std::cout << "=== Adaptive integrator benchmark: " << rays.size() << " rays ===\n";
+    std::printf("  %-14s %9s %8s %9s %9s %9s %6s\n", "integrator", "steps/ray", "rej/ray",
+                "wall ms", "diskR err", "dir err", "class");
+
+    Row fixed = measure(rays, ref, [](const Physics::Photon& p, Physics::TraceStats& s) {
+        return Physics::tracePhoton(p, &s);
+    });
+    printRow("RK4 h=0.05", fixed, n, false);
+
+    bool matchedOne = false;
+    for (double rtol : { 1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8, 1e-10 }) {
+        Physics::AdaptiveSettings cfg;
+        cfg.rtol = rtol;
+        cfg.atol = rtol * 1e-2;
+        Row row = measure(rays, ref, [&](const Physics::Photon& p, Physics::TraceStats& s) {
+            return Physics::tracePhotonAdaptive(p, cfg, &s);
+        });
+
+        bool matched = !matchedOne && row.mismatched <= fixed.mismatched
+                    && row.maxDiskErr <= fixed.maxDiskErr && row.maxDirErr <= fixed.maxDirErr;
+        matchedOne = matchedOne || matched;
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "DOPRI5 %.0e", rtol);
+        printRow(name, row, n, matched);
+        if (matched) {
+            std::printf("  -> %.1fx fewer steps, %.1fx less wall time than fixed step\n",
+                        double(fixed.stats.steps) / row.stats.steps, fixed.seconds / row.seconds);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "physics/adaptive.hpp"
+#include "physics/binet.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  A/B: Cartesian RK4 (tracePhoton) vs planar Binet engine
+//  Both are scored against a tight-tolerance adaptive reference
+//  on the same camera fan, single thread
+// ============================================================
+
+static std::vector<Physics::Photon> makeRays(int width, int height) {
+    vec3 cam(0.0, 4.5, 14.0);
+    vec3 fwd = (vec3(0, 0, 0) - cam).normalize();
+    vec3 right = fwd.cross(vec3(0, 1, 0)).normalize();
+    vec3 up = right.cross(fwd);
+
+    std::vector<Physics::Photon> rays;
+    rays.reserve(static_cast<std::size_t>(width) * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double u = ((x + 0.5) / width * 2.0 - 1.0) * width / height;
+            double v = 1.0 - (y + 0.5) / height * 2.0;
+            rays.push_back({ cam, (fwd + right * u + up * v).normalize() });
+        }
+    }
+    return rays;
+}
+
+template<typename Trace>
+static void run(const char* name, const std::vector<Physics::Photon>& rays,
+                const std::vector<Physics::HitRecord>& ref, Trace trace) {
+    Physics::TraceStats stats;
+    std::vector<Physics::HitRecord> hits(rays.size());
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < rays.size(); i++) hits[i] = trace(rays[i], &stats);
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    int mismatched = 0;
+    double maxDiskErr = 0.0, maxDirErr = 0.0;
+    for (std::size_t i = 0; i < rays.size(); i++) {
+        if (hits[i].target != ref[i].target) { mismatched++; continue; }
+        if (ref[i].target == Physics::HitTarget::ACCRETION_DISK)
+            maxDiskErr = std::max(maxDiskErr, std::abs(hits[i].diskR - ref[i].diskR));
+        if (ref[i].target == Physics::HitTarget::BACKGROUND_SKY)
+            maxDirErr = std::max(maxDirErr, (hits[i].dir - ref[i].dir).length());
+    }
+
+    double n = static_cast<double>(rays.size());
+    std::printf("  %-12s %12.0f %9.1f %9.3g %9.3g %6d\n", name, n / sec,
+                stats.steps / n, maxDiskErr, maxDirErr, mismatched);
+}
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 160;
+    int height = argc > 2 ? std::atoi(argv[2]) : 120;
+    std::vector<Physics::Photon> rays = makeRays(width, height);
+
+    Physics::AdaptiveSettings tight;
+    tight.rtol = 1e-12;
+    tight.atol = 1e-14;
+    std::vector<Physics::HitRecord> ref;
+    ref.reserve(rays.size());
+    for (const auto& p : rays) ref.push_back(Physics::tracePhotonAdaptive(p, tight));
+
+    std::cout << "=== Geodesic engine A/B: " << rays.size() << " rays ===\n";
+    std::printf("  %-12s %12s %9s %9s %9s %6s\n", "engine", "rays/s", "steps/ray",
+                "diskR err", "dir err", "class");
+    run("cartesian", rays, ref, [](const Physics::Photon& p, Physics::TraceStats* s) {
+        return Physics::tracePhoton(p, s);
+    });
+    run("binet", rays, ref, [](const Physics::Photon& p, Physics::TraceStats* s) {
+        return Physics::tracePhotonBinet(p, s);
+    });
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "render/bloom.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// ============================================================
+//  Bloom pass cost: full-resolution Gaussian vs dual filter
+//  CPU time of the reference implementations on a synthetic HDR
+//  frame, plus the per-frame fragment and texture-fetch counts
+//  of Display's passes at common window sizes (the bloom passes
+//  are fetch-bound, so fetches track GPU pass time).
+// ============================================================
+
+template<typename F>
+static double seconds(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+struct PassCost {
+    double fragments = 0.0;
+    double fetches = 0.0;
+    int passes = 0;
+};
+
+// bloom_blur.frag: 9 fetches per fragment, 2 passes per iteration, full resolution
+static PassCost gaussianCost(int w, int h, int iterations) {
+    double px = static_cast<double>(w) * h;
+    return { 2.0 * iterations * px, 2.0 * iterations * px * 9.0, 2 * iterations };
+}
+
+// bloom_down.frag (5 fetches) into every level, bloom_up.frag (8 fetches) back into all but the last
+static PassCost dualFilterCost(int w, int h, int levels) {
+    PassCost c;
+    auto sizes = Render::Bloom::chainSizes(w, h, levels);
+    for (std::size_t i = 0; i < sizes.size(); i++) {
+        double px = static_cast<double>(sizes[i].first) * sizes[i].second;
+        c.fragments += px;
+        c.fetches += px * 5.0;
+        c.passes++;
+        if (i + 1 < sizes.size()) {
+            c.fragments += px;
+            c.fetches += px * 8.0;
+            c.passes++;
+        }
+    }
+    return c;
+}
+
+int main(int argc, char** argv) {
+    int w = argc > 1 ? std::atoi(argv[1]) : 640;
+    int h = argc > 2 ? std::atoi(argv[2]) : 360;
+
+    // Dim sky with a bright band and a few hot spots, like a lensed disk
+    Image scene(w, h);
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++) {
+            float band = std::abs(y - h / 2) < h / 20 ? 4.0f : 0.02f;
+            scene.set(x, y, band, band * 0.6f, band * 0.3f);
+        }
+    for (int i = 1; i <= 6; i++) scene.set(w * i / 7, h / 2 + (i % 3 - 1) * h / 5, 200.0f, 150.0f, 80.0f);
+
+    Render::BloomSettings dual;
+    std::printf("=== Bloom: %dx%d, Gaussian 8 iterations vs dual filter %d levels ===\n", w, h, dual.levels);
+    Image g, d;
+    double gSec = seconds([&] { g = Render::bloomGaussian(scene, 8); });
+    double dSec = seconds([&] { d = Render::bloomDualFilter(scene, dual); });
+    std::printf("  %-24s %10s\n", "CPU reference", "ms");
+    std::printf("  %-24s %10.2f\n", "Gaussian (full res)", 1000.0 * gSec);
+    std::printf("  %-24s %10.2f  (%.1fx)\n\n", "dual filter", 1000.0 * dSec, gSec / dSec);
+
+    std::printf("  %-12s %-12s %7s %14s %14s %9s\n", "window", "pipeline", "passes", "fragments", "fetches",
+                "vs Gauss");
+    const int sizes[][2] = { { w, h }, { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 } };
+    for (const auto& s : sizes) {
+        PassCost gc = gaussianCost(s[0], s[1], 8), dc = dualFilterCost(s[0], s[1], dual.levels);
+        char window[24];
+        std::snprintf(window, sizeof(window), "%dx%d", s[0], s[1]);
+        std::printf("  %-12s %-12s %7d %14.0f %14.0f %9s\n", window, "Gaussian", gc.passes, gc.fragments, gc.fetches, "1.0x");
+        std::printf("  %-12s %-12s %7d %14.0f %14.0f %8.1fx\n", "", "dual filter", dc.passes, dc.fragments, dc.fetches,
+                    gc.fetches / dc.fetches);
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "render/cpu_renderer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+// ============================================================
+//  ns/ray: per-pixel primaryRayDir vs batched CameraRays
+//  (cached field rotated for a new pose, field rebuild, and
+//  jittered), writing the same SoA PhotonBatch each time
+// ============================================================
+
+template<typename F>
+static double nsPerRay(F&& f, int frames, double rays) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) f(i);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / (frames * rays);
+}
+
+int main(int argc, char** argv) {
+    const int W = argc > 1 ? std::atoi(argv[1]) : 1920;
+    const int H = argc > 2 ? std::atoi(argv[2]) : 1080;
+    const int frames = argc > 3 ? std::atoi(argv[3]) : 20;
+    const double rays = static_cast<double>(W) * H;
+    Camera cam(15.0f, 0.3f, 0.2f);
+    Physics::PhotonBatch batch;
+    auto pose = [&](int i) {
+        cam.yaw = 0.01f * i;
+        cam.update();
+    };
+
+    std::cout << "=== Camera ray generation: " << W << "x" << H << ", " << frames << " frames, " << simd::ISA
+              << " ===\n";
+
+    double perPixel = nsPerRay([&](int i) {
+        pose(i);
+        batch.clear();
+        for (int y = 0; y < H; y++)
+            for (int x = 0; x < W; x++) batch.push({ cam.position, Render::primaryRayDir(cam, x + 0.5, y + 0.5, W, H) });
+    }, frames, rays);
+
+    Render::CameraRays field;
+    field.generate(cam, W, H, batch);
+    double cached = nsPerRay([&](int i) {
+        pose(i);
+        field.generate(cam, W, H, batch);
+    }, frames, rays);
+
+    double rebuild = nsPerRay([&](int i) {
+        cam.fov_scale = 1.0f + 0.001f * (i + 1);
+        field.generate(cam, W, H, batch);
+    }, frames, rays);
+    cam.fov_scale = 1.0f;
+
+    double jittered = nsPerRay([&](int i) {
+        pose(i);
+        field.generateJittered(cam, W, H, static_cast<std::uint32_t>(i), batch);
+    }, frames, rays);
+
+    std::printf("  %-30s %8.2f ns/ray\n", "primaryRayDir per pixel", perPixel);
+    std::printf("  %-30s %8.2f ns/ray  (%.1fx)\n", "CameraRays, new pose", cached, perPixel / cached);
+    std::printf("  %-30s %8.2f ns/ray\n", "CameraRays, resize / FOV", rebuild);
+    std::printf("  %-30s %8.2f ns/ray  (%.1fx)\n", "CameraRays, jittered", jittered, perPixel / jittered);
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "physics/geodesic_table.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Frame cost: per-pixel tracePhoton vs one geodesic table per
+//  camera radius (build once, then one lookup per pixel)
+//  Single thread, same camera fan as the other benchmarks
+// ============================================================
+
+static std::vector<vec3> makeDirs(const vec3& cam, int width, int height) {
+    vec3 fwd = (vec3(0, 0, 0) - cam).normalize();
+    vec3 right = fwd.cross(vec3(0, 1, 0)).normalize();
+    vec3 up = right.cross(fwd);
+
+    std::vector<vec3> dirs;
+    dirs.reserve(static_cast<std::size_t>(width) * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double u = ((x + 0.5) / width * 2.0 - 1.0) * width / height;
+            double v = 1.0 - (y + 0.5) / height * 2.0;
+            dirs.push_back((fwd + right * u + up * v).normalize());
+        }
+    }
+    return dirs;
+}
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 320;
+    int height = argc > 2 ? std::atoi(argv[2]) : 240;
+    int tableSize = argc > 3 ? std::atoi(argv[3]) : 2048;
+
+    vec3 cam(0.0, 4.5, 14.0);
+    std::vector<vec3> dirs = makeDirs(cam, width, height);
+    const double n = static_cast<double>(dirs.size());
+
+    std::cout << "=== Geodesic table benchmark: " << dirs.size() << " rays, "
+              << tableSize << " table orbits ===\n";
+
+    // Per-pixel reference
+    std::vector<Physics::HitRecord> ref(dirs.size());
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < dirs.size(); i++) ref[i] = Physics::tracePhoton(Physics::Photon{ cam, dirs[i] });
+    auto t1 = std::chrono::steady_clock::now();
+
+    // Table: build once per camera radius, then look up every pixel
+    Physics::GeodesicTable table;
+    table.build(cam.length(), tableSize);
+    auto t2 = std::chrono::steady_clock::now();
+    std::vector<Physics::HitRecord> hits(dirs.size());
+    for (std::size_t i = 0; i < dirs.size(); i++) hits[i] = table.lookup(cam, dirs[i]);
+    auto t3 = std::chrono::steady_clock::now();
+
+    int mismatched = 0;
+    double maxDiskErr = 0.0, sumDiskErr = 0.0;
+    int diskHits = 0;
+    for (std::size_t i = 0; i < dirs.size(); i++) {
+        if (hits[i].target != ref[i].target) { mismatched++; continue; }
+        if (ref[i].target == Physics::HitTarget::ACCRETION_DISK) {
+            double e = std::abs(hits[i].diskR - ref[i].diskR);
+            maxDiskErr = std::max(maxDiskErr, e);
+            sumDiskErr += e;
+            diskHits++;
+        }
+    }
+
+    std::size_t samples = 0;
+    for (int i = 0; i < table.size(); i++) samples += table.orbit(i).samples.size();
+
+    double traceSec = std::chrono::duration<double>(t1 - t0).count();
+    double buildSec = std::chrono::duration<double>(t2 - t1).count();
+    double lookupSec = std::chrono::duration<double>(t3 - t2).count();
+
+    std::cout << "  per-pixel tracePhoton : " << traceSec * 1e3 << " ms (" << n / traceSec << " rays/s)\n";
+    std::cout << "  table build           : " << buildSec * 1e3 << " ms ("
+              << samples * sizeof(Physics::GeodesicTable::Sample) / 1024 << " KiB)\n";
+    std::cout << "  table lookup          : " << lookupSec * 1e3 << " ms (" << n / lookupSec << " rays/s)\n";
+    std::cout << "  speedup (build+lookup): " << traceSec / (buildSec + lookupSec) << "x, "
+              << traceSec / lookupSec << "x when the table is reused\n";
+    std::cout << "  class mismatches      : " << mismatched << " (" << 100.0 * mismatched / n << "%)\n";
+    std::cout << "  diskR error vs RK4    : max " << maxDiskErr << ", mean "
+              << (diskHits ? sumDiskErr / diskHits : 0.0) << "\n";
+    return 0;
+}
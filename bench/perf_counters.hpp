@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ============================================================
+//  Linux hardware counters (perf_event_open) for the benchmarks
+//  Counts cycles, instructions and cache misses for the calling
+//  thread and any threads it creates afterwards. Unavailable
+//  counters (non-Linux, perf_event_paranoid, VMs without a PMU)
+//  leave available() false; callers report null.
+// ============================================================
+class PerfCounters {
+public:
+    struct Sample {
+        bool valid = false;
+        std::uint64_t cycles = 0, instructions = 0, cacheMisses = 0;
+    };
+
+    PerfCounters() {
+#if defined(__linux__)
+        fds[0] = open(PERF_COUNT_HW_CPU_CYCLES);
+        fds[1] = open(PERF_COUNT_HW_INSTRUCTIONS);
+        fds[2] = open(PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int fd : fds) if (fd >= 0) close(fd);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return fds[0] >= 0 && fds[1] >= 0 && fds[2] >= 0; }
+
+    void start() {
+#if defined(__linux__)
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    Sample stop() {
+        Sample s;
+#if defined(__linux__)
+        std::uint64_t v[3] = { 0, 0, 0 };
+        for (int i = 0; i < 3; i++) {
+            if (fds[i] < 0) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fds[i], &v[i], sizeof(v[i])) != static_cast<ssize_t>(sizeof(v[i]))) v[i] = 0;
+        }
+        s.valid = available();
+        s.cycles = v[0];
+        s.instructions = v[1];
+        s.cacheMisses = v[2];
+#endif
+        return s;
+    }
+
+private:
+    int fds[3] = { -1, -1, -1 };
+
+#if defined(__linux__)
+    static int open(std::uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.inherit = 1;           // Include pool threads spawned after open
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+};
@@ -0,0 +1,80 @@
+#include "physics/photon_batch.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Rays/sec: SIMD PhotonBatch vs the scalar tracePhoton loop
+//  Same camera fan for both paths, single thread
+// ============================================================
+
+static std::vector<Physics::Photon> makeRays(int width, int height) {
+    vec3 cam(0.0, 4.5, 14.0);
+    vec3 fwd = (vec3(0, 0, 0) - cam).normalize();
+    vec3 right = fwd.cross(vec3(0, 1, 0)).normalize();
+    vec3 up = right.cross(fwd);
+
+    std::vector<Physics::Photon> rays;
+    rays.reserve(static_cast<std::size_t>(width) * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double u = ((x + 0.5) / width * 2.0 - 1.0) * width / height;
+            double v = 1.0 - (y + 0.5) / height * 2.0;
+            rays.push_back({ cam, (fwd + right * u + up * v).normalize() });
+        }
+    }
+    return rays;
+}
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 160;
+    int height = argc > 2 ? std::atoi(argv[2]) : 120;
+
+    std::vector<Physics::Photon> rays = makeRays(width, height);
+    Physics::PhotonBatch batch;
+    for (const auto& p : rays) batch.push(p);
+
+    std::cout << "=== PhotonBatch benchmark: " << rays.size() << " rays, "
+              << simd::ISA << " (" << simd::dpack::N << " lanes) ===\n";
+
+    // Scalar reference
+    auto t0 = std::chrono::steady_clock::now();
+    int scalarDisk = 0;
+    for (const auto& p : rays) {
+        if (Physics::tracePhoton(p).target == Physics::HitTarget::ACCRETION_DISK) scalarDisk++;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // Batched
+    std::vector<Physics::HitRecord> hits = Physics::traceBatch(batch);
+    auto t2 = std::chrono::steady_clock::now();
+    int batchDisk = 0;
+    for (const auto& h : hits) {
+        if (h.target == Physics::HitTarget::ACCRETION_DISK) batchDisk++;
+    }
+
+    // Batched float (twice the lanes per instruction)
+    Physics::BasicPhotonBatch<float> fbatch;
+    for (const auto& p : rays) fbatch.push({ fvec3(p.pos), fvec3(p.vel) });
+    auto t3 = std::chrono::steady_clock::now();
+    auto fhits = Physics::traceBatch(fbatch);
+    auto t4 = std::chrono::steady_clock::now();
+
+    double scalarSec = std::chrono::duration<double>(t1 - t0).count();
+    double batchSec = std::chrono::duration<double>(t2 - t1).count();
+    double floatSec = std::chrono::duration<double>(t4 - t3).count();
+    double n = static_cast<double>(rays.size());
+
+    std::cout << "  tracePhoton loop : " << n / scalarSec << " rays/s\n";
+    std::cout << "  traceBatch       : " << n / batchSec << " rays/s\n";
+    std::cout << "  speedup          : " << scalarSec / batchSec << "x\n";
+    std::cout << "  traceBatch float : " << n / floatSec << " rays/s (" << simd::fpack::N << " lanes)\n";
+    int floatDisk = 0;
+    for (const auto& h : fhits) {
+        if (h.target == Physics::HitTarget::ACCRETION_DISK) floatDisk++;
+    }
+    std::cout << "  disk hits        : " << scalarDisk << " scalar / " << batchDisk << " batched / "
+              << floatDisk << " float\n";
+    return scalarDisk == batchDisk ? 0 : 1;
+}
@@ -0,0 +1,463 @@
+#include "perf_counters.hpp"
+#include "physics/raytracer.hpp"
+#include "render/thread_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================
+//  Physics kernel benchmark suite
+//  Micro: calculateAcceleration ns/call, stepRK4 ns/step
+//  Macro: tracePhoton over impact-parameter sweeps (captured,
+//         near-critical b ≈ 3√3 M, disk-hitting, escaping):
+//         rays/s, ns/step, steps/ray distribution; the mean, p99
+//         and the worst ray are all gated against the baseline
+//  Scaling: the mixed workload on 1..N pool threads
+//  Optional Linux hardware counters, JSON output, and a stored
+//  baseline: any metric worse than --tolerance fails the run.
+//
+//    ./bench/physics_bench --json out.json --baseline physics_baseline.json
+//    ./bench/physics_bench --save-baseline physics_baseline.json
+// ============================================================
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps `value` alive without letting the compiler see how it is used
+template<typename T>
+static inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+static double secondsSince(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+struct Workload {
+    std::string name;
+    std::vector<Physics::Photon> rays;
+};
+
+// Equatorial ray from r0 = 19 with impact parameter b. The orbit's first integral
+// u'² + u² − 2Mu³ = 1/b² puts the launch offset at 1/√(1/b² + 2M/r0³), not b.
+// It stays on y = 0 and never registers a disk crossing.
+static Physics::Photon equatorialRay(double b) {
+    const double r0 = 19.0;
+    double x = 1.0 / std::sqrt(1.0 / (b * b) + 2.0 * Physics::M / (r0 * r0 * r0));
+    return { vec3(x, 0.0, -std::sqrt(r0 * r0 - x * x)), vec3(0.0, 0.0, 1.0) };
+}
+
+static Workload equatorialSweep(const std::string& name, double b0, double b1, int n) {
+    Workload w{ name, {} };
+    for (int i = 0; i < n; i++) w.rays.push_back(equatorialRay(b0 + (b1 - b0) * i / (n - 1)));
+    return w;
+}
+
+// Alternating either side of the critical impact parameter 3√3 M with log-spaced
+// offsets 1e-4 .. 2e-2: photons wind around the photon sphere before they fall
+// in or escape, the worst case for any fixed-step integrator
+static Workload nearCriticalSweep(int n) {
+    Workload w{ "near_critical", {} };
+    const double bc = 3.0 * std::sqrt(3.0) * Physics::M;
+    for (int i = 0; i < n; i++) {
+        double t = n > 2 ? static_cast<double>(i / 2) / ((n - 1) / 2) : 0.0;
+        w.rays.push_back(equatorialRay(bc + (i % 2 ? 1.0 : -1.0) * 1e-4 * std::pow(200.0, t)));
+    }
+    return w;
+}
+
+// Inclined camera aimed at disk radii 3.5 .. 11.5 around the annulus
+static Workload diskSweep(int n) {
+    Workload w{ "disk", {} };
+    const vec3 cam(0.0, 6.0, 16.0);
+    for (int i = 0; i < n; i++) {
+        double r = 3.5 + 8.0 * ((i * 0.618034) - std::floor(i * 0.618034));
+        double phi = 2.0 * M_PI * i / n;
+        vec3 target(r * std::cos(phi), 0.0, r * std::sin(phi));
+        w.rays.push_back({ cam, (target - cam).normalize() });
+    }
+    return w;
+}
+
+struct TraceResult {
+    double raysPerSec = 0.0, nsPerStep = 0.0;
+    double meanSteps = 0.0;
+    long totalSteps = 0, minSteps = 0, p50 = 0, p90 = 0, p99 = 0, maxSteps = 0;
+    int captured = 0, disk = 0, escaped = 0;
+    PerfCounters::Sample counters;
+};
+
+static TraceResult benchTrace(const Workload& w, int repeat, bool perf) {
+    TraceResult res;
+    std::vector<long> steps(w.rays.size());
+    double best = 1e300;
+    PerfCounters::Sample bestCounters;
+
+    // Analytically resolved sweeps finish in microseconds, below the clock's
+    // noise: repeat the sweep inside each timing until it spans ~20 ms
+    int passes = 1;
+    for (int rep = -1; rep < repeat; rep++) {
+        PerfCounters counters;
+        bool counting = rep >= 0 && perf && counters.available();
+        if (counting) counters.start();
+        auto t0 = Clock::now();
+        for (int pass = 0; pass < passes; pass++) {
+            res.captured = res.disk = res.escaped = 0;
+            for (std::size_t i = 0; i < w.rays.size(); i++) {
+                Physics::TraceStats stats;
+                Physics::HitRecord hit = Physics::tracePhoton(w.rays[i], &stats);
+                doNotOptimize(hit);
+                steps[i] = stats.steps;
+                if (hit.target == Physics::HitTarget::BLACK_HOLE) res.captured++;
+                else if (hit.target == Physics::HitTarget::ACCRETION_DISK) res.disk++;
+                else res.escaped++;
+            }
+        }
+        double sec = secondsSince(t0) / passes;
+        PerfCounters::Sample sample = counting ? counters.stop() : PerfCounters::Sample{};
+        if (rep < 0) {
+            // Calibration pass (also warms the caches)
+            passes = static_cast<int>(std::clamp(std::ceil(0.02 / std::max(sec, 1e-9)), 1.0, 1e4));
+            continue;
+        }
+        if (sec < best) {
+            best = sec;
+            sample.cycles /= passes;
+            sample.instructions /= passes;
+            sample.cacheMisses /= passes;
+            bestCounters = sample;
+        }
+    }
+
+    std::vector<long> sorted = steps;
+    std::sort(sorted.begin(), sorted.end());
+    long total = 0;
+    for (long s : sorted) total += s;
+    auto pct = [&](double p) { return sorted[static_cast<std::size_t>(p * (sorted.size() - 1))]; };
+
+    const double n = static_cast<double>(w.rays.size());
+    res.raysPerSec = n / best;
+    // Rays resolved without a single step (analytic capture) have no per-step cost
+    res.totalSteps = total;
+    res.nsPerStep = total > 0 ? best * 1e9 / static_cast<double>(total) : 0.0;
+    res.meanSteps = total / n;
+    res.minSteps = sorted.front();
+    res.p50 = pct(0.5);
+    res.p90 = pct(0.9);
+    res.p99 = pct(0.99);
+    res.maxSteps = sorted.back();
+    res.counters = bestCounters;
+    return res;
+}
+
+// calculateAcceleration over a ring of 1024 positions (all inside the working volume)
+static double benchAcceleration(int repeat) {
+    std::vector<vec3> pos, vel;
+    for (int i = 0; i < 1024; i++) {
+        double a = 0.37 * i, r = 3.0 + 15.0 * (i % 97) / 96.0;
+        pos.push_back(vec3(r * std::cos(a), 0.3 * std::sin(3.0 * a), r * std::sin(a)));
+        vel.push_back(vec3(-std::sin(a), 0.1, std::cos(a)).normalize());
+    }
+    const int iters = 2000;
+    double best = 1e300;
+    for (int rep = 0; rep < repeat; rep++) {
+        auto t0 = Clock::now();
+        for (int it = 0; it < iters; it++) {
+            for (std::size_t i = 0; i < pos.size(); i++) {
+                vec3 a = Physics::calculateAcceleration(pos[i], vel[i]);
+                doNotOptimize(a);
+            }
+        }
+        best = std::min(best, secondsSince(t0));
+    }
+    return best * 1e9 / (static_cast<double>(iters) * pos.size());
+}
+
+// One photon on a long weak-field arc (never captured, escape ignored)
+static double benchStep(int repeat) {
+    const int steps = 2000000;
+    double best = 1e300;
+    for (int rep = 0; rep < repeat; rep++) {
+        Physics::Photon p{ vec3(0.0, 0.0, 1e6), vec3(0.3, 0.1, -1.0).normalize() };
+        auto t0 = Clock::now();
+        for (int i = 0; i < steps; i++) Physics::stepRK4(p, Physics::STEP_SIZE);
+        best = std::min(best, secondsSince(t0));
+        doNotOptimize(p);
+    }
+    return best * 1e9 / steps;
+}
+
+// Mixed workload on `threads` pool workers, 64-ray chunks
+static double benchThreads(const std::vector<Physics::Photon>& rays, unsigned threads, int repeat) {
+    const std::size_t chunk = 64, chunks = (rays.size() + chunk - 1) / chunk;
+    ThreadPool pool(threads);
+    double best = 1e300;
+    for (int rep = 0; rep < repeat; rep++) {
+        auto t0 = Clock::now();
+        pool.parallelFor(chunks, [&](std::size_t c, unsigned) {
+            std::size_t end = std::min(rays.size(), (c + 1) * chunk);
+            for (std::size_t i = c * chunk; i < end; i++) {
+                Physics::HitRecord hit = Physics::tracePhoton(rays[i]);
+                doNotOptimize(hit);
+            }
+        });
+        best = std::min(best, secondsSince(t0));
+    }
+    return static_cast<double>(rays.size()) / best;
+}
+
+// --- Baseline comparison -------------------------------------------------
+
+// Reads the flat "metrics": { "name": number, ... } object of a previous run
+static bool readMetrics(const std::string& path, std::map<std::string, double>& out) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Cannot open baseline: " << path << std::endl;
+        return false;
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    const std::string text = ss.str();
+
+    std::size_t at = text.find("\"metrics\"");
+    if (at == std::string::npos || (at = text.find('{', at)) == std::string::npos) {
+        std::cerr << "ERROR: No \"metrics\" object in " << path << std::endl;
+        return false;
+    }
+    const std::size_t end = text.find('}', at);
+    while (true) {
+        std::size_t k0 = text.find('"', at + 1);
+        if (k0 == std::string::npos || k0 > end) break;
+        std::size_t k1 = text.find('"', k0 + 1);
+        std::size_t colon = text.find(':', k1);
+        out[text.substr(k0 + 1, k1 - k0 - 1)] = std::strtod(text.c_str() + colon + 1, nullptr);
+        at = k1 + 1;
+    }
+    return true;
+}
+
+// "_per_s" metrics are throughputs (higher is better); everything else
+// (ns, steps) is a cost (lower is better)
+static bool higherIsBetter(const std::string& name) {
+    return name.size() > 6 && name.compare(name.size() - 6, 6, "_per_s") == 0;
+}
+
+static int compareBaseline(const std::map<std::string, double>& current,
+                           const std::map<std::string, double>& baseline, double tolerance) {
+    int regressions = 0, compared = 0;
+    std::printf("\n  %-34s %14s %14s %9s\n", "metric", "baseline", "current", "change");
+    for (const auto& [name, base] : baseline) {
+        auto it = current.find(name);
+        if (it == current.end()) {
+            std::printf("  %-34s %14.4g %14s %9s\n", name.c_str(), base, "-", "skipped");
+            continue;
+        }
+        compared++;
+        if (base == 0.0) {
+            // A cost that was zero (captured rays take no steps) regresses on any step
+            bool regressed = !higherIsBetter(name) && it->second > 0.0;
+            regressions += regressed;
+            std::printf("  %-34s %14.4g %14.4g %9s%s\n", name.c_str(), base, it->second, "",
+                        regressed ? "  REGRESSION" : "");
+            continue;
+        }
+        double change = (it->second - base) / base;
+        double worse = higherIsBetter(name) ? -change : change;
+        bool regressed = worse > tolerance;
+        regressions += regressed;
+        std::printf("  %-34s %14.4g %14.4g %+8.1f%%%s\n", name.c_str(), base, it->second,
+                    change * 100.0, regressed ? "  REGRESSION" : "");
+    }
+    // Metrics this build measures but the baseline predates are not gated
+    // until the baseline is re-recorded; list them rather than drop them
+    int missing = 0;
+    for (const auto& [name, value] : current) {
+        if (baseline.count(name)) continue;
+        missing++;
+        std::printf("  %-34s %14s %14.4g %9s\n", name.c_str(), "-", value, "new");
+    }
+    if (missing)
+        std::printf("\n  %d metrics not in the baseline (re-record it with --save-baseline)\n", missing);
+    if (regressions) {
+        std::printf("\n*** %d of %d metrics regressed by more than %.0f%% ***\n",
+                    regressions, compared, tolerance * 100.0);
+    } else {
+        std::printf("\n  %d metrics within %.0f%% of baseline\n", compared, tolerance * 100.0);
+    }
+    return regressions;
+}
+
+// --- Output ----------------------------------------------------------------
+
+static std::string counterJson(const PerfCounters::Sample& s, double rays) {
+    if (!s.valid) return "null";
+    std::ostringstream o;
+    o << "{ \"cycles_per_ray\": " << s.cycles / rays << ", \"instructions_per_ray\": " << s.instructions / rays
+      << ", \"ipc\": " << (s.cycles ? double(s.instructions) / s.cycles : 0.0)
+      << ", \"cache_misses_per_ray\": " << s.cacheMisses / rays << " }";
+    return o.str();
+}
+
+static void printUsage() {
+    std::cout << "Usage: physics_bench [options]\n"
+              << "  --rays N            Rays per impact-parameter sweep (default 2000)\n"
+              << "  --threads N         Scale the mixed workload over 1..N threads (default: all cores)\n"
+              << "  --repeat N          Repetitions, best time is reported (default 3)\n"
+              << "  --perf              Read Linux hardware counters (cycles, IPC, cache misses)\n"
+              << "  --json FILE         Write results as JSON ('-' for stdout)\n"
+              << "  --baseline FILE     Compare against a saved run; exit 2 on regressions\n"
+              << "  --tolerance F       Allowed relative regression (default 0.15)\n"
+              << "  --save-baseline F   Write this run's JSON as the new baseline\n";
+}
+
+int main(int argc, char** argv) {
+    int rays = 2000, repeat = 3;
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    bool perf = false;
+    double tolerance = 0.15;
+    std::string jsonPath, baselinePath, savePath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+        if (arg == "--perf") { perf = true; continue; }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+        const char* val = argv[++i];
+        if      (arg == "--rays")          rays = std::atoi(val);
+        else if (arg == "--threads")       maxThreads = static_cast<unsigned>(std::atoi(val));
+        else if (arg == "--repeat")        repeat = std::atoi(val);
+        else if (arg == "--json")          jsonPath = val;
+        else if (arg == "--baseline")      baselinePath = val;
+        else if (arg == "--tolerance")     tolerance = std::strtod(val, nullptr);
+        else if (arg == "--save-baseline") savePath = val;
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+    if (rays < 2 || repeat < 1 || maxThreads < 1) {
+        std::cerr << "--rays must be at least 2, --repeat and --threads at least 1\n";
+        return 1;
+    }
+
+    const double bc = 3.0 * std::sqrt(3.0) * Physics::M;
+    std::vector<Workload> workloads = {
+        equatorialSweep("captured", 0.05, bc - 0.3, rays),
+        nearCriticalSweep(rays),
+        diskSweep(rays),
+        equatorialSweep("escaping", bc + 1.0, 18.0, rays),
+    };
+
+    if (perf && !PerfCounters().available())
+        std::cerr << "Hardware counters unavailable (perf_event_paranoid / no PMU); reporting null\n";
+
+    std::map<std::string, double> metrics;
+    std::ostringstream json;
+    json.precision(6);
+    json << "{\n  \"suite\": \"physics\",\n  \"rays_per_workload\": " << rays
+         << ",\n  \"repeat\": " << repeat << ",\n";
+
+    // Micro
+    double accelNs = benchAcceleration(repeat);
+    double stepNs = benchStep(repeat);
+    metrics["accel_ns"] = accelNs;
+    metrics["rk4_step_ns"] = stepNs;
+    std::cout << "=== Physics kernel benchmarks ===\n\n"
+              << "  calculateAcceleration  " << accelNs << " ns/call\n"
+              << "  stepRK4                " << stepNs << " ns/step\n\n";
+    std::printf("  %-14s %10s %9s %8s %6s %6s %6s %6s %6s %s\n", "workload", "rays/s", "ns/step",
+                "mean", "min", "p50", "p90", "p99", "max", "(steps/ray)");
+
+    json << "  \"micro\": { \"accel_ns\": " << accelNs << ", \"rk4_step_ns\": " << stepNs << " },\n"
+         << "  \"workloads\": [\n";
+
+    // Macro
+    std::vector<Physics::Photon> mixed;
+    for (std::size_t wi = 0; wi < workloads.size(); wi++) {
+        const Workload& w = workloads[wi];
+        TraceResult r = benchTrace(w, repeat, perf);
+        mixed.insert(mixed.end(), w.rays.begin(), w.rays.end());
+
+        char nsPerStep[32] = "-";
+        if (r.totalSteps > 0) std::snprintf(nsPerStep, sizeof(nsPerStep), "%.2f", r.nsPerStep);
+        std::printf("  %-14s %10.0f %9s %8.1f %6ld %6ld %6ld %6ld %6ld\n", w.name.c_str(), r.raysPerSec,
+                    nsPerStep, r.meanSteps, r.minSteps, r.p50, r.p90, r.p99, r.maxSteps);
+        if (r.counters.valid) {
+            double n = static_cast<double>(w.rays.size());
+            std::printf("  %-14s %10.0f cycles/ray, IPC %.2f, %.1f cache misses/ray\n", "",
+                        r.counters.cycles / n, double(r.counters.instructions) / r.counters.cycles,
+                        r.counters.cacheMisses / n);
+        }
+
+        metrics[w.name + "_rays_per_s"] = r.raysPerSec;
+        if (r.totalSteps > 0) metrics[w.name + "_ns_per_step"] = r.nsPerStep;
+        metrics[w.name + "_steps_per_ray"] = r.meanSteps;
+        metrics[w.name + "_p99_steps"] = static_cast<double>(r.p99);
+        metrics[w.name + "_max_steps"] = static_cast<double>(r.maxSteps);
+
+        json << "    { \"name\": \"" << w.name << "\", \"rays\": " << w.rays.size()
+             << ", \"rays_per_s\": " << r.raysPerSec << ", \"ns_per_step\": "
+             << (r.totalSteps > 0 ? std::to_string(r.nsPerStep) : "null")
+             << ",\n      \"outcomes\": { \"captured\": " << r.captured << ", \"disk\": " << r.disk
+             << ", \"escaped\": " << r.escaped << " },\n"
+             << "      \"steps_per_ray\": { \"mean\": " << r.meanSteps << ", \"min\": " << r.minSteps
+             << ", \"p50\": " << r.p50 << ", \"p90\": " << r.p90 << ", \"p99\": " << r.p99
+             << ", \"max\": " << r.maxSteps << " },\n"
+             << "      \"counters\": " << counterJson(r.counters, static_cast<double>(w.rays.size())) << " }"
+             << (wi + 1 < workloads.size() ? ",\n" : "\n");
+    }
+    json << "  ],\n  \"threads\": [\n";
+
+    // Scaling: 1, 2, 4, ... and maxThreads itself
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+
+    std::cout << "\n  threads   rays/s     speedup\n";
+    double single = 0.0;
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        double rps = benchThreads(mixed, counts[i], repeat);
+        if (i == 0) single = rps;
+        std::printf("  %7u %10.0f %9.2fx\n", counts[i], rps, rps / single);
+        metrics["threads_" + std::to_string(counts[i]) + "_rays_per_s"] = rps;
+        json << "    { \"threads\": " << counts[i] << ", \"rays_per_s\": " << rps
+             << ", \"speedup\": " << rps / single << " }" << (i + 1 < counts.size() ? ",\n" : "\n");
+    }
+    json << "  ],\n  \"metrics\": {\n";
+    std::size_t mi = 0;
+    for (const auto& [name, value] : metrics)
+        json << "    \"" << name << "\": " << value << (++mi < metrics.size() ? ",\n" : "\n");
+    json << "  }\n}\n";
+
+    if (jsonPath == "-") std::cout << json.str();
+    for (const std::string& path : { jsonPath, savePath }) {
+        if (path.empty() || path == "-") continue;
+        std::ofstream out(path);
+        out << json.str();
+        if (!out.good()) {
+            std::cerr << "ERROR: Cannot write " << path << std::endl;
+            return 1;
+        }
+        std::cout << "\nWrote " << path << "\n";
+    }
+
+    if (!baselinePath.empty()) {
+        std::map<std::string, double> baseline;
+        if (!readMetrics(baselinePath, baseline)) return 1;
+        if (compareBaseline(metrics, baseline, tolerance) > 0) return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "render/wavefront_renderer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// ============================================================
+//  Lane utilization + rays/sec: wavefront vs pack-at-a-time
+//  Physics: one frame's camera rays through traceBatch (each
+//  pack runs until its slowest lane is done) and through the
+//  wavefront scheduler at several wave lengths, single thread,
+//  in raster order and shuffled (the incoherent order of the
+//  adaptive AA and progressive refinement queues).
+//  Frame: tile-at-a-time renderFrame vs renderFrameWavefront
+//  on the whole pool, shading included.
+// ============================================================
+
+template<typename F>
+static double seconds(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    Render::RenderSettings s;
+    s.width = argc > 1 ? std::atoi(argv[1]) : 160;
+    s.height = argc > 2 ? std::atoi(argv[2]) : 120;
+    Camera cam(15.0f, 0.3f, 0.15f);
+
+    Physics::PhotonBatch batch;
+    for (int y = 0; y < s.height; y++)
+        for (int x = 0; x < s.width; x++)
+            batch.push({ cam.position, Render::primaryRayDir(cam, x + 0.5, y + 0.5, s.width, s.height) });
+    const double rays = static_cast<double>(batch.size());
+
+    std::cout << "=== Wavefront scheduler: " << s.width << "x" << s.height << " rays, " << simd::ISA << " ("
+              << simd::dpack::N << " lanes) ===\n";
+    std::vector<std::size_t> order(batch.size());
+    for (std::size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(7));
+    Physics::PhotonBatch shuffled;
+    for (std::size_t i : order) shuffled.push(batch.photon(i));
+
+    for (const Physics::PhotonBatch* b : { &batch, &shuffled }) {
+        std::printf("  %-26s %12s %12s %8s\n", b == &batch ? "raster order (1 thread)" : "shuffled (1 thread)",
+                    "rays/s", "utilization", "waves");
+
+        // Pack-at-a-time: traceBatch for speed, the equivalent wavefront
+        // configuration (one pack, no wave limit) for its utilization
+        double batchSec = seconds([&] { Physics::traceBatch(*b); });
+        Physics::WavefrontSettings packs;
+        packs.stepsPerWave = 0;
+        packs.slots = simd::dpack::N;
+        Physics::WavefrontStats packStats;
+        Physics::traceWavefront(*b, packs, &packStats);
+        std::printf("  %-26s %12.0f %11.1f%% %8s\n", "traceBatch (per pack)", rays / batchSec,
+                    100.0 * packStats.utilization(), "-");
+
+        for (int k : { 4, 16, 64 }) {
+            Physics::WavefrontSettings ws;
+            ws.stepsPerWave = k;
+            Physics::WavefrontStats st;
+            double sec = seconds([&] { Physics::traceWavefront(*b, ws, &st); });
+            char name[48];
+            std::snprintf(name, sizeof(name), "wavefront K=%d, %d slots", k, ws.slots);
+            std::printf("  %-26s %12.0f %11.1f%% %8ld\n", name, rays / sec, 100.0 * st.utilization(), st.waves);
+        }
+        std::printf("\n");
+    }
+
+    ThreadPool pool(std::thread::hardware_concurrency());
+    std::printf("  %-26s %12s %12s\n", "frame (all threads)", "rays/s", "utilization");
+    for (Render::Precision precision : { Render::Precision::Double, Render::Precision::Float }) {
+        s.precision = precision;
+        const char* p = precision == Render::Precision::Double ? "double" : "float";
+        double tileSec = seconds([&] { Render::renderFrame(cam, s, pool); });
+        Physics::WavefrontStats st;
+        double waveSec = seconds([&] { Render::renderFrameWavefront(cam, s, pool, {}, &st); });
+        char name[48];
+        std::snprintf(name, sizeof(name), "renderFrame tiles, %s", p);
+        std::printf("  %-26s %12.0f %12s\n", name, rays / tileSec, "scalar");
+        std::snprintf(name, sizeof(name), "wavefront, %s", p);
+        std::printf("  %-26s %12.0f %11.1f%%\n", name, rays / waveSec, 100.0 * st.utilization());
+    }
+    std::cout << "  (" << pool.size() << " threads)\n";
+    return 0;
+}
@@ -0,0 +1,28 @@
+# Writes every shader in SHADER_DIR into OUTPUT as raw string literals:
+#   cmake -DSHADER_DIR=src/shaders -DOUTPUT=embedded_shaders.hpp -P embed_shaders.cmake
+# Used by the build (see blackhole_embed_shaders in the top-level CMakeLists.txt),
+# which reruns it whenever a shader changes.
+
+file(GLOB shaders RELATIVE ${SHADER_DIR} ${SHADER_DIR}/*.vert ${SHADER_DIR}/*.frag ${SHADER_DIR}/*.glsl)
+list(SORT shaders)
+
+set(text "#pragma once\n\n// Generated from src/shaders by cmake/embed_shaders.cmake. Do not edit.\n\n")
+string(APPEND text "struct EmbeddedShader {\n    const char* name;\n    const char* source;\n};\n\n")
+string(APPEND text "inline constexpr EmbeddedShader EMBEDDED_SHADERS[] = {\n")
+foreach(shader ${shaders})
+    file(READ ${SHADER_DIR}/${shader} source)
+    string(FIND "${source}" ")glsl\"" clash)
+    if(NOT clash EQUAL -1)
+        message(FATAL_ERROR "${shader} contains the raw-string delimiter )glsl\"")
+    endif()
+    string(APPEND text "    { \"${shader}\", R\"glsl(${source})glsl\" },\n")
+endforeach()
+string(APPEND text "};\n")
+
+# Only touch the header when it changes, so unrelated rebuilds stay incremental
+if(EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} previous)
+endif()
+if(NOT "${previous}" STREQUAL "${text}")
+    file(WRITE ${OUTPUT} "${text}")
+endif()
@@ -2,6 +2,7 @@
 
 #include "../math/Vec3.hpp"
 #include <cmath>
+#include <cstdint>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -31,6 +32,10 @@ public:
     // FOV
     float fov_scale;
 
+    // Bumped by update() whenever position, basis or FOV actually change;
+    // lets renderers keep per-pixel geodesics while the view is static
+    std::uint64_t revision;
+
     // Input sensitivity
     float mouse_sensitivity;
     float scroll_sensitivity;
@@ -43,11 +48,13 @@ public:
     Camera(float init_radius = 15.0f, float init_yaw = 0.0f, float init_pitch = 0.3f)
         : yaw(init_yaw), pitch(init_pitch), radius(init_radius),
           center(0.0, 0.0, 0.0),
+          revision(0),
           mouse_sensitivity(0.005f),
           scroll_sensitivity(1.2f),
           move_speed(0.3f),
           dragging(false),
-          lastMouseX(0.0), lastMouseY(0.0)
+          lastMouseX(0.0), lastMouseY(0.0),
+          last_fov_scale(0.0f)
     {
         // 90° FOV
         double fov_radians = 90.0 * M_PI / 180.0;
@@ -57,6 +64,8 @@ public:
 
     // Recompute position & basis vectors from spherical coordinates
     void update() {
+        const vec3 oldPosition = position, oldForward = forward, oldRight = right, oldUp = up;
+
         // Clamp pitch to avoid gimbal lock at poles
         float maxPitch = static_cast<float>(89.0 * M_PI / 180.0);
         if (pitch > maxPitch)  pitch = maxPitch;
@@ -83,6 +92,12 @@ public:
         vec3 world_up(0.0, 1.0, 0.0);
         right = forward.cross(world_up).normalize();
         up = right.cross(forward).normalize();
+
+        if (!sameVec(position, oldPosition) || !sameVec(forward, oldForward) ||
+            !sameVec(right, oldRight) || !sameVec(up, oldUp) || fov_scale != last_fov_scale) {
+            last_fov_scale = fov_scale;
+            revision++;
+        }
     }
 
     // Called on mouse button press/release
@@ -123,4 +138,11 @@ public:
         if (e) center = center + vec3(0.0, 1.0, 0.0) * move_speed;
         if (q) center = center - vec3(0.0, 1.0, 0.0) * move_speed;
     }
+
+private:
+    float last_fov_scale;   // FOV at the last revision bump
+
+    static bool sameVec(const vec3& a, const vec3& b) {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
 };
\ No newline at end of file
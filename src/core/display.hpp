@@ -1,23 +1,98 @@
 #pragma once
 
+// BLACKHOLE_GLFW: windowed Display (needs GLFW)
+// BLACKHOLE_EGL:  offscreen Display on an EGL pbuffer (servers, Mesa llvmpipe)
+#ifndef BLACKHOLE_GLFW
+#define BLACKHOLE_GLFW 1
+#endif
+#ifndef BLACKHOLE_EGL
+#define BLACKHOLE_EGL 0
+#endif
+
 #include <glad/glad.h>
+#if BLACKHOLE_GLFW
 #include <GLFW/glfw3.h>
+#endif
+#if BLACKHOLE_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+#include "frame_timing.hpp"
+#include "gpu_timer.hpp"
+#include "program_cache.hpp"
+#include "quality.hpp"
+#include "readback.hpp"
+#include "resolution.hpp"
+#include "shader_library.hpp"
+#include "../render/disk_emission.hpp"
+#include "../render/starfield.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <string>
 #include <iostream>
-#include <fstream>
-#include <sstream>
+#include <vector>
+
+// Bloom blur: dual-filter mip chain (default) or the original full-resolution Gaussian
+enum class BloomMode { DualFilter, Gaussian };
 
 class Display {
 
 private:
     int window_width, window_height;
-    GLFWwindow* window;
+    bool ready;                      // GL context current and resources created
+#if BLACKHOLE_GLFW
+    GLFWwindow* window = nullptr;
+#endif
+#if BLACKHOLE_EGL
+    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+    EGLContext eglContext = EGL_NO_CONTEXT;
+    EGLSurface eglSurface = EGL_NO_SURFACE;
+#endif
+
+    // --- Offscreen mode: composite into an RGBA8 FBO, read back through a PBO ring ---
+    bool offscreen;
+    GLuint outputFBO = 0, outputTexture = 0;
+    FrameReadback readback;
+    std::uint64_t frameIndex;
 
     // --- Shaders ---
-    GLuint sceneProgram;     // blackhole.vert + blackhole.frag
+    GLuint sceneProgram;     // blackhole.vert + blackhole.frag       (active quality variant)
     GLuint blurProgram;      // blackhole.vert + bloom_blur.frag
+    GLuint downProgram;      // blackhole.vert + bloom_down.frag
+    GLuint upProgram;        // blackhole.vert + bloom_up.frag
     GLuint compositeProgram; // blackhole.vert + bloom_final.frag
+    GLuint gbufferTraceProgram; // blackhole.vert + gbuffer_trace.frag (active quality variant)
+    GLuint gbufferShadeProgram; // blackhole.vert + gbuffer_shade.frag (active quality variant)
+    ProgramCache programCache{ programCacheDir() };
+    std::string shaderDir;
+
+    // --- Quality variants: the three ray passes compiled per QualitySettings ---
+    struct SceneVariant {
+        QualitySettings quality;
+        GLuint scene, trace, shade;
+        bool linking;                       // Parallel compile still running on driver threads
+        bool failed;
+        std::vector<std::string> sources;   // vert + 3 frags, kept while linking (for the cache)
+    };
+    std::vector<SceneVariant> variants;     // Built so far; kept, so switching back is free
+    int activeVariant;
+    int wantedVariant;                      // Switched to once it has linked
+    bool parallelCompile;                   // KHR/ARB_parallel_shader_compile
+
+    // Last value of each scene uniform, replayed into a variant when it becomes active
+    struct SceneUniform {
+        std::string name;
+        int count;
+        float v[3];
+    };
+    std::vector<SceneUniform> sceneUniforms;
+
+    static std::string& programCacheDir() {
+        static std::string dir = ProgramCache::defaultDir();
+        return dir;
+    }
 
     // --- Full-screen quad ---
     GLuint quadVAO, quadVBO;
@@ -27,17 +102,81 @@ private:
     GLuint pingFBO, pingTexture;         // Blur ping
     GLuint pongFBO, pongTexture;         // Blur pong
 
+    // --- Dual-filter mip chain: level i is (w >> (i + 1)) × (h >> (i + 1)) ---
+    struct BloomLevel {
+        GLuint fbo, tex;
+        int w, h;
+    };
+    std::vector<BloomLevel> bloomChain;
+
+    // --- Geodesic G-buffer (termination + up to 4 disk crossings, RGBA32F MRT) ---
+    static constexpr int GBUFFER_TARGETS = 5;
+    GLuint gbufferFBO;
+    GLuint gbufferTextures[GBUFFER_TARGETS];
+    bool geodesicCache;              // Reshade from the G-buffer while the camera is static
+    bool gbufferValid;               // Cleared by camera/FOV changes and resizes
+    std::uint64_t cameraRevision;    // Last Camera::revision seen
+    std::uint64_t geodesicTraces;    // Full trace passes so far (for stats)
+
+    // --- Baked sky: Render::bakeStarfield cubemap, sampled by escaped rays ---
+    static constexpr int STARFIELD_UNIT = GBUFFER_TARGETS;   // Texture unit after the G-buffer's
+    GLuint starfieldTexture = 0;
+    double starfieldBakeMs = 0.0;
+
+    static int& starfieldSize() {
+        static int size = 1024;
+        return size;
+    }
+
+    // --- Baked disk: Render::bakeDiskEmission (φ, r) map, sampled at each crossing ---
+    static constexpr int DISK_EMISSION_UNIT = GBUFFER_TARGETS + 1;
+    static constexpr float DISK_EMISSION_R0 = 3.0f;    // shading.glsl's DISK_INNER ...
+    static constexpr float DISK_EMISSION_R1 = 15.0f;   // ... and DISK_OUTER
+    GLuint diskEmissionTexture = 0;
+    double diskEmissionBakeMs = 0.0;
+
+    struct DiskEmissionSize {
+        int angular = 2048, radial = 512;
+    };
+    static DiskEmissionSize& diskEmissionSize() {
+        static DiskEmissionSize size;
+        return size;
+    }
+
     // --- Bloom parameters ---
-    int bloomIterations;
+    BloomMode bloomMode;
+    int bloomIterations;     // Gaussian: H + V passes
+    int bloomLevels;         // Dual filter: mip levels below full resolution
+    float bloomRadius;       // Dual filter: tap offset in source texels
     float bloomStrength;
     float exposure;
 
+    // --- Dynamic resolution: the scene pass renders at scene_width × scene_height ---
+    int scene_width, scene_height;
+    float renderScale;
+    bool dynamicResolution;
+    ResolutionController resolution;
+    double lastSceneMs;
+
+    // --- Frame timing: GPU pass timestamps + CPU frame pacing ---
+    using Clock = std::chrono::steady_clock;
+    GpuPassTimer gpuTimer;
+    FrameTelemetry telemetry;
+    bool gpuTiming;
+    bool timingOverlay;
+    std::int64_t inputGpuNs;           // GPU clock at the last markInput(), 0 if none this frame
+    Clock::time_point epoch, lastFrameEnd;
+    bool haveFrameEnd;
+
     // --- Shader utilities ---
-    GLuint compileShader(GLenum type, const std::string& source) {
+    // check = false leaves the compile running (parallel compile); errors then
+    // surface in the program's link log
+    GLuint compileShader(GLenum type, const std::string& source, bool check = true) {
         GLuint shader = glCreateShader(type);
         const char* src = source.c_str();
         glShaderSource(shader, 1, &src, nullptr);
         glCompileShader(shader);
+        if (!check) return shader;
 
         int success;
         glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
@@ -52,23 +191,17 @@ private:
         return shader;
     }
 
-    std::string loadShaderFile(const std::string& filepath) {
-        std::ifstream file(filepath);
-        if (!file.is_open()) {
-            std::cerr << "ERROR: Cannot open shader file: " << filepath << std::endl;
-            return "";
-        }
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
-    }
-
-    GLuint linkProgram(GLuint vert, GLuint frag) {
+    GLuint linkProgram(GLuint vert, GLuint frag, bool retrievable = false, bool check = true) {
         GLuint prog = glCreateProgram();
         glAttachShader(prog, vert);
         glAttachShader(prog, frag);
+        if (retrievable) glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
         glLinkProgram(prog);
+        if (check) linked(prog);
+        return prog;
+    }
 
+    bool linked(GLuint prog) {
         int success;
         glGetProgramiv(prog, GL_LINK_STATUS, &success);
         if (!success) {
@@ -76,16 +209,140 @@ private:
             glGetProgramInfoLog(prog, 1024, nullptr, infoLog);
             std::cerr << "SHADER LINK ERROR:\n" << infoLog << std::endl;
         }
-        return prog;
+        return success != 0;
     }
 
-    void createFBO(GLuint& fbo, GLuint& tex, int w, int h) {
+    // Programs for `q`, from the program cache (files named <pass>-<q.tag()>) or
+    // compiled. With `background` and parallel compile the links are left running
+    // and the variant stays `linking` until pollVariants() sees them finish.
+    int buildVariant(const QualitySettings& q, bool background) {
+        ShaderLibrary shaders(shaderDir);
+        const std::string vertSrc = shaders.load("blackhole.vert");
+        const std::string defines = q.defines(), tag = q.tag();
+        SceneVariant v{ q, 0, 0, 0, false, false, {} };
+        struct Pass { const char* name; const char* file; GLuint* prog; };
+        const Pass passes[] = {
+            { "scene", "blackhole.frag", &v.scene },
+            { "gbuffer_trace", "gbuffer_trace.frag", &v.trace },
+            { "gbuffer_shade", "gbuffer_shade.frag", &v.shade },
+        };
+        background = background && parallelCompile;
+        if (background) v.sources.push_back(vertSrc);
+        for (const Pass& pass : passes) {
+            const std::string fragSrc = ShaderLibrary::withDefines(shaders.load(pass.file), defines);
+            const std::string cacheName = std::string(pass.name) + "-" + tag;
+            auto build = [&](bool retrievable) {
+                GLuint vert = compileShader(GL_VERTEX_SHADER, vertSrc, !background);
+                GLuint frag = compileShader(GL_FRAGMENT_SHADER, fragSrc, !background);
+                GLuint prog = linkProgram(vert, frag, retrievable, !background);
+                glDeleteShader(vert);   // Flagged; freed with the program
+                glDeleteShader(frag);
+                return prog;
+            };
+            if (background) {
+                v.sources.push_back(fragSrc);
+                *pass.prog = programCache.find(cacheName, vertSrc, fragSrc);
+                if (!*pass.prog) {
+                    *pass.prog = build(programCache.enabled());
+                    v.linking = true;
+                }
+            } else {
+                *pass.prog = programCache.get(cacheName, vertSrc, fragSrc, build);
+                GLint ok = 0;
+                glGetProgramiv(*pass.prog, GL_LINK_STATUS, &ok);   // Log already printed by linkProgram
+                v.failed = v.failed || !ok;
+            }
+        }
+        if (!v.linking) v.sources.clear();
+        variants.push_back(std::move(v));
+        return static_cast<int>(variants.size()) - 1;
+    }
+
+    int findVariant(const QualitySettings& q) const {
+        for (std::size_t i = 0; i < variants.size(); i++)
+            if (variants[i].quality == q) return static_cast<int>(i);
+        return -1;
+    }
+
+    // Never blocks: finished background links are checked and cached, and the
+    // wanted variant takes over once it is ready
+    void pollVariants() {
+        if (variants.empty()) return;
+        for (SceneVariant& v : variants) {
+            if (!v.linking) continue;
+            GLint done = 1;
+            for (GLuint prog : { v.scene, v.trace, v.shade }) {
+                GLint complete = 1;
+                glGetProgramiv(prog, GL_COMPLETION_STATUS_KHR, &complete);
+                done = done && complete;
+            }
+            if (!done) continue;
+            v.linking = false;
+            const std::string tag = v.quality.tag();
+            const char* names[] = { "scene", "gbuffer_trace", "gbuffer_shade" };
+            const GLuint progs[] = { v.scene, v.trace, v.shade };
+            for (int i = 0; i < 3; i++) {
+                if (linked(progs[i])) programCache.store(std::string(names[i]) + "-" + tag, v.sources[0], v.sources[i + 1], progs[i]);
+                else v.failed = true;
+            }
+            v.sources.clear();
+        }
+        if (wantedVariant != activeVariant && !variants[wantedVariant].linking) {
+            if (variants[wantedVariant].failed) {
+                std::cerr << "Quality \"" << variants[wantedVariant].quality.tag()
+                          << "\" failed to build, keeping \"" << variants[activeVariant].quality.tag() << "\"" << std::endl;
+                wantedVariant = activeVariant;
+            } else {
+                activateVariant(wantedVariant);
+            }
+        }
+    }
+
+    void activateVariant(int index) {
+        activeVariant = wantedVariant = index;
+        sceneProgram = variants[index].scene;
+        gbufferTraceProgram = variants[index].trace;
+        gbufferShadeProgram = variants[index].shade;
+        forEachSceneProgram([&](GLuint prog) {
+            glUniform1i(glGetUniformLocation(prog, "uStarfield"), STARFIELD_UNIT);
+            glUniform1i(glGetUniformLocation(prog, "uDiskEmission"), DISK_EMISSION_UNIT);
+            glUniform2f(glGetUniformLocation(prog, "uDiskEmissionRange"), DISK_EMISSION_R0, DISK_EMISSION_R1);
+        });
+        for (const SceneUniform& u : sceneUniforms) applySceneUniform(u);
+        gbufferValid = false;   // Trace limits differ per variant
+    }
+
+    void applySceneUniform(const SceneUniform& u) {
+        forEachSceneProgram([&](GLuint prog) {
+            GLint loc = glGetUniformLocation(prog, u.name.c_str());
+            if (u.count == 1) glUniform1f(loc, u.v[0]);
+            else if (u.count == 2) glUniform2f(loc, u.v[0], u.v[1]);
+            else glUniform3f(loc, u.v[0], u.v[1], u.v[2]);
+        });
+    }
+
+    void setSceneUniform(const char* name, int count, float x, float y, float z) {
+        SceneUniform* u = nullptr;
+        for (SceneUniform& s : sceneUniforms)
+            if (s.name == name) u = &s;
+        if (!u) {
+            sceneUniforms.push_back({ name, count, { 0.0f, 0.0f, 0.0f } });
+            u = &sceneUniforms.back();
+        }
+        u->count = count;
+        u->v[0] = x;
+        u->v[1] = y;
+        u->v[2] = z;
+        applySceneUniform(*u);
+    }
+
+    void createFBO(GLuint& fbo, GLuint& tex, int w, int h, GLenum format = GL_RGBA16F) {
         glGenFramebuffers(1, &fbo);
         glGenTextures(1, &tex);
 
         glBindTexture(GL_TEXTURE_2D, tex);
         // Use RGBA16F for HDR storage
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, w, h, 0, GL_RGBA, GL_FLOAT, nullptr);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, w, h, 0, GL_RGBA, GL_FLOAT, nullptr);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -100,7 +357,60 @@ private:
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
-    void resizeFBOs(int w, int h) {
+    // (Re)build the dual-filter chain for a w × h frame
+    void createBloomChain(int w, int h) {
+        deleteBloomChain();
+        for (int i = 0; i < bloomLevels; i++) {
+            w = w > 1 ? w / 2 : 1;
+            h = h > 1 ? h / 2 : 1;
+            BloomLevel level{ 0, 0, w, h };
+            createFBO(level.fbo, level.tex, w, h);
+            bloomChain.push_back(level);
+        }
+    }
+
+    void deleteBloomChain() {
+        for (BloomLevel& level : bloomChain) {
+            glDeleteFramebuffers(1, &level.fbo);
+            glDeleteTextures(1, &level.tex);
+        }
+        bloomChain.clear();
+    }
+
+    // Full-precision MRT targets: hit positions must survive the round trip
+    void createGBuffer(int w, int h) {
+        glGenFramebuffers(1, &gbufferFBO);
+        glGenTextures(GBUFFER_TARGETS, gbufferTextures);
+        glBindFramebuffer(GL_FRAMEBUFFER, gbufferFBO);
+
+        GLenum drawBuffers[GBUFFER_TARGETS];
+        for (int i = 0; i < GBUFFER_TARGETS; i++) {
+            glBindTexture(GL_TEXTURE_2D, gbufferTextures[i]);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, w, h, 0, GL_RGBA, GL_FLOAT, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, gbufferTextures[i], 0);
+            drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+        }
+        glDrawBuffers(GBUFFER_TARGETS, drawBuffers);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "ERROR: G-buffer framebuffer not complete!" << std::endl;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    // Scene, G-buffer and bloom targets follow the render scale; only the
+    // composite output stays at window size
+    void resizeSceneTargets() {
+        int w = std::max(1, static_cast<int>(std::lround(window_width * renderScale)));
+        int h = std::max(1, static_cast<int>(std::lround(window_height * renderScale)));
+        if (w == scene_width && h == scene_height) return;
+        scene_width = w;
+        scene_height = h;
+
         auto resizeTex = [](GLuint tex, int w, int h) {
             glBindTexture(GL_TEXTURE_2D, tex);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, w, h, 0, GL_RGBA, GL_FLOAT, nullptr);
@@ -108,50 +418,143 @@ private:
         resizeTex(sceneTexture, w, h);
         resizeTex(pingTexture, w, h);
         resizeTex(pongTexture, w, h);
+        createBloomChain(w, h);
+
+        for (int i = 0; i < GBUFFER_TARGETS; i++) {
+            glBindTexture(GL_TEXTURE_2D, gbufferTextures[i]);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, w, h, 0, GL_RGBA, GL_FLOAT, nullptr);
+        }
+        gbufferValid = false;
     }
 
-public:
-    Display(int width, int height, const std::string& title,
-            const std::string& shaderDir)
-        : window_width(width), window_height(height),
-          bloomIterations(8), bloomStrength(0.15f), exposure(1.2f)
-    {
-        // --- GLFW Init ---
-        if (!glfwInit()) {
-            std::cerr << "Failed to initialize GLFW" << std::endl;
-            return;
+    void resizeFBOs(int w, int h) {
+        resizeSceneTargets();
+        if (offscreen) {
+            glBindTexture(GL_TEXTURE_2D, outputTexture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
         }
+    }
 
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    // Move finished GPU timings into the telemetry; the scene pass also
+    // drives the resolution controller (never waits on the GPU)
+    void collectTimings() {
+        gpuTimer.collect(
+            [&](const std::string& pass, double ms) {
+                telemetry.record(pass, ms);
+                if (pass != "scene") return;
+                lastSceneMs = ms;
+                if (dynamicResolution && resolution.update(ms)) {
+                    renderScale = resolution.scale();
+                    resizeSceneTargets();
+                }
+            },
+            [&](double totalMs, std::int64_t endNs, std::int64_t inputNs) {
+                telemetry.record("gpu_frame", totalMs);
+                if (inputNs) telemetry.record("input_latency", (endNs - inputNs) * 1e-6);
+            });
+    }
 
-        window = glfwCreateWindow(width, height, title.c_str(), NULL, NULL);
-        if (!window) {
-            std::cerr << "Failed to create GLFW window" << std::endl;
-            glfwTerminate();
-            return;
+    // cpu_frame is the interval between draw() returns; also drives the periodic dump
+    void endFrameTiming() {
+        Clock::time_point now = Clock::now();
+        if (haveFrameEnd)
+            telemetry.record("cpu_frame", std::chrono::duration<double, std::milli>(now - lastFrameEnd).count());
+        lastFrameEnd = now;
+        haveFrameEnd = true;
+        telemetry.tick(std::chrono::duration<double>(now - epoch).count());
+    }
+
+    // Frame-time graph in the bottom-left corner: one bar per recent frame
+    // (2 ms per pixel row), green within 60 Hz, yellow within 30 Hz, red beyond,
+    // and a white line at 16.7 ms. Scissored clears, so no extra shader.
+    void drawTimingOverlay() {
+        const RollingHistogram* frames = telemetry.find("cpu_frame");
+        if (!frames) return;
+        const int bars = std::min<int>(static_cast<int>(frames->count()), 120);
+        const float pxPerMs = 2.0f;
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(8, 8, bars * 2, static_cast<int>(50 * pxPerMs));
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        for (int i = 0; i < bars; i++) {
+            double ms = frames->at(frames->count() - bars + i);
+            int h = std::max(1, std::min(static_cast<int>(ms * pxPerMs), static_cast<int>(50 * pxPerMs)));
+            if (ms <= 1000.0 / 60.0) glClearColor(0.2f, 0.9f, 0.3f, 1.0f);
+            else if (ms <= 1000.0 / 30.0) glClearColor(1.0f, 0.8f, 0.1f, 1.0f);
+            else glClearColor(1.0f, 0.2f, 0.2f, 1.0f);
+            glScissor(8 + i * 2, 8, 2, h);
+            glClear(GL_COLOR_BUFFER_BIT);
         }
+        glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+        glScissor(8, 8 + static_cast<int>(1000.0f / 60.0f * pxPerMs), bars * 2, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glDisable(GL_SCISSOR_TEST);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    }
 
-        glfwMakeContextCurrent(window);
-        glfwSwapInterval(1);
+    // Scene-space uniforms (camera, time, step) feed all three ray passes
+    template<typename F>
+    void forEachSceneProgram(F setter) {
+        GLint current = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+        for (GLuint prog : { sceneProgram, gbufferTraceProgram, gbufferShadeProgram }) {
+            glUseProgram(prog);
+            setter(prog);
+        }
+        glUseProgram(static_cast<GLuint>(current));
+    }
 
-        glfwSetWindowUserPointer(window, this);
-        glfwSetFramebufferSizeCallback(window, [](GLFWwindow* w, int newW, int newH) {
-            Display* self = static_cast<Display*>(glfwGetWindowUserPointer(w));
-            if (self) {
-                self->window_width = newW;
-                self->window_height = newH;
-                self->resizeFBOs(newW, newH);
-            }
-            glViewport(0, 0, newW, newH);
-        });
+    // Bake the procedural sky on every core and upload it as an R11G11B10F cube
+    // map; glGenerateMipmap builds the chain that filters stars under a pixel
+    void createStarfield(ThreadPool& pool) {
+        auto t0 = std::chrono::steady_clock::now();
+        const int size = std::max(1, starfieldSize());
+        Render::StarfieldCubemap sky = Render::bakeStarfield(size, pool);
 
-        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-            std::cerr << "Failed to initialize GLAD" << std::endl;
-            return;
-        }
+        glGenTextures(1, &starfieldTexture);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, starfieldTexture);
+        for (int f = 0; f < 6; f++)
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + f, 0, GL_R11F_G11F_B10F, size, size, 0, GL_RGB, GL_FLOAT,
+                         sky.faces[f].data());
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+        glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);   // Mips filter across face edges
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+        starfieldBakeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "Starfield: 6x" << size << "x" << size << " cube map baked in " << starfieldBakeMs << " ms ("
+                  << pool.size() << " threads)\n";
+    }
+
+    // Bake the disk's particles and glow over (φ, r), 2×2 samples per texel,
+    // as RGB16F: φ repeats, r clamps; mips filter distant crossings
+    void createDiskEmission(ThreadPool& pool) {
+        auto t0 = std::chrono::steady_clock::now();
+        const DiskEmissionSize size = diskEmissionSize();
+        Render::DiskEmissionMap map = Render::bakeDiskEmission(std::max(1, size.angular), std::max(1, size.radial),
+                                                               DISK_EMISSION_R0, DISK_EMISSION_R1, pool, 2);
 
+        glGenTextures(1, &diskEmissionTexture);
+        glBindTexture(GL_TEXTURE_2D, diskEmissionTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, map.angular, map.radial, 0, GL_RGB, GL_FLOAT, map.texels.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        diskEmissionBakeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "Disk emission: " << map.angular << "x" << map.radial << " (phi x r) baked in "
+                  << diskEmissionBakeMs << " ms (" << pool.size() << " threads)\n";
+    }
+
+    // Context is current and GLAD loaded: create the quad, FBOs and programs
+    void initGL(int width, int height, const std::string& shaderDir) {
         std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
         std::cout << "GPU: " << glGetString(GL_RENDERER) << std::endl;
 
@@ -180,93 +583,413 @@ public:
         createFBO(sceneFBO, sceneTexture, width, height);
         createFBO(pingFBO, pingTexture, width, height);
         createFBO(pongFBO, pongTexture, width, height);
+        createBloomChain(width, height);
+        createGBuffer(width, height);
+        {
+            ThreadPool pool;
+            createStarfield(pool);
+            createDiskEmission(pool);
+        }
+
+        // --- Build all shader programs (from the program cache when it has them) ---
+        auto t0 = std::chrono::steady_clock::now();
+        this->shaderDir = shaderDir;
+        parallelCompile = GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile;
+        ShaderLibrary shaders(shaderDir);
+        std::string vertSrc = shaders.load("blackhole.vert");
+        auto program = [&](const char* name, const char* fragFile) {
+            std::string fragSrc = shaders.load(fragFile);
+            return programCache.get(name, vertSrc, fragSrc, [&](bool retrievable) {
+                GLuint vert = compileShader(GL_VERTEX_SHADER, vertSrc);
+                GLuint frag = compileShader(GL_FRAGMENT_SHADER, fragSrc);
+                GLuint prog = linkProgram(vert, frag, retrievable);
+                glDeleteShader(vert);
+                glDeleteShader(frag);
+                return prog;
+            });
+        };
+        blurProgram = program("bloom_blur", "bloom_blur.frag");
+        downProgram = program("bloom_down", "bloom_down.frag");
+        upProgram = program("bloom_up", "bloom_up.frag");
+        compositeProgram = program("composite", "bloom_final.frag");
+        activateVariant(buildVariant(QualitySettings::high(), false));
+
+        const ProgramCache::Stats& cs = programCache.getStats();
+        std::cout << "Shaders: " << (shaders.isEmbedded() ? "embedded" : shaderDir) << ", 7 programs in "
+                  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count()
+                  << " ms (";
+        if (programCache.enabled()) std::cout << cs.hits << " from " << programCache.getDir() << ", " << 7 - cs.hits << " compiled)\n";
+        else std::cout << "compiled, no program cache)\n";
+
+        if (offscreen) createFBO(outputFBO, outputTexture, width, height, GL_RGBA8);
+        glViewport(0, 0, width, height);
+        ready = true;
+    }
+
+#if BLACKHOLE_EGL
+    // Mesa's surfaceless platform needs no X/Wayland; other drivers get the default display
+    bool initEGL() {
+        auto getPlatformDisplay =
+            reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay)
+            eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (eglDisplay == EGL_NO_DISPLAY) eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, nullptr, nullptr)) {
+            std::cerr << "Failed to initialize EGL" << std::endl;
+            return false;
+        }
+
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_NONE
+        };
+        EGLConfig config;
+        EGLint configs = 0;
+        if (!eglChooseConfig(eglDisplay, configAttribs, &config, 1, &configs) || configs == 0 ||
+            !eglBindAPI(EGL_OPENGL_API)) {
+            std::cerr << "No EGL config with desktop OpenGL + pbuffer support" << std::endl;
+            return false;
+        }
+
+        // Every pass renders into FBOs, so the pbuffer only has to make the context current
+        const EGLint surfaceAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        const EGLint contextAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE
+        };
+        eglSurface = eglCreatePbufferSurface(eglDisplay, config, surfaceAttribs);
+        eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttribs);
+        if (eglSurface == EGL_NO_SURFACE || eglContext == EGL_NO_CONTEXT ||
+            !eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext)) {
+            std::cerr << "Failed to create an OpenGL 3.3 core EGL context" << std::endl;
+            return false;
+        }
+
+        if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+            std::cerr << "Failed to initialize GLAD" << std::endl;
+            return false;
+        }
+        return true;
+    }
+#endif
+
+public:
+    // Both constructors read shaders from `shaderDir`, or use the copies embedded
+    // at build time when it is "" (see ShaderLibrary)
+
+    // Windowed: GLFW window, composite to the screen
+    Display(int width, int height, const std::string& title,
+            const std::string& shaderDir)
+        : window_width(width), window_height(height), ready(false), offscreen(false), frameIndex(0),
+          activeVariant(0), wantedVariant(0), parallelCompile(false),
+          geodesicCache(true), gbufferValid(false), cameraRevision(0), geodesicTraces(0),
+          bloomMode(BloomMode::DualFilter), bloomIterations(8), bloomLevels(5), bloomRadius(1.0f),
+          bloomStrength(0.15f), exposure(1.2f),
+          scene_width(width), scene_height(height), renderScale(1.0f), dynamicResolution(false),
+          lastSceneMs(0.0), gpuTiming(true), timingOverlay(false), inputGpuNs(0),
+          epoch(Clock::now()), haveFrameEnd(false)
+    {
+#if BLACKHOLE_GLFW
+        // --- GLFW Init ---
+        if (!glfwInit()) {
+            std::cerr << "Failed to initialize GLFW" << std::endl;
+            return;
+        }
+
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+        window = glfwCreateWindow(width, height, title.c_str(), NULL, NULL);
+        if (!window) {
+            std::cerr << "Failed to create GLFW window" << std::endl;
+            glfwTerminate();
+            return;
+        }
 
-        // --- Compile all shader programs ---
-        std::string vertSrc = loadShaderFile(shaderDir + "/blackhole.vert");
-        std::string fragScene = loadShaderFile(shaderDir + "/blackhole.frag");
-        std::string fragBlur = loadShaderFile(shaderDir + "/bloom_blur.frag");
-        std::string fragComp = loadShaderFile(shaderDir + "/bloom_final.frag");
+        glfwMakeContextCurrent(window);
+        glfwSwapInterval(1);
 
-        GLuint vert = compileShader(GL_VERTEX_SHADER, vertSrc);
-        GLuint fScene = compileShader(GL_FRAGMENT_SHADER, fragScene);
-        GLuint fBlur = compileShader(GL_FRAGMENT_SHADER, fragBlur);
-        GLuint fComp = compileShader(GL_FRAGMENT_SHADER, fragComp);
+        glfwSetWindowUserPointer(window, this);
+        glfwSetFramebufferSizeCallback(window, [](GLFWwindow* w, int newW, int newH) {
+            Display* self = static_cast<Display*>(glfwGetWindowUserPointer(w));
+            if (self) self->resize(newW, newH);
+        });
 
-        sceneProgram = linkProgram(vert, fScene);
-        blurProgram = linkProgram(vert, fBlur);
-        compositeProgram = linkProgram(vert, fComp);
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+            std::cerr << "Failed to initialize GLAD" << std::endl;
+            return;
+        }
+        initGL(width, height, shaderDir);
+#else
+        (void)title;
+        (void)shaderDir;
+        std::cerr << "Display: built without GLFW (BLACKHOLE_GLFW=0), use the offscreen constructor" << std::endl;
+#endif
+    }
 
-        glDeleteShader(vert);
-        glDeleteShader(fScene);
-        glDeleteShader(fBlur);
-        glDeleteShader(fComp);
+    // Offscreen: EGL pbuffer context (no window system needed), composite into an
+    // RGBA8 FBO and read every frame back through a ring of `readbackDepth` PBOs
+    // (0: no automatic readback, use readFrameSync)
+    Display(int width, int height, const std::string& shaderDir, int readbackDepth)
+        : window_width(width), window_height(height), ready(false), offscreen(true),
+          readback(readbackDepth), frameIndex(0),
+          activeVariant(0), wantedVariant(0), parallelCompile(false),
+          geodesicCache(true), gbufferValid(false), cameraRevision(0), geodesicTraces(0),
+          bloomMode(BloomMode::DualFilter), bloomIterations(8), bloomLevels(5), bloomRadius(1.0f),
+          bloomStrength(0.15f), exposure(1.2f),
+          scene_width(width), scene_height(height), renderScale(1.0f), dynamicResolution(false),
+          lastSceneMs(0.0), gpuTiming(true), timingOverlay(false), inputGpuNs(0),
+          epoch(Clock::now()), haveFrameEnd(false)
+    {
+#if BLACKHOLE_EGL
+        if (initEGL()) initGL(width, height, shaderDir);
+#else
+        (void)shaderDir;
+        std::cerr << "Display: built without EGL (BLACKHOLE_EGL=0), offscreen mode unavailable" << std::endl;
+#endif
     }
 
     ~Display() {
-        glDeleteFramebuffers(1, &sceneFBO);
-        glDeleteFramebuffers(1, &pingFBO);
-        glDeleteFramebuffers(1, &pongFBO);
-        glDeleteTextures(1, &sceneTexture);
-        glDeleteTextures(1, &pingTexture);
-        glDeleteTextures(1, &pongTexture);
-        glDeleteVertexArrays(1, &quadVAO);
-        glDeleteBuffers(1, &quadVBO);
-        glDeleteProgram(sceneProgram);
-        glDeleteProgram(blurProgram);
-        glDeleteProgram(compositeProgram);
-        if (window) glfwDestroyWindow(window);
-        glfwTerminate();
+        if (ready) {
+            glDeleteFramebuffers(1, &sceneFBO);
+            glDeleteFramebuffers(1, &pingFBO);
+            glDeleteFramebuffers(1, &pongFBO);
+            glDeleteTextures(1, &sceneTexture);
+            glDeleteTextures(1, &pingTexture);
+            glDeleteTextures(1, &pongTexture);
+            deleteBloomChain();
+            glDeleteFramebuffers(1, &gbufferFBO);
+            glDeleteTextures(GBUFFER_TARGETS, gbufferTextures);
+            glDeleteTextures(1, &starfieldTexture);
+            glDeleteTextures(1, &diskEmissionTexture);
+            gpuTimer.release();
+            glDeleteVertexArrays(1, &quadVAO);
+            glDeleteBuffers(1, &quadVBO);
+            glDeleteProgram(blurProgram);
+            glDeleteProgram(downProgram);
+            glDeleteProgram(upProgram);
+            glDeleteProgram(compositeProgram);
+            for (const SceneVariant& v : variants) {
+                glDeleteProgram(v.scene);
+                glDeleteProgram(v.trace);
+                glDeleteProgram(v.shade);
+            }
+            if (offscreen) {
+                readback.release();
+                glDeleteFramebuffers(1, &outputFBO);
+                glDeleteTextures(1, &outputTexture);
+            }
+        }
+#if BLACKHOLE_EGL
+        if (eglDisplay != EGL_NO_DISPLAY) {
+            eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            if (eglContext != EGL_NO_CONTEXT) eglDestroyContext(eglDisplay, eglContext);
+            if (eglSurface != EGL_NO_SURFACE) eglDestroySurface(eglDisplay, eglSurface);
+            eglTerminate(eglDisplay);
+        }
+#endif
+#if BLACKHOLE_GLFW
+        if (!offscreen) {
+            if (window) glfwDestroyWindow(window);
+            glfwTerminate();
+        }
+#endif
     }
 
+    // --- Program binary cache ---
+    // Where linked programs are cached ("" disables it). Applies to Displays
+    // constructed afterwards; defaults to ~/.cache/schwarzschild-rtx.
+    static void setProgramCacheDir(const std::string& dir) { programCacheDir() = dir; }
+    const ProgramCache::Stats& getProgramCacheStats() const { return programCache.getStats(); }
+    const std::string& getProgramCacheDir() const { return programCache.getDir(); }
+
+    // --- Baked starfield ---
+    // Cube face edge in texels for Displays constructed afterwards (default
+    // 1024: texels a little finer than the 500-per-radian star grid)
+    static void setStarfieldSize(int size) { starfieldSize() = size; }
+    double getStarfieldBakeMs() const { return starfieldBakeMs; }
+
+    // --- Baked disk emission ---
+    // Texels around and across the disk for Displays constructed afterwards
+    // (default 2048 × 512: a few texels per dot of the finest particle layer)
+    static void setDiskEmissionSize(int angular, int radial) { diskEmissionSize() = { angular, radial }; }
+    double getDiskEmissionBakeMs() const { return diskEmissionBakeMs; }
+
     // --- Use the scene shader for setting uniforms ---
     void useSceneShader() {
         glUseProgram(sceneProgram);
     }
 
-    // --- Set uniforms on the currently active program ---
-    void setUniform1f(const char* name, float v) {
-        glUniform1f(glGetUniformLocation(sceneProgram, name), v);
+    // --- Set scene uniforms (direct, G-buffer trace and G-buffer shade programs) ---
+    void setUniform1f(const char* name, float v) { setSceneUniform(name, 1, v, 0.0f, 0.0f); }
+    void setUniform2f(const char* name, float x, float y) { setSceneUniform(name, 2, x, y, 0.0f); }
+    void setUniform3f(const char* name, float x, float y, float z) { setSceneUniform(name, 3, x, y, z); }
+
+    // --- Quality presets (see quality.hpp) ---
+    // Switches the ray passes to the variant for `q`. A variant built before
+    // switches at once. Otherwise, with parallel shader compile, it links on
+    // driver threads while frames keep using the current one and takes over in
+    // the first draw() after it finishes (returns false); without, it is built
+    // here and this call blocks. prepareQuality() builds ahead of time.
+    bool setQuality(const QualitySettings& q) {
+        QualitySettings want = q.clamped();
+        int index = findVariant(want);
+        if (index < 0) index = buildVariant(want, true);
+        wantedVariant = index;
+        pollVariants();
+        return activeVariant == index;
+    }
+    // Build (or start building) a variant without switching to it
+    void prepareQuality(const QualitySettings& q) {
+        QualitySettings want = q.clamped();
+        if (findVariant(want) < 0) buildVariant(want, true);
+    }
+    // Block until every background build has finished (and switch if one was wanted)
+    void finishQuality() {
+        for (const SceneVariant& v : variants)
+            if (v.linking)
+                for (GLuint prog : { v.scene, v.trace, v.shade }) {
+                    GLint status;
+                    glGetProgramiv(prog, GL_LINK_STATUS, &status);   // Waits for the link
+                }
+        pollVariants();
     }
-    void setUniform2f(const char* name, float x, float y) {
-        glUniform2f(glGetUniformLocation(sceneProgram, name), x, y);
+    const QualitySettings& getQuality() const { return variants[activeVariant].quality; }
+    bool qualityPending() const { return wantedVariant != activeVariant; }
+    bool qualityReady(const QualitySettings& q) const {
+        int index = findVariant(q.clamped());
+        return index >= 0 && !variants[index].linking;
+    }
+    int getQualityVariantCount() const { return static_cast<int>(variants.size()); }
+    bool parallelShaderCompile() const { return parallelCompile; }
+
+    // --- Geodesic G-buffer control ---
+    // Pass Camera::revision every frame; the cached geodesics are re-traced
+    // only when it changes (position, basis or FOV) or the viewport resizes.
+    void setCameraRevision(std::uint64_t revision) {
+        if (revision != cameraRevision) {
+            cameraRevision = revision;
+            gbufferValid = false;
+        }
     }
-    void setUniform3f(const char* name, float x, float y, float z) {
-        glUniform3f(glGetUniformLocation(sceneProgram, name), x, y, z);
+    void invalidateGeodesics() { gbufferValid = false; }
+    void setGeodesicCache(bool enabled) {
+        geodesicCache = enabled;
+        gbufferValid = false;
     }
+    bool geodesicCacheEnabled() const { return geodesicCache; }
+    std::uint64_t getGeodesicTraceCount() const { return geodesicTraces; }
 
     // --- Full bloom render pipeline ---
     void draw() {
-        // ===== PASS 1: Render black hole scene to HDR FBO =====
-        glUseProgram(sceneProgram);
-        glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
-        glClear(GL_COLOR_BUFFER_BIT);
         glBindVertexArray(quadVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
 
-        // ===== PASS 2: Gaussian blur (ping-pong) =====
-        glUseProgram(blurProgram);
-        bool horizontal = true;
-        bool firstPass = true;
+        Clock::time_point cpuStart = Clock::now();
+        pollVariants();
+        collectTimings();
+        if (gpuTiming && gpuTimer.beginFrame() && inputGpuNs) gpuTimer.markInput(inputGpuNs);
+        inputGpuNs = 0;
 
-        for (int i = 0; i < bloomIterations * 2; i++) {
-            glBindFramebuffer(GL_FRAMEBUFFER, horizontal ? pingFBO : pongFBO);
-            glUniform1i(glGetUniformLocation(blurProgram, "uHorizontal"), horizontal);
+        // ===== PASS 1 renders at the render scale =====
+        glViewport(0, 0, scene_width, scene_height);
 
-            // First pass reads from scene; subsequent passes ping-pong
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, firstPass ? sceneTexture : (horizontal ? pongTexture : pingTexture));
-            glUniform1i(glGetUniformLocation(blurProgram, "uImage"), 0);
+        glActiveTexture(GL_TEXTURE0 + STARFIELD_UNIT);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, starfieldTexture);
+        glActiveTexture(GL_TEXTURE0 + DISK_EMISSION_UNIT);
+        glBindTexture(GL_TEXTURE_2D, diskEmissionTexture);
+
+        if (geodesicCache) {
+            // ===== PASS 1a: Trace geodesics into the G-buffer (camera changed) =====
+            if (!gbufferValid) {
+                glUseProgram(gbufferTraceProgram);
+                glBindFramebuffer(GL_FRAMEBUFFER, gbufferFBO);
+                glDrawArrays(GL_TRIANGLES, 0, 6);
+                gbufferValid = true;
+                geodesicTraces++;
+            }
 
+            // ===== PASS 1b: Reshade the HDR scene from the G-buffer =====
+            glUseProgram(gbufferShadeProgram);
+            glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+            glClear(GL_COLOR_BUFFER_BIT);
+            static const char* samplers[GBUFFER_TARGETS] = {
+                "uGTermination", "uGCrossing0", "uGCrossing1", "uGCrossing2", "uGCrossing3"
+            };
+            for (int i = 0; i < GBUFFER_TARGETS; i++) {
+                glActiveTexture(GL_TEXTURE0 + i);
+                glBindTexture(GL_TEXTURE_2D, gbufferTextures[i]);
+                glUniform1i(glGetUniformLocation(gbufferShadeProgram, samplers[i]), i);
+            }
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+        } else {
+            // ===== PASS 1: Render black hole scene to HDR FBO =====
+            glUseProgram(sceneProgram);
+            glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
             glClear(GL_COLOR_BUFFER_BIT);
             glDrawArrays(GL_TRIANGLES, 0, 6);
+        }
+
+        gpuTimer.mark("scene");
+
+        GLuint bloomTexture;
+        if (bloomMode == BloomMode::DualFilter && !bloomChain.empty()) {
+            // ===== PASS 2a: Downsample the scene through the mip chain =====
+            glUseProgram(downProgram);
+            glUniform1f(glGetUniformLocation(downProgram, "uRadius"), bloomRadius);
+            glUniform1i(glGetUniformLocation(downProgram, "uImage"), 0);
+            glActiveTexture(GL_TEXTURE0);
+            for (std::size_t i = 0; i < bloomChain.size(); i++) {
+                glBindFramebuffer(GL_FRAMEBUFFER, bloomChain[i].fbo);
+                glViewport(0, 0, bloomChain[i].w, bloomChain[i].h);
+                glBindTexture(GL_TEXTURE_2D, i == 0 ? sceneTexture : bloomChain[i - 1].tex);
+                glDrawArrays(GL_TRIANGLES, 0, 6);
+                gpuTimer.mark("bloom_down", static_cast<int>(i));
+            }
+
+            // ===== PASS 2b: Tent-upsample back up to half resolution =====
+            glUseProgram(upProgram);
+            glUniform1f(glGetUniformLocation(upProgram, "uRadius"), bloomRadius);
+            glUniform1i(glGetUniformLocation(upProgram, "uImage"), 0);
+            for (std::size_t i = bloomChain.size() - 1; i-- > 0;) {
+                glBindFramebuffer(GL_FRAMEBUFFER, bloomChain[i].fbo);
+                glViewport(0, 0, bloomChain[i].w, bloomChain[i].h);
+                glBindTexture(GL_TEXTURE_2D, bloomChain[i + 1].tex);
+                glDrawArrays(GL_TRIANGLES, 0, 6);
+                gpuTimer.mark("bloom_up", static_cast<int>(i));
+            }
+            bloomTexture = bloomChain[0].tex;
+        } else {
+            // ===== PASS 2: Full-resolution Gaussian blur (ping-pong) =====
+            glUseProgram(blurProgram);
+            glViewport(0, 0, scene_width, scene_height);
+            bool horizontal = true;
+            bool firstPass = true;
+
+            for (int i = 0; i < bloomIterations * 2; i++) {
+                glBindFramebuffer(GL_FRAMEBUFFER, horizontal ? pingFBO : pongFBO);
+                glUniform1i(glGetUniformLocation(blurProgram, "uHorizontal"), horizontal);
+
+                // First pass reads from scene; subsequent passes ping-pong
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, firstPass ? sceneTexture : (horizontal ? pongTexture : pingTexture));
+                glUniform1i(glGetUniformLocation(blurProgram, "uImage"), 0);
+
+                glClear(GL_COLOR_BUFFER_BIT);
+                glDrawArrays(GL_TRIANGLES, 0, 6);
+                gpuTimer.mark("blur", i);
 
-            horizontal = !horizontal;
-            firstPass = false;
+                horizontal = !horizontal;
+                firstPass = false;
+            }
+            bloomTexture = horizontal ? pongTexture : pingTexture;
         }
 
-        // ===== PASS 3: Composite scene + bloom to screen =====
+        // ===== PASS 3: Composite scene + bloom to screen (or the offscreen output) =====
+        // Upscales a reduced-resolution scene to the window
         glUseProgram(compositeProgram);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0); // Default framebuffer (screen)
+        glBindFramebuffer(GL_FRAMEBUFFER, offscreen ? outputFBO : 0);
+        glViewport(0, 0, window_width, window_height);
         glClear(GL_COLOR_BUFFER_BIT);
 
         // Bind scene texture to unit 0
@@ -276,27 +999,117 @@ public:
 
         // Bind bloom (last blurred result) to unit 1
         glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, horizontal ? pongTexture : pingTexture);
+        glBindTexture(GL_TEXTURE_2D, bloomTexture);
         glUniform1i(glGetUniformLocation(compositeProgram, "uBloom"), 1);
 
         glUniform1f(glGetUniformLocation(compositeProgram, "uBloomStrength"), bloomStrength);
         glUniform1f(glGetUniformLocation(compositeProgram, "uExposure"), exposure);
+        glUniform1i(glGetUniformLocation(compositeProgram, "uUpscale"),
+                    scene_width < window_width || scene_height < window_height);
 
         glDrawArrays(GL_TRIANGLES, 0, 6);
         glBindVertexArray(0);
+        gpuTimer.mark("composite");
+        gpuTimer.endFrame();
+        if (timingOverlay) drawTimingOverlay();
+        telemetry.record("cpu_submit", std::chrono::duration<double, std::milli>(Clock::now() - cpuStart).count());
+
+        if (offscreen) {
+            // Queue this frame's copy; it lands while the next frames render
+            readback.queue(outputFBO, window_width, window_height, frameIndex++);
+        } else {
+#if BLACKHOLE_GLFW
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+#endif
+        }
+        endFrameTiming();
+    }
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+    // --- Frame timing ---
+    // Rolling p50/p95/p99 per series, in ms:
+    //   scene, bloom_down<i> / bloom_up<i> or blur<i>, composite, gpu_frame — GPU passes
+    //   cpu_submit    — CPU time in draw() before the swap / readback
+    //   cpu_frame     — interval between successive draw() returns (frame pacing)
+    //   input_latency — markInput() to the composite finishing on the GPU
+    // GPU series arrive a few frames late and stop while GPU timing is off.
+    const FrameTelemetry& getTelemetry() const { return telemetry; }
+    FrameTelemetry& getTelemetry() { return telemetry; }
+    void setGpuTiming(bool enabled) { gpuTiming = enabled; }   // Dynamic resolution needs it on
+    bool gpuTimingEnabled() const { return gpuTiming; }
+    void setTimingOverlay(bool enabled) { timingOverlay = enabled; }
+    bool timingOverlayEnabled() const { return timingOverlay; }
+    // Call right after sampling input for the next frame. Reads the GPU clock,
+    // so the latency covers CPU work, queueing and the GPU frame, but not
+    // the wait for scanout after the swap.
+    void markInput() {
+        GLint64 now = 0;
+        glGetInteger64v(GL_TIMESTAMP, &now);
+        inputGpuNs = now;
     }
 
+#if BLACKHOLE_GLFW
     bool shouldClose() { return glfwWindowShouldClose(window); }
     bool isKeyPressed(int key) { return glfwGetKey(window, key) == GLFW_PRESS; }
     GLFWwindow* getWindow() { return window; }
+#endif
     int getWidth() const { return window_width; }
     int getHeight() const { return window_height; }
+    bool isReady() const { return ready; }
+
+    // Resize every render target (the window's framebuffer callback calls this)
+    void resize(int w, int h) {
+        window_width = w;
+        window_height = h;
+        resizeFBOs(w, h);
+        glViewport(0, 0, w, h);
+    }
+
+    // --- Offscreen frame capture ---
+    bool isOffscreen() const { return offscreen; }
+    // Oldest drawn frame whose readback has landed (with `wait`, block until it has);
+    // frames come out in draw order, numbered from 0
+    bool takeFrame(LdrImage& out, std::uint64_t* frame = nullptr, bool wait = false) {
+        return readback.poll(out, frame, wait);
+    }
+    std::size_t framesInFlight() const { return readback.pending(); }
+    const FrameReadback::Stats& getReadbackStats() const { return readback.getStats(); }
+    // Blocking glReadPixels of the last composite (the pre-PBO path, for comparison)
+    LdrImage readFrameSync() { return FrameReadback::readSync(outputFBO, window_width, window_height); }
+
+    // --- Dynamic resolution ---
+    // Scales the scene pass to hold settings.targetMs (measured with GPU timer
+    // queries); the composite upscales it back to the window
+    void setDynamicResolution(bool enabled, const ResolutionSettings& settings = {}) {
+        dynamicResolution = enabled;
+        resolution = ResolutionController(settings);
+        setRenderScale(enabled ? resolution.scale() : 1.0f);
+    }
+    bool dynamicResolutionEnabled() const { return dynamicResolution; }
+    // Fixed scene-pass scale per axis (the controller's starting point when enabled)
+    void setRenderScale(float scale) {
+        if (dynamicResolution) {
+            resolution.setScale(scale);
+            scale = resolution.scale();
+        }
+        renderScale = std::clamp(scale, 0.1f, 2.0f);
+        resizeSceneTargets();
+    }
+    float getRenderScale() const { return renderScale; }
+    int getSceneWidth() const { return scene_width; }
+    int getSceneHeight() const { return scene_height; }
+    double getLastSceneMs() const { return lastSceneMs; }   // Latest scene-pass GPU time
+    const ResolutionController& getResolutionController() const { return resolution; }
 
     // --- Bloom tuning ---
     void setBloomStrength(float s) { bloomStrength = s; }
     void setBloomIterations(int n) { bloomIterations = n; }
+    void setBloomLevels(int n) {
+        bloomLevels = n > 0 ? n : 1;
+        createBloomChain(scene_width, scene_height);
+    }
+    void setBloomRadius(float r) { bloomRadius = r; }
+    void setBloomMode(BloomMode mode) { bloomMode = mode; }
+    BloomMode getBloomMode() const { return bloomMode; }
     void setExposure(float e) { exposure = e; }
 };
\ No newline at end of file
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ============================================================
+//  Frame timing telemetry
+//  Named series of millisecond samples (GPU passes, CPU frame
+//  interval, input latency), each kept over a rolling window of
+//  the last N frames. Percentiles are exact over that window.
+//  Series keep the order they were first recorded in, so reports
+//  list passes in pipeline order. No GL here; Display feeds it.
+// ============================================================
+
+class RollingHistogram {
+public:
+    struct Summary {
+        std::size_t count = 0;
+        double mean = 0.0, p50 = 0.0, p95 = 0.0, p99 = 0.0, max = 0.0;
+    };
+
+    explicit RollingHistogram(std::size_t window = 240) : samples(window > 0 ? window : 1) {}
+
+    void add(double ms) {
+        samples[next] = ms;
+        next = (next + 1) % samples.size();
+        filled = std::min(filled + 1, samples.size());
+    }
+
+    std::size_t count() const { return filled; }
+    std::size_t window() const { return samples.size(); }
+    double last() const { return filled ? samples[(next + samples.size() - 1) % samples.size()] : 0.0; }
+    // i-th sample from the oldest still in the window
+    double at(std::size_t i) const { return samples[(next + samples.size() - filled + i) % samples.size()]; }
+
+    // Nearest-rank percentile, p in [0, 100]
+    double percentile(double p) const { return rank(sorted(), p); }
+
+    Summary summary() const {
+        Summary s;
+        std::vector<double> v = sorted();
+        s.count = v.size();
+        if (v.empty()) return s;
+        for (double x : v) s.mean += x / v.size();
+        s.p50 = rank(v, 50.0);
+        s.p95 = rank(v, 95.0);
+        s.p99 = rank(v, 99.0);
+        s.max = v.back();
+        return s;
+    }
+
+private:
+    std::vector<double> sorted() const {
+        std::vector<double> v(filled);
+        for (std::size_t i = 0; i < filled; i++) v[i] = at(i);
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+    static double rank(const std::vector<double>& v, double p) {
+        if (v.empty()) return 0.0;
+        std::size_t n = static_cast<std::size_t>(std::max(1.0, std::ceil(p / 100.0 * v.size() - 1e-9)));
+        return v[std::min(n, v.size()) - 1];
+    }
+
+    std::vector<double> samples;
+    std::size_t next = 0, filled = 0;
+};
+
+class FrameTelemetry {
+public:
+    explicit FrameTelemetry(std::size_t window = 240) : windowSize(window) {}
+
+    void record(const std::string& name, double ms) { series(name).add(ms); }
+
+    // nullptr until the series has its first sample
+    const RollingHistogram* find(const std::string& name) const {
+        for (const auto& s : entries)
+            if (s.first == name) return &s.second;
+        return nullptr;
+    }
+    RollingHistogram::Summary summary(const std::string& name) const {
+        const RollingHistogram* h = find(name);
+        return h ? h->summary() : RollingHistogram::Summary{};
+    }
+    std::vector<std::string> names() const {
+        std::vector<std::string> out;
+        for (const auto& s : entries) out.push_back(s.first);
+        return out;
+    }
+    void clear() { entries.clear(); }
+
+    // One line per series: name, samples, mean / p50 / p95 / p99 / max in ms
+    std::string report() const {
+        std::string out = "  series              n     mean      p50      p95      p99      max (ms)\n";
+        char line[160];
+        for (const auto& s : entries) {
+            RollingHistogram::Summary m = s.second.summary();
+            std::snprintf(line, sizeof(line), "  %-16s %4zu %8.3f %8.3f %8.3f %8.3f %8.3f\n", s.first.c_str(), m.count,
+                          m.mean, m.p50, m.p95, m.p99, m.max);
+            out += line;
+        }
+        return out;
+    }
+
+    // Appends one row per series, writing the header into a new file
+    bool appendCsv(const std::string& path, double elapsedSeconds) const {
+        bool fresh = !std::ifstream(path).good();
+        std::ofstream f(path, std::ios::app);
+        if (!f) return false;
+        if (fresh) f << "time_s,series,count,mean_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+        char line[200];
+        for (const auto& s : entries) {
+            RollingHistogram::Summary m = s.second.summary();
+            std::snprintf(line, sizeof(line), "%.3f,%s,%zu,%.4f,%.4f,%.4f,%.4f,%.4f\n", elapsedSeconds,
+                          s.first.c_str(), m.count, m.mean, m.p50, m.p95, m.p99, m.max);
+            f << line;
+        }
+        return static_cast<bool>(f);
+    }
+
+    // --- Periodic dump ---
+    // Every `intervalSeconds` (0 disables), tick() prints report() to stdout
+    // and, with a path, appends the CSV rows
+    void setDump(double intervalSeconds, const std::string& csv = "", bool toStdout = true) {
+        dumpInterval = intervalSeconds;
+        csvPath = csv;
+        dumpStdout = toStdout;
+        nextDump = -1.0;
+    }
+    double getDumpInterval() const { return dumpInterval; }
+
+    // Called once per frame with a monotonic time; true if it dumped
+    bool tick(double nowSeconds) {
+        if (dumpInterval <= 0.0) return false;
+        if (nextDump < 0.0) {
+            startTime = nowSeconds;
+            nextDump = nowSeconds + dumpInterval;
+            return false;
+        }
+        if (nowSeconds < nextDump) return false;
+        nextDump = nowSeconds + dumpInterval;
+        if (dumpStdout) std::fputs(report().c_str(), stdout);
+        if (!csvPath.empty()) appendCsv(csvPath, nowSeconds - startTime);
+        return true;
+    }
+
+private:
+    RollingHistogram& series(const std::string& name) {
+        for (auto& s : entries)
+            if (s.first == name) return s.second;
+        entries.emplace_back(name, RollingHistogram(windowSize));
+        return entries.back().second;
+    }
+
+    std::size_t windowSize;
+    std::vector<std::pair<std::string, RollingHistogram>> entries;   // First-recorded order
+    double dumpInterval = 0.0, nextDump = -1.0, startTime = 0.0;
+    std::string csvPath;
+    bool dumpStdout = true;
+};
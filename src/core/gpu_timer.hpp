@@ -0,0 +1,109 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================
+//  GPU pass timing with GL_TIMESTAMP queries
+//  A frame is a sequence of glQueryCounter marks: one at
+//  beginFrame(), then one after each pass, so a pass's time is
+//  the gap to the previous mark. Unlike GL_TIME_ELAPSED queries,
+//  which cannot overlap, marks can bracket any pass sequence.
+//  Results arrive frames late: frames sit in a ring of `depth`
+//  slots and collect() reads only the ones whose queries have
+//  landed, never waiting. A frame that finds the ring full is
+//  simply not timed.
+// ============================================================
+class GpuPassTimer {
+public:
+    explicit GpuPassTimer(int depth = 4) : slots(depth > 0 ? depth : 1) {}
+
+    // Start timing a frame; false (and the frame's marks are ignored) if the ring is full
+    bool beginFrame() {
+        active = count < slots.size();
+        if (!active) return false;
+        Slot& s = slots[(head + count) % slots.size()];
+        s.marks = 0;
+        s.inputNs = 0;
+        stamp(s, "", -1);
+        return true;
+    }
+
+    // Timestamp after a pass; `index` >= 0 is appended to the name (per-level passes)
+    void mark(const char* name, int index = -1) {
+        if (active) stamp(slots[(head + count) % slots.size()], name, index);
+    }
+
+    // GPU clock when the input that drives this frame was sampled (see Display::markInput)
+    void markInput(std::int64_t gpuNs) {
+        if (active) slots[(head + count) % slots.size()].inputNs = gpuNs;
+    }
+
+    void endFrame() {
+        if (active) count++;
+        active = false;
+    }
+
+    // For each finished frame, oldest first: onPass(name, ms) per mark, then
+    // onFrame(totalMs, endNs, inputNs) with the GPU clock at the last mark
+    template <typename PassFn, typename FrameFn>
+    void collect(PassFn&& onPass, FrameFn&& onFrame) {
+        while (count > 0) {
+            Slot& s = slots[head];
+            GLint available = 0;
+            glGetQueryObjectiv(s.queries[s.marks - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) return;
+
+            GLuint64 prev = 0, first = 0;
+            for (std::size_t i = 0; i < s.marks; i++) {
+                GLuint64 t = 0;
+                glGetQueryObjectui64v(s.queries[i], GL_QUERY_RESULT, &t);
+                if (i == 0) first = t;
+                else onPass(s.names[i], (t - prev) * 1e-6);
+                prev = t;
+            }
+            onFrame((prev - first) * 1e-6, static_cast<std::int64_t>(prev), s.inputNs);
+            head = (head + 1) % slots.size();
+            count--;
+        }
+    }
+
+    int inFlight() const { return static_cast<int>(count); }
+
+    // Deletes the queries; needs the GL context
+    void release() {
+        for (Slot& s : slots) {
+            if (!s.queries.empty()) glDeleteQueries(static_cast<GLsizei>(s.queries.size()), s.queries.data());
+            s = Slot();
+        }
+        head = count = 0;
+        active = false;
+    }
+
+private:
+    struct Slot {
+        std::vector<GLuint> queries;      // Grown on demand, reused every frame
+        std::vector<std::string> names;
+        std::size_t marks = 0;
+        std::int64_t inputNs = 0;
+    };
+
+    void stamp(Slot& s, const char* name, int index) {
+        if (s.marks == s.queries.size()) {
+            GLuint q;
+            glGenQueries(1, &q);
+            s.queries.push_back(q);
+            s.names.emplace_back();
+        }
+        glQueryCounter(s.queries[s.marks], GL_TIMESTAMP);
+        std::string& n = s.names[s.marks++];
+        n = name;   // Reuses the string's capacity after the first frames
+        if (index >= 0) n += std::to_string(index);
+    }
+
+    std::vector<Slot> slots;
+    std::size_t head = 0, count = 0;
+    bool active = false;
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// ============================================================
+//  On-disk cache of linked shader programs
+//  glGetProgramBinary saves a linked program in the driver's own
+//  format; glProgramBinary restores it without compiling. Each
+//  program is one file, <dir>/<name>.bin, whose header records a
+//  hash of the exact sources and a hash of the driver (vendor,
+//  renderer, GL and GLSL versions). A different hash, a short
+//  file or a binary the driver rejects all fall back to compiling,
+//  and the fresh binary replaces the file. Drivers that expose no
+//  binary formats just compile every time.
+// ============================================================
+class ProgramCache {
+public:
+    struct Stats {
+        int hits = 0;      // Restored from disk
+        int misses = 0;    // No file, or sources / driver changed
+        int rejected = 0;  // Matching file the driver would not load
+        int written = 0;
+    };
+
+    // An empty dir disables the cache
+    explicit ProgramCache(const std::string& dir = defaultDir()) : dir(dir) {}
+
+    // $XDG_CACHE_HOME/schwarzschild-rtx, else ~/.cache/schwarzschild-rtx, else none
+    static std::string defaultDir() {
+        if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) return std::string(xdg) + "/schwarzschild-rtx";
+        if (const char* home = std::getenv("HOME"); home && *home) return std::string(home) + "/.cache/schwarzschild-rtx";
+        return "";
+    }
+
+    // FNV-1a, 64-bit
+    static std::uint64_t hash(const std::string& data, std::uint64_t h = 0xcbf29ce484222325ull) {
+        for (unsigned char c : data) {
+            h ^= c;
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    // Needs a current context. Returns the cached program for these sources, or
+    // build(retrievable) — which must compile and link them, setting
+    // GL_PROGRAM_BINARY_RETRIEVABLE_HINT before linking when asked — and saves it.
+    template <typename BuildFn>
+    GLuint get(const std::string& name, const std::string& vertSrc, const std::string& fragSrc, BuildFn&& build) {
+        if (GLuint prog = find(name, vertSrc, fragSrc)) return prog;
+        GLuint prog = build(enabled());
+        store(name, vertSrc, fragSrc, prog);
+        return prog;
+    }
+
+    // The two halves of get() for callers that link in the background
+    // (KHR_parallel_shader_compile): find() restores or returns 0, and
+    // store() saves the program once its link has completed.
+    GLuint find(const std::string& name, const std::string& vertSrc, const std::string& fragSrc) {
+        if (!enabled()) return 0;
+        return restore(path(name), sourceHash(vertSrc, fragSrc));
+    }
+
+    void store(const std::string& name, const std::string& vertSrc, const std::string& fragSrc, GLuint prog) {
+        if (!enabled()) return;
+        GLint linked = 0;
+        glGetProgramiv(prog, GL_LINK_STATUS, &linked);
+        if (linked) save(path(name), prog, sourceHash(vertSrc, fragSrc));
+    }
+
+    bool enabled() {
+        if (dir.empty()) return false;
+        if (formats < 0) {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            driverHash = hash(str(GL_VENDOR) + '\n' + str(GL_RENDERER) + '\n' + str(GL_VERSION) + '\n' +
+                              str(GL_SHADING_LANGUAGE_VERSION));
+        }
+        return formats > 0;
+    }
+
+    const std::string& getDir() const { return dir; }
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t sourceHash, driverHash;
+        std::uint32_t format, length;
+    };
+    static constexpr std::uint32_t VERSION = 1;
+
+    std::string path(const std::string& name) const { return dir + "/" + name + ".bin"; }
+    static std::uint64_t sourceHash(const std::string& vertSrc, const std::string& fragSrc) {
+        return hash(fragSrc, hash(vertSrc + '\0'));
+    }
+
+    static std::string str(GLenum name) {
+        const GLubyte* s = glGetString(name);
+        return s ? reinterpret_cast<const char*>(s) : "";
+    }
+
+    GLuint restore(const std::string& path, std::uint64_t sourceHash) {
+        std::ifstream f(path, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        Header h;
+        if (bytes.size() < sizeof(h)) {
+            stats.misses++;
+            return 0;
+        }
+        std::memcpy(&h, bytes.data(), sizeof(h));
+        if (std::memcmp(h.magic, "BHPB", 4) != 0 || h.version != VERSION || h.sourceHash != sourceHash ||
+            h.driverHash != driverHash || bytes.size() != sizeof(h) + h.length) {
+            stats.misses++;
+            return 0;
+        }
+
+        GLuint prog = glCreateProgram();
+        glProgramBinary(prog, h.format, bytes.data() + sizeof(h), static_cast<GLsizei>(h.length));
+        GLint linked = 0;
+        glGetProgramiv(prog, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            glDeleteProgram(prog);
+            stats.rejected++;
+            return 0;
+        }
+        stats.hits++;
+        return prog;
+    }
+
+    void save(const std::string& path, GLuint prog, std::uint64_t sourceHash) {
+        GLint length = 0;
+        glGetProgramiv(prog, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) return;
+        Header h{ { 'B', 'H', 'P', 'B' }, VERSION, sourceHash, driverHash, 0, 0 };
+        std::vector<char> bytes(sizeof(h) + static_cast<std::size_t>(length));
+        GLsizei written = 0;
+        GLenum format = 0;
+        glGetProgramBinary(prog, length, &written, &format, bytes.data() + sizeof(h));
+        if (written <= 0) return;
+        h.format = format;
+        h.length = static_cast<std::uint32_t>(written);
+        std::memcpy(bytes.data(), &h, sizeof(h));
+
+        // Write-then-rename: a concurrent launch never reads a half-written file
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+            if (!f.write(bytes.data(), static_cast<std::streamsize>(sizeof(h) + h.length))) return;
+        }
+        std::filesystem::rename(tmp, path, ec);
+        if (!ec) stats.written++;
+    }
+
+    std::string dir;
+    GLint formats = -1;   // Queried on first use (needs the context)
+    std::uint64_t driverHash = 0;
+    Stats stats;
+};
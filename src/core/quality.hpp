@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// ============================================================
+//  Shader quality presets
+//  The ray-marching passes read their work limits from
+//  QUALITY_* macros (defaults in geodesic.glsl = "high"). A
+//  QualitySettings becomes a #define block that Display splices
+//  in after #version, so each preset is its own program variant
+//  and the compiler unrolls or drops the work at build time —
+//  no uniform branches left in the inner loop.
+//   • maxSteps       RK4 steps before a ray gives up
+//   • stepScale      multiplies uStepSize; fewer steps need longer
+//                    ones to still reach ESCAPE_R from the camera
+//   • particleLayers disk particle layers (of 8), brightness kept
+//   • fbmOctaves     octaves of the diffuse disk glow
+//   • diskCrossings  disk crossings composited (G-buffer holds 4)
+//   • bakedStarfield escaped rays read the baked sky cubemap
+//                    instead of hashing the procedural starfield
+//   • bakedDisk      disk crossings read the baked (φ, r) emission
+//                    map; particleLayers and fbmOctaves then only
+//                    apply with it off
+// ============================================================
+
+struct QualitySettings {
+    int maxSteps = 1000;
+    float stepScale = 1.0f;
+    int particleLayers = 8;
+    int fbmOctaves = 4;
+    int diskCrossings = 4;
+    bool bakedStarfield = true;
+    bool bakedDisk = true;
+
+    static QualitySettings low() { return { 400, 2.0f, 3, 2, 2 }; }
+    static QualitySettings medium() { return { 600, 1.5f, 5, 3, 3 }; }
+    static QualitySettings high() { return {}; }
+    static QualitySettings ultra() { return { 2000, 0.5f, 8, 6, 4 }; }
+
+    static const std::vector<std::string>& presetNames() {
+        static const std::vector<std::string> names = { "low", "medium", "high", "ultra" };
+        return names;
+    }
+
+    // Preset by name; false (and `out` untouched) for unknown names
+    static bool fromName(const std::string& name, QualitySettings& out) {
+        if (name == "low") out = low();
+        else if (name == "medium") out = medium();
+        else if (name == "high") out = high();
+        else if (name == "ultra") out = ultra();
+        else return false;
+        return true;
+    }
+
+    // Limits the shaders can honour
+    QualitySettings clamped() const {
+        QualitySettings q = *this;
+        q.maxSteps = std::clamp(q.maxSteps, 16, 8000);
+        q.stepScale = std::clamp(q.stepScale, 0.25f, 4.0f);
+        q.particleLayers = std::clamp(q.particleLayers, 0, 8);
+        q.fbmOctaves = std::clamp(q.fbmOctaves, 1, 8);
+        q.diskCrossings = std::clamp(q.diskCrossings, 1, 4);
+        return q;
+    }
+
+    bool operator==(const QualitySettings& o) const {
+        return maxSteps == o.maxSteps && stepScale == o.stepScale && particleLayers == o.particleLayers &&
+               fbmOctaves == o.fbmOctaves && diskCrossings == o.diskCrossings && bakedStarfield == o.bakedStarfield &&
+               bakedDisk == o.bakedDisk;
+    }
+    bool operator!=(const QualitySettings& o) const { return !(*this == o); }
+
+    // Preset name, or "custom-s<steps>x<scale>-p<layers>-f<octaves>-c<crossings>-b<sky>-d<disk>";
+    // also names the variant's program cache files
+    std::string tag() const {
+        for (const std::string& name : presetNames()) {
+            QualitySettings preset;
+            fromName(name, preset);
+            if (preset == *this) return name;
+        }
+        char buf[96];
+        std::snprintf(buf, sizeof(buf), "custom-s%dx%.3f-p%d-f%d-c%d-b%d-d%d", maxSteps, stepScale,
+                      particleLayers, fbmOctaves, diskCrossings, bakedStarfield ? 1 : 0, bakedDisk ? 1 : 0);
+        return buf;
+    }
+
+    // The #define block for this variant
+    std::string defines() const {
+        char buf[256];
+        std::snprintf(buf, sizeof(buf),
+                      "#define QUALITY_MAX_STEPS %d\n"
+                      "#define QUALITY_STEP_SCALE %.6f\n"
+                      "#define QUALITY_PARTICLE_LAYERS %d\n"
+                      "#define QUALITY_FBM_OCTAVES %d\n"
+                      "#define QUALITY_DISK_CROSSINGS %d\n"
+                      "#define QUALITY_BAKED_STARFIELD %d\n"
+                      "#define QUALITY_BAKED_DISK %d\n",
+                      maxSteps, stepScale, particleLayers, fbmOctaves, diskCrossings, bakedStarfield ? 1 : 0,
+                      bakedDisk ? 1 : 0);
+        return buf;
+    }
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <glad/glad.h>
+#include "../render/image.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <utility>
+#include <vector>
+
+// ============================================================
+//  Asynchronous framebuffer readback through a ring of PBOs
+//  glReadPixels into client memory blocks until the GPU has
+//  finished the frame. With a GL_PIXEL_PACK_BUFFER bound it only
+//  queues the copy, and a fence reports when it has landed. With
+//  a ring of `depth` buffers, frame N is copied out while frames
+//  N+1 … N+depth-1 render, and a buffer is only mapped once its
+//  fence has signalled. The CPU waits only when every buffer is
+//  still in flight.
+// ============================================================
+class FrameReadback {
+public:
+    struct Stats {
+        std::uint64_t frames = 0;     // Frames queued
+        std::uint64_t stalls = 0;     // queue() calls that found the ring full and waited
+        double stallSeconds = 0.0;    // ... time spent waiting in them
+    };
+
+    explicit FrameReadback(int depth = 3) : slots(depth > 0 ? depth : 0) {}
+
+    // Copy the w × h colour attachment of `fbo` (RGBA8) into the next free buffer
+    void queue(GLuint fbo, int w, int h, std::uint64_t frame) {
+        if (slots.empty()) return;
+        stats.frames++;
+        if (count == slots.size()) {
+            auto t0 = std::chrono::steady_clock::now();
+            LdrImage img;
+            std::uint64_t id = slots[head].frame;
+            take(img, true);
+            ready.emplace_back(id, std::move(img));
+            stats.stalls++;
+            stats.stallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        }
+
+        Slot& s = slots[(head + count) % slots.size()];
+        std::size_t bytes = static_cast<std::size_t>(w) * h * 4;
+        if (!s.pbo) glGenBuffers(1, &s.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+        if (s.capacity < bytes) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+            s.capacity = bytes;
+        }
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        s.w = w;
+        s.h = h;
+        s.frame = frame;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glFlush();   // Submit the copy and the fence now, not at the next draw
+        count++;
+    }
+
+    // Oldest queued frame, if its copy has landed (or, with `wait`, once it has).
+    // Frames come out in queue order.
+    bool poll(LdrImage& out, std::uint64_t* frame = nullptr, bool wait = false) {
+        if (!ready.empty()) {
+            if (frame) *frame = ready.front().first;
+            out = std::move(ready.front().second);
+            ready.pop_front();
+            return true;
+        }
+        if (count == 0) return false;
+        std::uint64_t id = slots[head].frame;
+        if (!take(out, wait)) return false;
+        if (frame) *frame = id;
+        return true;
+    }
+
+    std::size_t pending() const { return count + ready.size(); }
+    int depth() const { return static_cast<int>(slots.size()); }
+    const Stats& getStats() const { return stats; }
+
+    // Synchronous glReadPixels of the same attachment, for comparison
+    static LdrImage readSync(GLuint fbo, int w, int h) {
+        std::vector<std::uint8_t> rgba(static_cast<std::size_t>(w) * h * 4);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        LdrImage img(w, h);
+        unpack(rgba.data(), img);
+        return img;
+    }
+
+    // Deletes the buffers and fences; needs the GL context, so the owner
+    // calls it before tearing the context down
+    void release() {
+        for (Slot& s : slots) {
+            if (s.fence) glDeleteSync(s.fence);
+            if (s.pbo) glDeleteBuffers(1, &s.pbo);
+            s = Slot();
+        }
+        head = count = 0;
+        ready.clear();
+    }
+
+private:
+    struct Slot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        std::size_t capacity = 0;
+        int w = 0, h = 0;
+        std::uint64_t frame = 0;
+    };
+
+    // Map the oldest slot into `out` and free it; false if its fence is still pending
+    bool take(LdrImage& out, bool wait) {
+        Slot& s = slots[head];
+        GLenum status = glClientWaitSync(s.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? GL_TIMEOUT_IGNORED : 0);
+        if (status == GL_TIMEOUT_EXPIRED) return false;
+        glDeleteSync(s.fence);
+        s.fence = nullptr;
+
+        out = LdrImage(s.w, s.h);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+        const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                            static_cast<GLsizeiptr>(s.w) * s.h * 4, GL_MAP_READ_BIT);
+        if (data) {
+            unpack(static_cast<const std::uint8_t*>(data), out);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        head = (head + 1) % slots.size();
+        count--;
+        return true;
+    }
+
+    // GL rows run bottom-up in RGBA; LdrImage is top-down RGB
+    static void unpack(const std::uint8_t* rgba, LdrImage& img) {
+        for (int y = 0; y < img.height; y++) {
+            const std::uint8_t* src = rgba + static_cast<std::size_t>(img.height - 1 - y) * img.width * 4;
+            std::uint8_t* dst = &img.pixels[static_cast<std::size_t>(y) * img.width * 3];
+            for (int x = 0; x < img.width; x++) std::memcpy(dst + x * 3, src + x * 4, 3);
+        }
+    }
+
+    std::vector<Slot> slots;
+    std::size_t head = 0, count = 0;   // Oldest in-flight slot, slots in flight
+    std::deque<std::pair<std::uint64_t, LdrImage>> ready;   // Frames a full ring forced out early
+    Stats stats;
+};
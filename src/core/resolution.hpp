@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+// ============================================================
+//  Dynamic resolution controller
+//  Holds the scene pass near a time budget by scaling its render
+//  target (the composite stretches it back over the window).
+//  The pass cost is taken as ∝ pixels = scale², so a measured
+//  cost c at scale s predicts s·√(target / c) to hit the target.
+//  Three things stop it oscillating:
+//   • a dead band around the target where nothing changes,
+//   • scales snapped down to multiples of `step`,
+//   • after each change, `settleFrames` samples are ignored while
+//     timer latency catches up; growing also needs that many
+//     consecutive smoothed frames under the band.
+//  Shrinking acts on the first smoothed frame over the band, so
+//  a dive towards the photon sphere is caught at once. Growing
+//  waits out the settle period.
+// ============================================================
+
+struct ResolutionSettings {
+    double targetMs = 12.0;        // Scene-pass budget
+    float minScale = 0.5f;         // Per-axis render scale limits
+    float maxScale = 1.0f;
+    float step = 1.0f / 16.0f;     // Scales are multiples of this (render targets change rarely)
+    double band = 0.15;            // No change while the smoothed cost is within ±15% of the target
+    int settleFrames = 8;          // Frames held after a change; under-budget frames needed to grow
+    double smoothing = 0.3;        // Weight of the newest sample in the cost average
+};
+
+class ResolutionController {
+public:
+    explicit ResolutionController(const ResolutionSettings& settings = {})
+        : settings(settings), current(settings.maxScale) {}
+
+    // Feed one scene-pass time; true if scale() changed
+    bool update(double sceneMs) {
+        // Samples during the settle period may still come from the old scale (timer
+        // latency) or include the one-off retrace of reallocated targets: skip them
+        if (settle > 0) {
+            settle--;
+            return false;
+        }
+        average = average < 0.0 ? sceneMs : average + settings.smoothing * (sceneMs - average);
+
+        const double high = settings.targetMs * (1.0 + settings.band);
+        const double low = settings.targetMs * (1.0 - settings.band);
+        if (average > high) {
+            underFrames = 0;
+            return apply(snap(current * static_cast<float>(std::sqrt(settings.targetMs / average))));
+        }
+        if (average < low) {
+            if (++underFrames < settings.settleFrames) return false;
+            underFrames = 0;
+            return apply(snap(current * static_cast<float>(std::sqrt(settings.targetMs / average))));
+        }
+        underFrames = 0;
+        return false;
+    }
+
+    // Force a scale (snapped and clamped) and restart the settle period
+    void setScale(float scale) { apply(snap(scale)); }
+
+    float scale() const { return current; }
+    double smoothedMs() const { return average; }
+    long changes() const { return changeCount; }
+    const ResolutionSettings& getSettings() const { return settings; }
+
+private:
+    float snap(float scale) const {
+        float snapped = std::floor(scale / settings.step + 1e-4f) * settings.step;
+        return std::clamp(snapped, settings.minScale, settings.maxScale);
+    }
+
+    bool apply(float scale) {
+        if (scale == current) return false;
+        // The smoothed cost was measured at the old scale: rescale it to the predicted new cost
+        if (average >= 0.0) average *= static_cast<double>(scale) * scale / (static_cast<double>(current) * current);
+        current = scale;
+        settle = settings.settleFrames;
+        underFrames = 0;
+        changeCount++;
+        return true;
+    }
+
+    ResolutionSettings settings;
+    float current;
+    double average = -1.0;   // Smoothed scene-pass ms (< 0 until the first sample)
+    int settle = 0;
+    int underFrames = 0;
+    long changeCount = 0;
+};
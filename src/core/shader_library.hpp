@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ============================================================
+//  GLSL source lookup
+//  Shaders come either from files under a directory or, with an
+//  empty directory, from the copies cmake/embed_shaders.cmake
+//  compiled into the executable (BLACKHOLE_EMBED_SHADERS), so a
+//  binary runs from any working directory. Both paths splice
+//  `#include "file.glsl"` lines the same way, so they produce
+//  identical program sources.
+// ============================================================
+#ifndef BLACKHOLE_EMBED_SHADERS
+#define BLACKHOLE_EMBED_SHADERS 0
+#endif
+
+#if BLACKHOLE_EMBED_SHADERS
+#include "embedded_shaders.hpp"   // Generated into the build tree
+#endif
+
+class ShaderLibrary {
+public:
+    // Files under `dir`; an empty dir selects the embedded sources
+    explicit ShaderLibrary(const std::string& dir = "") : dir(dir) {
+        if (dir.empty() && !hasEmbedded())
+            std::cerr << "ERROR: No shader directory given and no shaders embedded in this build" << std::endl;
+    }
+
+    static bool hasEmbedded() { return BLACKHOLE_EMBED_SHADERS != 0; }
+    bool isEmbedded() const { return dir.empty(); }
+
+    // Embedded file names (empty without BLACKHOLE_EMBED_SHADERS)
+    static std::vector<std::string> embeddedNames() {
+        std::vector<std::string> names;
+#if BLACKHOLE_EMBED_SHADERS
+        for (const EmbeddedShader& s : EMBEDDED_SHADERS) names.push_back(s.name);
+#endif
+        return names;
+    }
+
+    // Source of `name` with its #includes spliced in (relative to the including
+    // file). Each file is included at most once per program; #line keeps
+    // compiler errors pointing at the right line of the parent. "" on error.
+    std::string load(const std::string& name) const {
+        std::set<std::string> included;
+        return load(name, included);
+    }
+
+    // `defines` spliced in right after the #version line (GLSL allows nothing
+    // before it), then a #line so compiler errors keep the file's numbering
+    static std::string withDefines(const std::string& source, const std::string& defines) {
+        if (defines.empty()) return source;
+        std::size_t at = 0;
+        std::size_t start = source.find_first_not_of(" \t\r\n");
+        if (start != std::string::npos && source.compare(start, 8, "#version") == 0) {
+            std::size_t eol = source.find('\n', start);
+            at = eol == std::string::npos ? source.size() : eol + 1;
+        }
+        std::string head = source.substr(0, at);
+        if (!head.empty() && head.back() != '\n') head += '\n';
+        long next = std::count(head.begin(), head.end(), '\n') + 1;
+        return head + defines + "#line " + std::to_string(next) + "\n" + source.substr(at);
+    }
+
+private:
+    bool read(const std::string& name, std::string& out) const {
+        if (dir.empty()) {
+#if BLACKHOLE_EMBED_SHADERS
+            for (const EmbeddedShader& s : EMBEDDED_SHADERS)
+                if (name == s.name) {
+                    out = s.source;
+                    return true;
+                }
+#endif
+            return false;
+        }
+        std::ifstream file(dir + "/" + name);
+        if (!file.is_open()) return false;
+        std::stringstream ss;
+        ss << file.rdbuf();
+        out = ss.str();
+        return true;
+    }
+
+    std::string load(const std::string& name, std::set<std::string>& included) const {
+        std::string text;
+        if (!read(name, text)) {
+            std::cerr << "ERROR: Cannot open shader file: " << (dir.empty() ? "<embedded>" : dir) << "/" << name
+                      << std::endl;
+            return "";
+        }
+        included.insert(name);
+
+        std::string base = name.substr(0, name.find_last_of('/') + 1);
+        std::istringstream in(text);
+        std::stringstream out;
+        std::string line;
+        int lineNo = 0;
+        while (std::getline(in, line)) {
+            lineNo++;
+            std::size_t start = line.find_first_not_of(" \t");
+            if (start != std::string::npos && line.compare(start, 8, "#include") == 0) {
+                std::size_t open = line.find('"', start);
+                std::size_t close = line.find('"', open + 1);
+                if (open == std::string::npos || close == std::string::npos) {
+                    std::cerr << "ERROR: Malformed #include in " << name << ":" << lineNo << std::endl;
+                    continue;
+                }
+                std::string path = base + line.substr(open + 1, close - open - 1);
+                if (!included.count(path)) {
+                    out << load(path, included);
+                    out << "#line " << lineNo + 1 << "\n";
+                }
+                continue;
+            }
+            out << line << "\n";
+        }
+        return out.str();
+    }
+
+    std::string dir;
+};
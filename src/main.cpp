@@ -5,7 +5,9 @@
 // ============================================================
 
 #include <iostream>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <string>
 
 #include "core/display.hpp"
@@ -36,12 +38,20 @@ int main() {
     std::cout << " Phase 5: GPU + HDR Bloom\n";
     std::cout << "===================================\n\n";
 
-    // Shader directory (relative to build/)
-    std::string shaderDir = "../src/shaders";
+    // Shaders are embedded at build time; otherwise read relative to build/
+    std::string shaderDir = ShaderLibrary::hasEmbedded() ? "" : "../src/shaders";
 
-    // 1. Initialize Display (compiles 3 shader programs, creates bloom FBOs)
+    // 1. Initialize Display (builds the shader programs, cached on disk; creates bloom FBOs)
     Display display(WIDTH, HEIGHT, "Schwarzschild Black Hole", shaderDir);
 
+    // Start the other quality presets linking now (driver threads where
+    // supported), so the 1-4 keys switch without a compile stall
+    for (const std::string& name : QualitySettings::presetNames()) {
+        QualitySettings q;
+        QualitySettings::fromName(name, q);
+        display.prepareQuality(q);
+    }
+
     // 2. Initialize Orbit Camera
     Camera camera(15.0f, 0.0f, 0.3f);
     g_camera = &camera;
@@ -55,6 +65,40 @@ int main() {
     glfwSetKeyCallback(win, [](GLFWwindow* w, int key, int, int action, int) {
         if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
             glfwSetWindowShouldClose(w, GLFW_TRUE);
+        if (key == GLFW_KEY_G && action == GLFW_PRESS) {
+            Display* d = static_cast<Display*>(glfwGetWindowUserPointer(w));
+            d->setGeodesicCache(!d->geodesicCacheEnabled());
+            std::cout << "Geodesic G-buffer cache: " << (d->geodesicCacheEnabled() ? "on" : "off") << "\n";
+        }
+        if (key == GLFW_KEY_B && action == GLFW_PRESS) {
+            Display* d = static_cast<Display*>(glfwGetWindowUserPointer(w));
+            bool dual = d->getBloomMode() == BloomMode::DualFilter;
+            d->setBloomMode(dual ? BloomMode::Gaussian : BloomMode::DualFilter);
+            std::cout << "Bloom: " << (dual ? "full-resolution Gaussian" : "dual-filter mip chain") << "\n";
+        }
+        if (key == GLFW_KEY_R && action == GLFW_PRESS) {
+            Display* d = static_cast<Display*>(glfwGetWindowUserPointer(w));
+            d->setDynamicResolution(!d->dynamicResolutionEnabled());
+            std::cout << "Dynamic resolution: " << (d->dynamicResolutionEnabled() ? "on" : "off")
+                      << " (scene " << d->getSceneWidth() << "x" << d->getSceneHeight() << ")\n";
+        }
+        if (key == GLFW_KEY_T && action == GLFW_PRESS) {
+            Display* d = static_cast<Display*>(glfwGetWindowUserPointer(w));
+            d->setTimingOverlay(!d->timingOverlayEnabled());
+        }
+        if (key >= GLFW_KEY_1 && key <= GLFW_KEY_4 && action == GLFW_PRESS) {
+            Display* d = static_cast<Display*>(glfwGetWindowUserPointer(w));
+            QualitySettings q;
+            QualitySettings::fromName(QualitySettings::presetNames()[key - GLFW_KEY_1], q);
+            bool now = d->setQuality(q);
+            std::cout << "Quality: " << q.tag() << (now ? "" : " (still compiling, switches when ready)") << "\n";
+        }
+        if (key == GLFW_KEY_P && action == GLFW_PRESS) {
+            Display* d = static_cast<Display*>(glfwGetWindowUserPointer(w));
+            bool on = d->getTelemetry().getDumpInterval() <= 0.0;
+            d->getTelemetry().setDump(on ? 2.0 : 0.0, on ? "frame_timing.csv" : "");
+            std::cout << "Timing dump: " << (on ? "every 2 s (stdout + frame_timing.csv)" : "off") << "\n";
+        }
     });
 
     std::cout << "Controls:\n";
@@ -63,9 +107,16 @@ int main() {
     std::cout << "  WASD        : Pan orbit center\n";
     std::cout << "  Q/E         : Move center up/down\n";
     std::cout << "  +/-         : Adjust bloom strength\n";
+    std::cout << "  G           : Toggle geodesic G-buffer cache\n";
+    std::cout << "  B           : Toggle bloom (dual filter / Gaussian)\n";
+    std::cout << "  R           : Toggle dynamic resolution (12 ms scene budget)\n";
+    std::cout << "  T           : Toggle frame-time overlay\n";
+    std::cout << "  P           : Toggle timing dump (stdout + frame_timing.csv)\n";
+    std::cout << "  1-4         : Shader quality (low / medium / high / ultra)\n";
     std::cout << "  ESC         : Quit\n\n";
 
     float time = 0.0f;
+    auto lastTitle = std::chrono::steady_clock::now();
 
     // 4. Main Render Loop
     while (!display.shouldClose()) {
@@ -79,8 +130,10 @@ int main() {
             display.isKeyPressed(GLFW_KEY_Q),
             display.isKeyPressed(GLFW_KEY_E)
         );
+        display.markInput();
 
         camera.update();
+        display.setCameraRevision(camera.revision);
 
         // --- Activate scene shader and set uniforms ---
         display.useSceneShader();
@@ -112,6 +165,19 @@ int main() {
         // --- Draw! Scene → Bloom → Composite → Screen ---
         display.draw();
 
+        // --- Frame-time percentiles in the title, twice a second ---
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastTitle > std::chrono::milliseconds(500)) {
+            lastTitle = now;
+            const FrameTelemetry& t = display.getTelemetry();
+            RollingHistogram::Summary frame = t.summary("cpu_frame"), gpu = t.summary("gpu_frame");
+            char title[160];
+            std::snprintf(title, sizeof(title),
+                          "Schwarzschild Black Hole — frame p50 %.1f / p95 %.1f / p99 %.1f ms, GPU p95 %.1f ms",
+                          frame.p50, frame.p95, frame.p99, gpu.p95);
+            glfwSetWindowTitle(win, title);
+        }
+
         time += 0.016f;
     }
 
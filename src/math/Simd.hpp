@@ -0,0 +1,294 @@
+/**
+ *  |+++++++++++++++++++++++++++|
+ *  |   SIMD Lane Packs         |
+ *  |===========================|
+ *  |  dpack / fpack = N lanes  |
+ *  |  that move through one    |
+ *  |  vector instruction.      |
+ *  |===========================|
+ */
+
+#pragma once
+
+#include <cmath>
+
+// Backend is picked at compile time from the target ISA:
+//   AVX-512F → 8 doubles / 16 floats
+//   AVX2     → 4 doubles / 8 floats
+//   otherwise a scalar fallback with the same lane counts as AVX2
+// Build with -march=native (BLACKHOLE_NATIVE_ARCH=ON) to enable the vector paths.
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace simd {
+
+#if defined(__AVX512F__)
+
+    inline constexpr const char* ISA = "AVX-512";
+
+    // --- 8 x double ---
+    struct dmask {
+        __mmask8 m;
+    };
+
+    struct dpack {
+        static constexpr int N = 8;
+        using mask = dmask;
+        __m512d v;
+
+        dpack() = default;
+        dpack(__m512d _v) : v(_v) {}
+        dpack(double s) : v(_mm512_set1_pd(s)) {}
+
+        static inline dpack load(const double* p) { return _mm512_loadu_pd(p); }
+        inline void store(double* p) const { _mm512_storeu_pd(p, v); }
+    };
+
+    inline dpack operator+(dpack a, dpack b) { return _mm512_add_pd(a.v, b.v); }
+    inline dpack operator-(dpack a, dpack b) { return _mm512_sub_pd(a.v, b.v); }
+    inline dpack operator*(dpack a, dpack b) { return _mm512_mul_pd(a.v, b.v); }
+    inline dpack operator/(dpack a, dpack b) { return _mm512_div_pd(a.v, b.v); }
+    inline dpack sqrt(dpack a) { return _mm512_sqrt_pd(a.v); }
+
+    inline dmask operator<(dpack a, dpack b)  { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ) }; }
+    inline dmask operator<=(dpack a, dpack b) { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ) }; }
+    inline dmask operator>(dpack a, dpack b)  { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ) }; }
+    inline dmask operator>=(dpack a, dpack b) { return { _mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ) }; }
+
+    inline dmask operator&(dmask a, dmask b) { return { static_cast<__mmask8>(a.m & b.m) }; }
+    inline dmask operator|(dmask a, dmask b) { return { static_cast<__mmask8>(a.m | b.m) }; }
+    inline dmask operator~(dmask a) { return { static_cast<__mmask8>(~a.m) }; }
+
+    inline int bits(dmask m) { return m.m; }
+    inline dmask maskFromBits(dmask, int b) { return { static_cast<__mmask8>(b) }; }
+
+    // m ? a : b, per lane
+    inline dpack select(dmask m, dpack a, dpack b) { return _mm512_mask_blend_pd(m.m, b.v, a.v); }
+
+    // --- 16 x float ---
+    struct fmask {
+        __mmask16 m;
+    };
+
+    struct fpack {
+        static constexpr int N = 16;
+        using mask = fmask;
+        __m512 v;
+
+        fpack() = default;
+        fpack(__m512 _v) : v(_v) {}
+        fpack(float s) : v(_mm512_set1_ps(s)) {}
+
+        static inline fpack load(const float* p) { return _mm512_loadu_ps(p); }
+        inline void store(float* p) const { _mm512_storeu_ps(p, v); }
+    };
+
+    inline fpack operator+(fpack a, fpack b) { return _mm512_add_ps(a.v, b.v); }
+    inline fpack operator-(fpack a, fpack b) { return _mm512_sub_ps(a.v, b.v); }
+    inline fpack operator*(fpack a, fpack b) { return _mm512_mul_ps(a.v, b.v); }
+    inline fpack operator/(fpack a, fpack b) { return _mm512_div_ps(a.v, b.v); }
+    inline fpack sqrt(fpack a) { return _mm512_sqrt_ps(a.v); }
+
+    inline fmask operator<(fpack a, fpack b)  { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ) }; }
+    inline fmask operator<=(fpack a, fpack b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ) }; }
+    inline fmask operator>(fpack a, fpack b)  { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ) }; }
+    inline fmask operator>=(fpack a, fpack b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ) }; }
+
+    inline fmask operator&(fmask a, fmask b) { return { static_cast<__mmask16>(a.m & b.m) }; }
+    inline fmask operator|(fmask a, fmask b) { return { static_cast<__mmask16>(a.m | b.m) }; }
+    inline fmask operator~(fmask a) { return { static_cast<__mmask16>(~a.m) }; }
+
+    inline int bits(fmask m) { return m.m; }
+    inline fmask maskFromBits(fmask, int b) { return { static_cast<__mmask16>(b) }; }
+
+    inline fpack select(fmask m, fpack a, fpack b) { return _mm512_mask_blend_ps(m.m, b.v, a.v); }
+
+#elif defined(__AVX2__)
+
+    inline constexpr const char* ISA = "AVX2";
+
+    // --- 4 x double ---
+    struct dmask {
+        __m256d m; // all-ones / all-zeros per lane
+    };
+
+    struct dpack {
+        static constexpr int N = 4;
+        using mask = dmask;
+        __m256d v;
+
+        dpack() = default;
+        dpack(__m256d _v) : v(_v) {}
+        dpack(double s) : v(_mm256_set1_pd(s)) {}
+
+        static inline dpack load(const double* p) { return _mm256_loadu_pd(p); }
+        inline void store(double* p) const { _mm256_storeu_pd(p, v); }
+    };
+
+    inline dpack operator+(dpack a, dpack b) { return _mm256_add_pd(a.v, b.v); }
+    inline dpack operator-(dpack a, dpack b) { return _mm256_sub_pd(a.v, b.v); }
+    inline dpack operator*(dpack a, dpack b) { return _mm256_mul_pd(a.v, b.v); }
+    inline dpack operator/(dpack a, dpack b) { return _mm256_div_pd(a.v, b.v); }
+    inline dpack sqrt(dpack a) { return _mm256_sqrt_pd(a.v); }
+
+    inline dmask operator<(dpack a, dpack b)  { return { _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; }
+    inline dmask operator<=(dpack a, dpack b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ) }; }
+    inline dmask operator>(dpack a, dpack b)  { return { _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ) }; }
+    inline dmask operator>=(dpack a, dpack b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ) }; }
+
+    inline dmask operator&(dmask a, dmask b) { return { _mm256_and_pd(a.m, b.m) }; }
+    inline dmask operator|(dmask a, dmask b) { return { _mm256_or_pd(a.m, b.m) }; }
+    inline dmask operator~(dmask a) {
+        return { _mm256_xor_pd(a.m, _mm256_castsi256_pd(_mm256_set1_epi64x(-1))) };
+    }
+
+    inline int bits(dmask m) { return _mm256_movemask_pd(m.m); }
+    inline dmask maskFromBits(dmask, int b) {
+        __m256i lanes = _mm256_set_epi64x(8, 4, 2, 1);
+        __m256i hit = _mm256_and_si256(_mm256_set1_epi64x(b), lanes);
+        return { _mm256_castsi256_pd(_mm256_cmpeq_epi64(hit, lanes)) };
+    }
+
+    inline dpack select(dmask m, dpack a, dpack b) { return _mm256_blendv_pd(b.v, a.v, m.m); }
+
+    // --- 8 x float ---
+    struct fmask {
+        __m256 m;
+    };
+
+    struct fpack {
+        static constexpr int N = 8;
+        using mask = fmask;
+        __m256 v;
+
+        fpack() = default;
+        fpack(__m256 _v) : v(_v) {}
+        fpack(float s) : v(_mm256_set1_ps(s)) {}
+
+        static inline fpack load(const float* p) { return _mm256_loadu_ps(p); }
+        inline void store(float* p) const { _mm256_storeu_ps(p, v); }
+    };
+
+    inline fpack operator+(fpack a, fpack b) { return _mm256_add_ps(a.v, b.v); }
+    inline fpack operator-(fpack a, fpack b) { return _mm256_sub_ps(a.v, b.v); }
+    inline fpack operator*(fpack a, fpack b) { return _mm256_mul_ps(a.v, b.v); }
+    inline fpack operator/(fpack a, fpack b) { return _mm256_div_ps(a.v, b.v); }
+    inline fpack sqrt(fpack a) { return _mm256_sqrt_ps(a.v); }
+
+    inline fmask operator<(fpack a, fpack b)  { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+    inline fmask operator<=(fpack a, fpack b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+    inline fmask operator>(fpack a, fpack b)  { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+    inline fmask operator>=(fpack a, fpack b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+
+    inline fmask operator&(fmask a, fmask b) { return { _mm256_and_ps(a.m, b.m) }; }
+    inline fmask operator|(fmask a, fmask b) { return { _mm256_or_ps(a.m, b.m) }; }
+    inline fmask operator~(fmask a) {
+        return { _mm256_xor_ps(a.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1))) };
+    }
+
+    inline int bits(fmask m) { return _mm256_movemask_ps(m.m); }
+    inline fmask maskFromBits(fmask, int b) {
+        __m256i lanes = _mm256_set_epi32(128, 64, 32, 16, 8, 4, 2, 1);
+        __m256i hit = _mm256_and_si256(_mm256_set1_epi32(b), lanes);
+        return { _mm256_castsi256_ps(_mm256_cmpeq_epi32(hit, lanes)) };
+    }
+
+    inline fpack select(fmask m, fpack a, fpack b) { return _mm256_blendv_ps(b.v, a.v, m.m); }
+
+#else
+
+    inline constexpr const char* ISA = "scalar";
+
+    // Scalar fallback: same interface, plain per-lane loops
+    template<int N>
+    struct smask {
+        int m; // one bit per lane
+    };
+
+    template<typename T, int Lanes>
+    struct spack {
+        static constexpr int N = Lanes;
+        using mask = smask<Lanes>;
+        T v[N];
+
+        spack() = default;
+        spack(T s) { for (int i = 0; i < N; i++) v[i] = s; }
+
+        static inline spack load(const T* p) {
+            spack r;
+            for (int i = 0; i < N; i++) r.v[i] = p[i];
+            return r;
+        }
+        inline void store(T* p) const { for (int i = 0; i < N; i++) p[i] = v[i]; }
+    };
+
+#define SIMD_SCALAR_BINOP(op) \
+    template<typename T, int N> \
+    inline spack<T, N> operator op(spack<T, N> a, spack<T, N> b) { \
+        spack<T, N> r; \
+        for (int i = 0; i < N; i++) r.v[i] = a.v[i] op b.v[i]; \
+        return r; \
+    }
+    SIMD_SCALAR_BINOP(+)
+    SIMD_SCALAR_BINOP(-)
+    SIMD_SCALAR_BINOP(*)
+    SIMD_SCALAR_BINOP(/)
+#undef SIMD_SCALAR_BINOP
+
+#define SIMD_SCALAR_CMP(op) \
+    template<typename T, int N> \
+    inline smask<N> operator op(spack<T, N> a, spack<T, N> b) { \
+        int m = 0; \
+        for (int i = 0; i < N; i++) m |= (a.v[i] op b.v[i]) ? (1 << i) : 0; \
+        return { m }; \
+    }
+    SIMD_SCALAR_CMP(<)
+    SIMD_SCALAR_CMP(<=)
+    SIMD_SCALAR_CMP(>)
+    SIMD_SCALAR_CMP(>=)
+#undef SIMD_SCALAR_CMP
+
+    template<typename T, int N>
+    inline spack<T, N> sqrt(spack<T, N> a) {
+        spack<T, N> r;
+        for (int i = 0; i < N; i++) r.v[i] = std::sqrt(a.v[i]);
+        return r;
+    }
+
+    template<int N> inline smask<N> operator&(smask<N> a, smask<N> b) { return { a.m & b.m }; }
+    template<int N> inline smask<N> operator|(smask<N> a, smask<N> b) { return { a.m | b.m }; }
+    template<int N> inline smask<N> operator~(smask<N> a) { return { ~a.m & ((1 << N) - 1) }; }
+
+    template<int N> inline int bits(smask<N> m) { return m.m; }
+    template<int N> inline smask<N> maskFromBits(smask<N>, int b) { return { b }; }
+
+    template<typename T, int N>
+    inline spack<T, N> select(smask<N> m, spack<T, N> a, spack<T, N> b) {
+        spack<T, N> r;
+        for (int i = 0; i < N; i++) r.v[i] = (m.m >> i & 1) ? a.v[i] : b.v[i];
+        return r;
+    }
+
+    using dpack = spack<double, 4>;
+    using fpack = spack<float, 8>;
+    using dmask = dpack::mask;
+    using fmask = fpack::mask;
+
+#endif
+
+    template<typename M>
+    inline bool any(M m) { return bits(m) != 0; }
+
+    // Mask for Pack with bit i of b set → lane i on
+    template<typename Pack>
+    inline typename Pack::mask lanes(int b) { return maskFromBits(typename Pack::mask{}, b); }
+
+    // Pack type for a scalar: pack_t<double> = dpack, pack_t<float> = fpack
+    template<typename T> struct pack_of;
+    template<> struct pack_of<double> { using type = dpack; };
+    template<> struct pack_of<float>  { using type = fpack; };
+
+    template<typename T>
+    using pack_t = typename pack_of<T>::type;
+}
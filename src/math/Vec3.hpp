@@ -12,58 +12,67 @@
 #include <iostream>
 #include <cmath>
 
-struct vec3{
+// Templated on the scalar type so the physics core can run in
+// float (what the GPU computes) or double (final-quality frames)
+template<typename T>
+struct tvec3{
 
     //parameters
-    double x,y,z;
+    T x,y,z;
 
     //Constructor    
-    vec3(double _x=0, double _y=0, double _z=0): x(_x), y(_y), z(_z) {}
+    tvec3(T _x=0, T _y=0, T _z=0): x(_x), y(_y), z(_z) {}
+
+    //Precision conversion (float <-> double) must be spelled out
+    template<typename U>
+    explicit tvec3(const tvec3<U>& o): x(static_cast<T>(o.x)), y(static_cast<T>(o.y)), z(static_cast<T>(o.z)) {}
 
     //Operator Overloading
-    inline vec3 operator+(const vec3& other) const{     //Addition
-        return vec3(x+other.x, y+other.y, z+other.z);
+    inline tvec3 operator+(const tvec3& other) const{   //Addition
+        return tvec3(x+other.x, y+other.y, z+other.z);
     }
 
-    inline vec3 operator-(const vec3& other) const{     //Subraction
-        return vec3(x-other.x, y-other.y, z-other.z);
+    inline tvec3 operator-(const tvec3& other) const{   //Subraction
+        return tvec3(x-other.x, y-other.y, z-other.z);
     }
     
     
-    inline vec3 operator*(double s) const{              //Scalar Multiplication
-        return vec3(x*s, y*s, z*s);
+    inline tvec3 operator*(T s) const{                  //Scalar Multiplication
+        return tvec3(x*s, y*s, z*s);
     }
 
-    inline vec3 operator/(double s) const{              //Division
+    inline tvec3 operator/(T s) const{                  //Division
         
-        double inv = 1.0/s;                             //div(10-40cc)>>>>>mul(2-3cc)
-        return vec3(x*inv, y*inv, z*inv);
+        T inv = T(1)/s;                                 //div(10-40cc)>>>>>mul(2-3cc)
+        return tvec3(x*inv, y*inv, z*inv);
     }
     
     //Essential Functions
 
-    inline double dot(const vec3& other)const{          //Dot Prod
+    inline T dot(const tvec3& other)const{              //Dot Prod
         return (x*other.x+y*other.y+z*other.z);
     }
  
-    inline vec3 cross(const vec3& other)const{          //Cross Prod
-        double res_x = (y*other.z)-(z*other.y);
-        double res_y = (z*other.x)-(x*other.z);
-        double res_z = (x*other.y)-(y*other.x);
+    inline tvec3 cross(const tvec3& other)const{        //Cross Prod
+        T res_x = (y*other.z)-(z*other.y);
+        T res_y = (z*other.x)-(x*other.z);
+        T res_z = (x*other.y)-(y*other.x);
 
-        return vec3(res_x,res_y,res_z);   
+        return tvec3(res_x,res_y,res_z);   
     }
 
-    inline double length()const{                        //Vector length
+    inline T length()const{                             //Vector length
         return(std::sqrt(x*x+y*y+z*z));
     }
 
-    inline vec3 normalize() const{
-        double l = 1/length();
-        return vec3(x*l,y*l,z*l);
+    inline tvec3 normalize() const{
+        T l = T(1)/length();
+        return tvec3(x*l,y*l,z*l);
     }
 };
 
+using vec3  = tvec3<double>;
+using fvec3 = tvec3<float>;
 
 
 
@@ -13,50 +13,58 @@
 #include <cmath>
 
 
-struct vec4 
+template<typename T>
+struct tvec4 
 {
-    double x,y,z,w;
+    T x,y,z,w;
 
-    vec4(double _x=0, double _y=0, double _z=0, double _w=1): x(_x), y(_y), z(_z), w(_w) {}
+    tvec4(T _x=0, T _y=0, T _z=0, T _w=1): x(_x), y(_y), z(_z), w(_w) {}
 
-    inline vec4 operator+(const vec4& other) const{
-        return vec4(x+other.x, y+other.y, z+other.z, w+other.w);
+    template<typename U>
+    explicit tvec4(const tvec4<U>& o)
+        : x(static_cast<T>(o.x)), y(static_cast<T>(o.y)), z(static_cast<T>(o.z)), w(static_cast<T>(o.w)) {}
+
+    inline tvec4 operator+(const tvec4& other) const{
+        return tvec4(x+other.x, y+other.y, z+other.z, w+other.w);
     }
 
-    inline vec4 operator-(const vec4& other) const{
-        return vec4(x-other.x, y-other.y, z-other.z, w-other.w);
+    inline tvec4 operator-(const tvec4& other) const{
+        return tvec4(x-other.x, y-other.y, z-other.z, w-other.w);
     }
 
-    inline vec4 operator*(double s) const{
-        return vec4(x*s, y*s, z*s, w*s);
+    inline tvec4 operator*(T s) const{
+        return tvec4(x*s, y*s, z*s, w*s);
     }
 
-    inline vec4 operator/(double s) const{
-        double inv = 1.0/s;
-        return vec4(x*inv, y*inv, z*inv, w*inv);
+    inline tvec4 operator/(T s) const{
+        T inv = T(1)/s;
+        return tvec4(x*inv, y*inv, z*inv, w*inv);
     }
 
-    inline vec4 normalize() const{
-        double l = 1.0/length();
-        return vec4(x*l, y*l, z*l, w*l);
+    inline tvec4 normalize() const{
+        T l = T(1)/length();
+        return tvec4(x*l, y*l, z*l, w*l);
     }
 
-    inline vec4 cross(const vec4& other) const{
-        double res_x = (y*other.z)-(z*other.y);
-        double res_y = (z*other.x)-(x*other.z);
-        double res_z = (x*other.y)-(y*other.x);
-        double res_w = 0; 
+    inline tvec4 cross(const tvec4& other) const{
+        T res_x = (y*other.z)-(z*other.y);
+        T res_y = (z*other.x)-(x*other.z);
+        T res_z = (x*other.y)-(y*other.x);
+        T res_w = 0; 
 
-        return vec4(res_x, res_y, res_z, res_w);
+        return tvec4(res_x, res_y, res_z, res_w);
     }
 
-    inline double dot(const vec4& other) const{
+    inline T dot(const tvec4& other) const{
         return (x*other.x + y*other.y + z*other.z + w*other.w);
     }
 
-    inline  double length() const{
+    inline  T length() const{
         return std::sqrt(x*x + y*y + z*z + w*w);
     }
 
 
-};
\ No newline at end of file
+};
+
+using vec4  = tvec4<double>;
+using fvec4 = tvec4<float>;
\ No newline at end of file
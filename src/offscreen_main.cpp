@@ -0,0 +1,193 @@
+// ============================================================
+//  Schwarzschild Black Hole — Offscreen GPU Renderer
+//  Runs the GLSL pipeline (scene → bloom → composite) on an EGL
+//  pbuffer context, so no window system is needed. Works on
+//  headless servers and under Mesa llvmpipe. Frames are read
+//  back through a ring of PBOs, so the copy of frame N overlaps
+//  the rendering of frame N+1.
+// ============================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "core/camera.hpp"
+#include "core/display.hpp"
+
+static void printUsage() {
+    std::cout << "Usage: BlackHoleOffscreen [options]\n"
+              << "  --width N       Frame width  (default 800)\n"
+              << "  --height N      Frame height (default 600)\n"
+              << "  --frames N      Frames to render (default 60)\n"
+              << "  --radius R      Camera orbit radius (default 15)\n"
+              << "  --pitch A       Camera pitch in radians (default 0.3)\n"
+              << "  --orbit A       Camera yaw advance per frame in radians (default 0.01)\n"
+              << "  --readback K    PBO ring depth; 0 reads every frame with a blocking\n"
+              << "                  glReadPixels instead (default 3)\n"
+              << "  --scale S       Fixed scene render scale per axis (default 1)\n"
+              << "  --dynamic-res MS  Scale the scene pass to hold MS of GPU time per frame\n"
+              << "  --timing-every S  Print per-pass timing percentiles every S seconds\n"
+              << "  --timing-csv PATH Append them to a CSV file (every S, default 1 s)\n"
+              << "  --overlay 0|1   Draw the frame-time graph into the frames (default 0)\n"
+              << "  --quality NAME  Shader preset: low, medium, high or ultra (default high)\n"
+              << "  --shaders DIR   Read shaders from DIR (default: the embedded copies,\n"
+              << "                  or ../src/shaders in builds without them)\n"
+              << "  --program-cache DIR  Linked program cache (default ~/.cache/schwarzschild-rtx;\n"
+              << "                  \"\" disables it)\n"
+              << "  --out PATTERN   Write frames as PNG through a pattern with one %d, e.g.\n"
+              << "                  gpu_%04d.png (default: read back only)\n";
+}
+
+// Same uniforms as the interactive loop in main.cpp
+static void setSceneUniforms(Display& display, const Camera& camera, float time) {
+    display.useSceneShader();
+    display.setUniform2f("uResolution", (float)display.getWidth(), (float)display.getHeight());
+    display.setUniform1f("uTime", time);
+    display.setUniform1f("uStepSize", 0.08f);
+    display.setUniform1f("uFovScale", camera.fov_scale);
+    display.setUniform3f("uCamPos", (float)camera.position.x, (float)camera.position.y, (float)camera.position.z);
+    display.setUniform3f("uCamForward", (float)camera.forward.x, (float)camera.forward.y, (float)camera.forward.z);
+    display.setUniform3f("uCamRight", (float)camera.right.x, (float)camera.right.y, (float)camera.right.z);
+    display.setUniform3f("uCamUp", (float)camera.up.x, (float)camera.up.y, (float)camera.up.z);
+}
+
+int main(int argc, char** argv) {
+    int width = 800, height = 600, frames = 60, depth = 3;
+    float radius = 15.0f, pitch = 0.3f, orbit = 0.01f, scale = 1.0f;
+    double dynamicMs = 0.0, timingEvery = 0.0;
+    bool overlay = false;
+    QualitySettings quality;
+    std::string shaderDir = ShaderLibrary::hasEmbedded() ? "" : "../src/shaders", outPattern, timingCsv;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+        const char* val = argv[++i];
+        if      (arg == "--width")    width = std::atoi(val);
+        else if (arg == "--height")   height = std::atoi(val);
+        else if (arg == "--frames")   frames = std::atoi(val);
+        else if (arg == "--radius")   radius = std::strtof(val, nullptr);
+        else if (arg == "--pitch")    pitch = std::strtof(val, nullptr);
+        else if (arg == "--orbit")    orbit = std::strtof(val, nullptr);
+        else if (arg == "--readback") depth = std::atoi(val);
+        else if (arg == "--scale")    scale = std::strtof(val, nullptr);
+        else if (arg == "--dynamic-res") dynamicMs = std::strtod(val, nullptr);
+        else if (arg == "--timing-every") timingEvery = std::strtod(val, nullptr);
+        else if (arg == "--timing-csv") timingCsv = val;
+        else if (arg == "--overlay")  overlay = std::atoi(val) != 0;
+        else if (arg == "--quality") {
+            if (!QualitySettings::fromName(val, quality)) {
+                std::cerr << "Unknown quality " << val << " (low, medium, high, ultra)\n";
+                return 1;
+            }
+        }
+        else if (arg == "--shaders")  shaderDir = val;
+        else if (arg == "--program-cache") Display::setProgramCacheDir(val);
+        else if (arg == "--out")      outPattern = val;
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (width <= 0 || height <= 0 || frames <= 0 || depth < 0 || scale <= 0.0f || dynamicMs < 0.0) {
+        std::cerr << "Width, height, frame count and scale must be positive, --readback and --dynamic-res non-negative\n";
+        return 1;
+    }
+    if (!outPattern.empty() && !validFramePattern(outPattern)) {
+        std::cerr << "--out needs exactly one %d (e.g. gpu_%04d.png), got " << outPattern << "\n";
+        return 1;
+    }
+
+    Display display(width, height, shaderDir, depth);
+    if (!display.isReady()) return 1;
+    Camera camera(radius, 0.0f, pitch);
+    if (dynamicMs > 0.0) {
+        ResolutionSettings rs;
+        rs.targetMs = dynamicMs;
+        display.setDynamicResolution(true, rs);
+    }
+    display.setRenderScale(scale);
+    display.setTimingOverlay(overlay);
+    display.setQuality(quality);
+    display.finishQuality();   // Every frame at the requested quality
+    if (timingEvery > 0.0 || !timingCsv.empty())
+        display.getTelemetry().setDump(timingEvery > 0.0 ? timingEvery : 1.0, timingCsv, timingEvery > 0.0);
+
+    long written = 0, failed = 0;
+    auto deliver = [&](const LdrImage& img, std::uint64_t frame) {
+        if (outPattern.empty()) return;
+        if (writePNG(framePath(outPattern, static_cast<int>(frame)), img)) written++;
+        else failed++;
+    };
+
+    std::cout << "Rendering " << frames << " frames at " << width << "x" << height << " offscreen ("
+              << (depth ? std::to_string(depth) + "-deep PBO ring" : std::string("blocking glReadPixels"))
+              << ", quality " << display.getQuality().tag() << ")...\n";
+
+    double readSeconds = 0.0;
+    float minScale = display.getRenderScale(), maxScale = minScale;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; f++) {
+        camera.yaw = f * orbit;
+        camera.update();
+        display.setCameraRevision(camera.revision);
+        display.markInput();
+        setSceneUniforms(display, camera, f * 0.016f);
+        display.draw();
+        minScale = std::min(minScale, display.getRenderScale());
+        maxScale = std::max(maxScale, display.getRenderScale());
+
+        auto r0 = std::chrono::steady_clock::now();
+        if (depth == 0) {
+            deliver(display.readFrameSync(), static_cast<std::uint64_t>(f));
+        } else {
+            LdrImage img;
+            std::uint64_t id;
+            while (display.takeFrame(img, &id)) deliver(img, id);
+        }
+        readSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - r0).count();
+    }
+
+    // Drain the frames still in flight
+    auto r0 = std::chrono::steady_clock::now();
+    LdrImage img;
+    std::uint64_t id;
+    while (display.takeFrame(img, &id, true)) deliver(img, id);
+    auto t1 = std::chrono::steady_clock::now();
+    readSeconds += std::chrono::duration<double>(t1 - r0).count();
+
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    const FrameReadback::Stats& st = display.getReadbackStats();
+    std::printf("Done in %.3f s (%.2f frames/s)\n", seconds, frames / seconds);
+    std::printf("  readback: %.2f ms/frame outside draw()", 1000.0 * readSeconds / frames);
+    if (depth) std::printf(", %llu ring-full waits (%.2f ms/frame)", static_cast<unsigned long long>(st.stalls),
+                           1000.0 * st.stallSeconds / frames);
+    std::printf("\n");
+    if (dynamicMs > 0.0) {
+        const ResolutionController& rc = display.getResolutionController();
+        std::printf("  dynamic resolution: scale %.3f-%.3f, final %.3f (%dx%d), %ld changes, scene pass %.2f ms smoothed\n",
+                    minScale, maxScale, display.getRenderScale(), display.getSceneWidth(), display.getSceneHeight(),
+                    rc.changes(), rc.smoothedMs());
+    }
+    std::cout << "Frame timing over the last " << std::min(frames, 240) << " frames:\n"
+              << display.getTelemetry().report();
+    if (!outPattern.empty()) {
+        std::cout << "Wrote " << written << " frames";
+        if (failed) std::cout << ", " << failed << " failed";
+        std::cout << "\n";
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "orbital_plane.hpp"
+#include "raytracer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// ============================================================
+//  Planar Binet-equation geodesic engine
+//  calculateAcceleration integrates -3 M h² r / r⁵ in 3D, with a
+//  cross product in every RK stage, even though h is conserved
+//  and every orbit is planar. Here the orbit is integrated as
+//      u'' + u = 3 M u²      (u = 1/r, ' = d/dφ)
+//  in its orbital plane: a 2D state instead of 6D and no cross
+//  products. Disk crossings sit at known angles φ0 + kπ, so the
+//  step is clipped to land on them exactly. 3D positions are only
+//  rebuilt at crossing and termination events.
+// ============================================================
+namespace Physics {
+
+    const double BINET_STEP = 0.02;        // Max dφ per step (radians)
+    const double BINET_MAX_DLNR = 0.05;    // Max relative change of r per step (near-radial rays)
+
+    // RK4 in φ at the hole's mass (kernel in photon_sphere.hpp)
+    inline void stepBinet(BinetState& s, double h) {
+        stepBinet(s, h, M);
+    }
+
+    // Unit direction of travel at (u, w, φ): d/dφ of r(φ)·(cos φ e1 + sin φ e2), scaled by u²
+    inline vec3 binetDirection(const OrbitalPlane& plane, const BinetState& s, double phi) {
+        return (plane.direction(phi) * -s.w + plane.direction(phi + 0.5 * M_PI) * s.u).normalize();
+    }
+
+    // Drop-in alternative to tracePhoton (same HitRecord contract). Disk hits
+    // are exact crossing points on y = 0; `dir` is always unit length.
+    inline HitRecord tracePhotonBinet(const Photon& p, TraceStats* stats = nullptr) {
+        const double r0 = p.pos.length();
+        if (r0 <= RS) return { HitTarget::BLACK_HOLE, p.pos, p.vel };
+        if (r0 > ESCAPE_RADIUS) return { HitTarget::BACKGROUND_SKY, p.pos, p.vel.normalize() };
+
+        OrbitalPlane plane = makeOrbitalPlane(p.pos, p.vel);
+        const double sinA = std::sin(plane.alpha), cosA = std::cos(plane.alpha);
+
+        // Radial rays have no orbital plane and never reach y = 0 outside the horizon
+        if (sinA < 1e-12) {
+            if (cosA > 0.0) return { HitTarget::BACKGROUND_SKY, plane.e1 * ESCAPE_RADIUS, plane.e1 };
+            return { HitTarget::BLACK_HOLE, plane.e1 * RS, plane.e1 * -1.0 };
+        }
+
+        // dr/dφ = r cot α at the camera  →  du/dφ = -u cot α
+        BinetState s{ 1.0 / r0, -(1.0 / r0) * cosA / sinA };
+        double phi = 0.0;
+        double nextCrossing = plane.firstDiskCrossing();
+        if (nextCrossing <= 0.0) nextCrossing = std::numeric_limits<double>::infinity();
+
+        while (true) {
+            // Capture condition (r <= RS)
+            if (s.u >= 1.0 / RS) {
+                return { HitTarget::BLACK_HOLE, plane.point(1.0 / s.u, phi), binetDirection(plane, s, phi) };
+            }
+
+            // Escape condition (r > ESCAPE_RADIUS); one Newton step back onto the
+            // sphere so the escape direction doesn't depend on the overshoot
+            if (s.u < 1.0 / ESCAPE_RADIUS) {
+                if (s.w < 0.0 && phi > 0.0) {
+                    double back = (1.0 / ESCAPE_RADIUS - s.u) / s.w;
+                    stepBinet(s, back);
+                    phi += back;
+                }
+                return { HitTarget::BACKGROUND_SKY, plane.point(1.0 / s.u, phi), binetDirection(plane, s, phi) };
+            }
+
+            // Bounded dφ, shorter where r changes fast per radian
+            double h = BINET_STEP;
+            if (s.w != 0.0) h = std::min(h, BINET_MAX_DLNR * s.u / std::abs(s.w));
+            bool landing = phi + h >= nextCrossing;
+            if (landing) h = nextCrossing - phi;
+
+            stepBinet(s, h);
+            phi = landing ? nextCrossing : phi + h;
+            if (stats) stats->steps++;
+
+            // Exactly on the disk plane: check the annulus
+            if (landing) {
+                if (stats) stats->crossings++;
+                double radius_on_disk = 1.0 / s.u;
+                if (radius_on_disk >= DISK_INNER && radius_on_disk <= DISK_OUTER && s.u > 0.0) {
+                    vec3 pos = plane.point(radius_on_disk, phi);
+                    pos.y = 0.0;
+                    return { HitTarget::ACCRETION_DISK, pos, binetDirection(plane, s, phi), radius_on_disk };
+                }
+                nextCrossing += M_PI;
+            }
+        }
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "orbital_plane.hpp"
+#include "raytracer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// ============================================================
+//  Symmetry-reduced geodesic table
+//  Schwarzschild is spherically symmetric: a ray leaving the
+//  camera is fixed (up to a rotation) by the camera radius r0
+//  and the angle α between the ray and the outward radial
+//  direction. So instead of integrating a 6D state per pixel we
+//  trace one 1D family of planar orbits per camera radius and
+//  store r(φ) along each. A pixel only has to:
+//    1. rotate into its orbital plane (e1 = radial, e2 ⟂ e1),
+//    2. solve y(φ) = 0 analytically: φ_k = φ0 + kπ,
+//    3. read r(φ_k) from the two neighbouring table orbits.
+//  Cost: O(table × steps + pixels) instead of O(pixels × steps),
+//  and the table is reusable while the camera radius is unchanged.
+// ============================================================
+namespace Physics {
+
+    class GeodesicTable {
+    public:
+        // One integrator step of a table orbit (float keeps a 2k-orbit table small)
+        struct Sample {
+            float phi;      // Polar angle in the orbital plane (unwrapped, increasing)
+            float r;        // Radius
+            float psi;      // Velocity angle in the plane (unwrapped)
+        };
+
+        struct Orbit {
+            HitTarget target = HitTarget::BACKGROUND_SKY;   // BLACK_HOLE or BACKGROUND_SKY
+            float endSpeed = 1.0f;                          // |vel| at termination
+            std::vector<Sample> samples;
+        };
+
+        // Resize for a new camera radius; orbits must be traced afterwards
+        void reset(double cameraRadius, int count) {
+            r0 = cameraRadius;
+            orbits.assign(static_cast<std::size_t>(std::max(count, 2)), Orbit{});
+        }
+
+        // Trace orbit i with the same RK4 step and termination rules as tracePhoton.
+        // Independent per index, so callers may run these in parallel.
+        void traceOrbit(int i) {
+            const double alpha = alphaOf(i);
+            Photon p{ vec3(r0, 0.0, 0.0), vec3(std::cos(alpha), std::sin(alpha), 0.0) };
+            Orbit& orbit = orbits[i];
+            orbit.samples.clear();
+
+            double phi = 0.0, psi = alpha;
+            while (true) {
+                double r = p.pos.length();
+                orbit.samples.push_back({ static_cast<float>(phi), static_cast<float>(r), static_cast<float>(psi) });
+
+                if (r <= RS || r > ESCAPE_RADIUS) {
+                    orbit.target = (r <= RS) ? HitTarget::BLACK_HOLE : HitTarget::BACKGROUND_SKY;
+                    orbit.endSpeed = static_cast<float>(p.vel.length());
+                    return;
+                }
+
+                vec3 oldPos = p.pos, oldVel = p.vel;
+                stepRK4(p, STEP_SIZE);
+
+                // Unwrap the angles by the (small) signed rotation this step
+                phi += std::atan2(oldPos.x * p.pos.y - oldPos.y * p.pos.x, oldPos.dot(p.pos));
+                psi += std::atan2(oldVel.x * p.vel.y - oldVel.y * p.vel.x, oldVel.dot(p.vel));
+            }
+        }
+
+        void build(double cameraRadius, int count) {
+            reset(cameraRadius, count);
+            for (int i = 0; i < size(); i++) traceOrbit(i);
+        }
+
+        double radius() const { return r0; }
+        int size() const { return static_cast<int>(orbits.size()); }
+        const Orbit& orbit(int i) const { return orbits[i]; }
+
+        // Table orbits are uniform in α over [0, π]
+        double alphaOf(int i) const { return M_PI * i / (size() - 1); }
+
+        // Resolve a ray from `origin` (|origin| == radius()) without integrating
+        HitRecord lookup(const vec3& origin, const vec3& dir) const {
+            OrbitalPlane plane = makeOrbitalPlane(origin, dir);
+            double phi0 = plane.firstDiskCrossing();
+
+            double f = plane.alpha / M_PI * (size() - 1);
+            int j = std::clamp(static_cast<int>(f), 0, size() - 2);
+            double w = f - j;
+
+            Event a = resolve(orbits[j], phi0);
+            Event b = resolve(orbits[j + 1], phi0);
+
+            // Blend the neighbours only when they agree on the outcome
+            // (and, for disk hits, on which crossing); otherwise snap
+            Event e = (w < 0.5) ? a : b;
+            if (a.target == b.target && a.phi == b.phi) {
+                e.r = a.r + (b.r - a.r) * w;
+                e.psi = a.psi + (b.psi - a.psi) * w;
+                e.speed = a.speed + (b.speed - a.speed) * w;
+            } else if (a.target == b.target && a.target != HitTarget::ACCRETION_DISK) {
+                e.phi = a.phi + (b.phi - a.phi) * w;
+                e.r = a.r + (b.r - a.r) * w;
+                e.psi = a.psi + (b.psi - a.psi) * w;
+                e.speed = a.speed + (b.speed - a.speed) * w;
+            }
+
+            vec3 pos = plane.point(e.r, e.phi);
+            vec3 vdir = plane.direction(e.psi);
+            switch (e.target) {
+                case HitTarget::ACCRETION_DISK:
+                    pos.y = 0.0;
+                    return { e.target, pos, vdir, e.r };
+                case HitTarget::BLACK_HOLE:
+                    return { e.target, pos, vdir * e.speed };
+                default:
+                    return { e.target, pos, vdir };
+            }
+        }
+
+    private:
+        struct Event {
+            HitTarget target;
+            double phi, r, psi, speed;
+        };
+
+        // Sample an orbit at polar angle phi (linear between integrator steps)
+        static void interpolate(const Orbit& orbit, double phi, double& r, double& psi) {
+            const auto& s = orbit.samples;
+            auto it = std::upper_bound(s.begin(), s.end(), phi,
+                                       [](double v, const Sample& x) { return v < x.phi; });
+            if (it == s.begin()) { r = s.front().r; psi = s.front().psi; return; }
+            if (it == s.end()) { r = s.back().r; psi = s.back().psi; return; }
+            const Sample& lo = *(it - 1);
+            const Sample& hi = *it;
+            double t = (hi.phi > lo.phi) ? (phi - lo.phi) / (hi.phi - lo.phi) : 0.0;
+            r = lo.r + (hi.r - lo.r) * t;
+            psi = lo.psi + (hi.psi - lo.psi) * t;
+        }
+
+        // Walk the analytic crossings φ0, φ0 + π, ... up to where the orbit ends
+        static Event resolve(const Orbit& orbit, double phi0) {
+            const Sample& end = orbit.samples.back();
+            if (phi0 > 0.0) {
+                for (double phi = phi0; phi <= end.phi; phi += M_PI) {
+                    double r, psi;
+                    interpolate(orbit, phi, r, psi);
+                    if (r >= DISK_INNER && r <= DISK_OUTER) {
+                        return { HitTarget::ACCRETION_DISK, phi, r, psi, 1.0 };
+                    }
+                }
+            }
+            return { orbit.target, end.phi, end.r, end.psi, orbit.endSpeed };
+        }
+
+        double r0 = 0.0;
+        std::vector<Orbit> orbits;
+    };
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../math/Vec3.hpp"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// ============================================================
+//  Orbital plane of a photon
+//  Schwarzschild geodesics are planar: a ray stays in the plane
+//  spanned by its radial vector and its velocity. Working in
+//  polar (r, φ) inside that plane makes the y = 0 disk crossings
+//  analytic: φ_k = φ0 + kπ, independent of the orbit shape.
+// ============================================================
+namespace Physics {
+
+    // Orbital plane of a ray from `origin` along `dir`; every Schwarzschild
+    // geodesic stays in the plane spanned by the radial vector and the velocity
+    struct OrbitalPlane {
+        vec3 e1;        // Unit radial direction of the origin (φ = 0)
+        vec3 e2;        // In-plane unit vector ⟂ e1, towards the ray (φ = π/2)
+        double alpha;   // Angle between the ray and e1, in [0, π]
+
+        inline vec3 point(double r, double phi) const {
+            return (e1 * std::cos(phi) + e2 * std::sin(phi)) * r;
+        }
+
+        // Unit vector at in-plane angle psi (velocity directions)
+        inline vec3 direction(double psi) const {
+            return e1 * std::cos(psi) + e2 * std::sin(psi);
+        }
+
+        // First φ > 0 where the orbit meets y = 0; later crossings follow
+        // every π. Negative when the orbital plane *is* the disk plane.
+        inline double firstDiskCrossing() const {
+            const double a = e1.y, b = e2.y;
+            if (std::abs(a) < 1e-12 && std::abs(b) < 1e-12) return -1.0;
+            // Crossings sit at atan2(−a, b) + kπ; atan2 returns ±π for a = ±0,
+            // so fold into [0, π) first. φ = 0 is the camera itself.
+            double phi0 = std::fmod(std::atan2(-a, b) + M_PI, M_PI);
+            if (phi0 <= 0.0) phi0 = M_PI;
+            return phi0;
+        }
+    };
+
+    inline OrbitalPlane makeOrbitalPlane(const vec3& origin, const vec3& dir) {
+        OrbitalPlane plane;
+        plane.e1 = origin.normalize();
+        vec3 d = dir.normalize();
+        double c = std::clamp(d.dot(plane.e1), -1.0, 1.0);
+        vec3 perp = d - plane.e1 * c;
+        double s = perp.length();
+        plane.alpha = std::atan2(s, c);
+
+        if (s > 1e-12) {
+            plane.e2 = perp / s;
+        } else {
+            // Radial ray: any plane through the radial line will do
+            vec3 helper = std::abs(plane.e1.y) < 0.9 ? vec3(0, 1, 0) : vec3(1, 0, 0);
+            plane.e2 = (helper - plane.e1 * helper.dot(plane.e1)).normalize();
+        }
+        return plane;
+    }
+}
@@ -1,7 +1,12 @@
 #pragma once
 
 #include "../math/Vec3.hpp"
+#include "capture.hpp"
+#include "far_field.hpp"
+#include "orbital_plane.hpp"
+#include "photon_sphere.hpp"
 #include <cmath>
+#include <type_traits>
 
 namespace Physics {
     
@@ -17,10 +22,22 @@ namespace Physics {
     const double DISK_INNER = 2.6; // Just outside the event horizon
     const double DISK_OUTER = 12.0;
 
+    // Largest 1/b² whose periapsis stays outside DISK_OUTER: u² − 2Mu³ at u = 1/DISK_OUTER
+    const double FAR_FIELD_BARRIER = (1.0 - 2.0 * M / DISK_OUTER) / (DISK_OUTER * DISK_OUTER);
+
+    // 1/b² of the critical orbit, b = 3√3 M: anything above it plunges
+    const double CAPTURE_BARRIER = 1.0 / (27.0 * M * M);
+
+    // Winding steps (photon_sphere.hpp) only inside 1.2× the photon sphere radius
+    const double PHOTON_BAND = 1.2 * 3.0 * M;
+
     // A simple struct to hold our photon's state
-    struct Photon {
-        vec3 pos;
-        vec3 vel;
+    // Templated on the scalar type: float mirrors the GLSL path (and doubles
+    // the SIMD width), double is the reference for final-quality frames.
+    template<typename T>
+    struct BasicPhoton {
+        tvec3<T> pos;
+        tvec3<T> vel;
     };
 
     enum class HitTarget {
@@ -29,78 +46,236 @@ namespace Physics {
         ACCRETION_DISK
     };
 
-    struct HitRecord {
+    template<typename T>
+    struct BasicHitRecord {
         HitTarget target;
-        // We can add color or temperature data here later!
+        tvec3<T> pos;       // Photon position at termination (disk crossing point for disk hits)
+        tvec3<T> dir;       // Photon direction at termination (escape direction for sky hits)
+        T diskR = 0;        // Radius on the disk plane (disk hits only)
+    };
+
+    // Default precision is double; Basic*<float> is the GPU-matching preview path
+    using Photon = BasicPhoton<double>;
+    using HitRecord = BasicHitRecord<double>;
+
+    // Optional per-ray work counters (all scalar tracers)
+    struct TraceStats {
+        long steps = 0;          // Accepted integrator steps
+        long rejected = 0;       // Steps thrown away by error control (adaptive only)
+        long crossings = 0;      // y = 0 plane crossings, including a terminating disk hit
+        bool exhausted = false;  // Gave up on the step budget (adaptive maxSteps)
     };
 
+    // Widen a (possibly float) hit record to the double shading path
+    template<typename T>
+    inline HitRecord toDouble(const BasicHitRecord<T>& h) {
+        return { h.target, vec3(h.pos), vec3(h.dir), static_cast<double>(h.diskR) };
+    }
+
     // Module 03: The Schwarzschild Acceleration
-    inline vec3 calculateAcceleration(const vec3& pos, const vec3& vel) {
-        double r2 = pos.dot(pos); 
-        double r = std::sqrt(r2);
-        vec3 h_vec = pos.cross(vel);
-        double h2 = h_vec.dot(h_vec);
-        double r5 = r2 * r2 * r;
+    template<typename T>
+    inline tvec3<T> calculateAcceleration(const tvec3<T>& pos, const tvec3<T>& vel) {
+        T r2 = pos.dot(pos); 
+        T r = std::sqrt(r2);
+        tvec3<T> h_vec = pos.cross(vel);
+        T h2 = h_vec.dot(h_vec);
+        T r5 = r2 * r2 * r;
         
-        return pos * (-3.0 * M * h2 / r5);
+        return pos * (T(-3.0 * M) * h2 / r5);
     }
 
     // Module 04: The RK4 Integrator
-    inline void stepRK4(Photon& p, double dt) {
+    template<typename T>
+    inline void stepRK4(BasicPhoton<T>& p, std::type_identity_t<T> dt) {
+        const T half = dt * T(0.5);
+
         // Sample 1 (Start)
-        vec3 k1_vel = calculateAcceleration(p.pos, p.vel);
-        vec3 k1_pos = p.vel;
+        tvec3<T> k1_vel = calculateAcceleration(p.pos, p.vel);
+        tvec3<T> k1_pos = p.vel;
 
         // Sample 2 (Midpoint using k1)
-        vec3 k2_vel = calculateAcceleration(p.pos + k1_pos * (dt * 0.5), p.vel + k1_vel * (dt * 0.5));
-        vec3 k2_pos = p.vel + k1_vel * (dt * 0.5);
+        tvec3<T> k2_vel = calculateAcceleration(p.pos + k1_pos * half, p.vel + k1_vel * half);
+        tvec3<T> k2_pos = p.vel + k1_vel * half;
 
         // Sample 3 (Midpoint using k2)
-        vec3 k3_vel = calculateAcceleration(p.pos + k2_pos * (dt * 0.5), p.vel + k2_vel * (dt * 0.5));
-        vec3 k3_pos = p.vel + k2_vel * (dt * 0.5);
+        tvec3<T> k3_vel = calculateAcceleration(p.pos + k2_pos * half, p.vel + k2_vel * half);
+        tvec3<T> k3_pos = p.vel + k2_vel * half;
 
         // Sample 4 (Endpoint using k3)
-        vec3 k4_vel = calculateAcceleration(p.pos + k3_pos * dt, p.vel + k3_vel * dt);
-        vec3 k4_pos = p.vel + k3_vel * dt;
+        tvec3<T> k4_vel = calculateAcceleration(p.pos + k3_pos * dt, p.vel + k3_vel * dt);
+        tvec3<T> k4_pos = p.vel + k3_vel * dt;
 
         // Combine the samples and take the actual step
-        p.vel = p.vel + (k1_vel + k2_vel * 2.0 + k3_vel * 2.0 + k4_vel) * (dt / 6.0);
-        p.pos = p.pos + (k1_pos + k2_pos * 2.0 + k3_pos * 2.0 + k4_pos) * (dt / 6.0);
+        p.vel = p.vel + (k1_vel + k2_vel * T(2) + k3_vel * T(2) + k4_vel) * (dt / T(6));
+        p.pos = p.pos + (k1_pos + k2_pos * T(2) + k3_pos * T(2) + k4_pos) * (dt / T(6));
+    }
+
+    // Module 05: The Far-Field Exit
+    // Past DISK_OUTER, a photon that is outbound, or inbound with its periapsis
+    // beyond DISK_OUTER, can neither hit the disk nor fall in: only its
+    // direction on the escape sphere is left to find.
+    template<typename T>
+    inline bool inFarField(const BasicPhoton<T>& p, T r) {
+        if (r <= T(DISK_OUTER)) return false;
+        if (p.pos.dot(p.vel) >= T(0)) return true;
+
+        // 1/b² = |v|² / |r × v|² − 2M/r³ below the barrier
+        T u = T(1) / r;
+        tvec3<T> h = p.pos.cross(p.vel);
+        return p.vel.dot(p.vel) < (T(FAR_FIELD_BARRIER) + T(2.0 * M) * u * u * u) * h.dot(h);
+    }
+
+    // Sky hit on the escape sphere for a far-field photon, by farFieldSweep
+    // instead of RK4 steps (in double for either T: it runs once per ray).
+    // Photons already past ESCAPE_RADIUS keep their state.
+    template<typename T>
+    inline BasicHitRecord<T> farFieldExit(const BasicPhoton<T>& p) {
+        const vec3 pos(p.pos), vel(p.vel);
+        const double r = pos.length();
+        if (r >= ESCAPE_RADIUS) return { HitTarget::BACKGROUND_SKY, p.pos, p.vel.normalize() };
+
+        OrbitalPlane plane = makeOrbitalPlane(pos, vel);
+        const double h = pos.cross(vel).length();
+        if (h <= 1e-12 * r * vel.length()) {
+            // Radial: straight out along e1
+            return { HitTarget::BACKGROUND_SKY, tvec3<T>(plane.e1 * ESCAPE_RADIUS), tvec3<T>(plane.e1) };
+        }
+
+        // dr/dφ = r cot α  →  w = −u (r · v) / |r × v|
+        const double u = 1.0 / r;
+        const double uEnd = 1.0 / ESCAPE_RADIUS;
+        FarFieldSweep sweep = farFieldSweep(u, -u * pos.dot(vel) / h, uEnd, M);
+        vec3 dir = (plane.direction(sweep.phi) * -sweep.w + plane.direction(sweep.phi + 0.5 * M_PI) * uEnd).normalize();
+        return { HitTarget::BACKGROUND_SKY, tvec3<T>(plane.point(ESCAPE_RADIUS, sweep.phi)), tvec3<T>(dir) };
+    }
+
+    // Module 06: Early Capture
+    // Outside the photon sphere an inbound photon with b < 3√3 M falls
+    // straight in. On the way it meets y = 0 every π of orbit angle, from
+    // firstDiskCrossing() on; once that next crossing lies beyond the angle
+    // at which it drops inside DISK_INNER (plungeSweep), nothing is left
+    // for it to hit and it counts as captured. (Only inside the escape
+    // sphere: beyond it the tracers do not integrate at all.)
+    template<typename T>
+    inline bool plungesPastDisk(const BasicPhoton<T>& p, T r) {
+        if (r <= T(3.0 * M) || r > T(ESCAPE_RADIUS) || p.pos.dot(p.vel) >= T(0)) return false;
+
+        // 1/b² = |v|² / |r × v|² − 2M/r³ above the barrier
+        T u = T(1) / r;
+        tvec3<T> h = p.pos.cross(p.vel);
+        if (!(p.vel.dot(p.vel) > (T(CAPTURE_BARRIER) + T(2.0 * M) * u * u * u) * h.dot(h))) return false;
+
+        const vec3 pos(p.pos), vel(p.vel);
+        const double hd = pos.cross(vel).length();
+        const double next = makeOrbitalPlane(pos, vel).firstDiskCrossing();
+        if (hd <= 1e-12 * pos.length() * vel.length() || next < 0.0) return true;   // Radial, or no crossings ever
+
+        const double ud = 1.0 / pos.length();
+        const double A = vel.dot(vel) / (hd * hd) - 2.0 * M * ud * ud * ud;
+        return next >= plungeSweep(A, ud, 1.0 / DISK_INNER, M);
+    }
+
+    // Module 07: Winding Around the Photon Sphere
+    // Inside PHOTON_BAND a near-circular photon (|cot α| < WIND_SLOPE) is
+    // winding around r = 3M. It advances by one Binet RK4 step in orbit
+    // angle instead, clipped to land exactly on its next y = 0 crossing;
+    // once it leaves the band or turns steep, RK4 takes over again.
+    template<typename T>
+    inline bool nearPhotonSphere(const BasicPhoton<T>& p, T r) {
+        if (r >= T(PHOTON_BAND)) return false;
+        T radial = p.pos.dot(p.vel);
+        tvec3<T> h = p.pos.cross(p.vel);
+        return radial * radial < T(WIND_SLOPE * WIND_SLOPE) * h.dot(h);
+    }
+
+    // One winding step of at most WIND_STEP radians (in double for either T).
+    // A step that ends on the disk plane sets y to exactly 0, so the caller's
+    // sign test registers the crossing once and the next step starts from it.
+    template<typename T>
+    inline void windStep(BasicPhoton<T>& p) {
+        const vec3 pos(p.pos), vel(p.vel);
+        const double r = pos.length();
+        const vec3 h = pos.cross(vel);
+        const double L = h.length();
+        const vec3 e1 = pos / r;
+        const vec3 e2 = h.cross(e1) / L;
+
+        // Crossings sit at atan2(−e1.y, e2.y) + kπ: the next one is the
+        // smallest in (0, π], π when starting on the plane; none in the
+        // disk plane itself
+        double next = WIND_STEP + 1.0;
+        if (std::abs(e1.y) >= 1e-12 || std::abs(e2.y) >= 1e-12) {
+            next = std::fmod(std::atan2(-e1.y, e2.y) + M_PI, M_PI);
+            if (next <= 0.0) next = M_PI;
+        }
+        const bool landing = next <= WIND_STEP;
+        const double dphi = landing ? next : WIND_STEP;
+
+        // dr/dφ = r cot α  →  w = −u (r · v) / |r × v|; |r × v| is conserved
+        const double u = 1.0 / r;
+        BinetState s{ u, -u * pos.dot(vel) / L };
+        windBinet(s, dphi, M);
+
+        const vec3 radial = e1 * std::cos(dphi) + e2 * std::sin(dphi);
+        const vec3 along = e2 * std::cos(dphi) - e1 * std::sin(dphi);
+        vec3 npos = radial / s.u;
+        if (landing) npos.y = 0.0;
+        p.pos = tvec3<T>(npos);
+        p.vel = tvec3<T>((radial * -s.w + along * s.u) * L);
     }
 
     // The Main Raytracing Loop (Returns true if it hit the black hole, false if it escaped)
-    inline HitRecord tracePhoton(Photon p) {
-        
+    template<typename T>
+    inline BasicHitRecord<T> tracePhoton(BasicPhoton<T> p, TraceStats* stats = nullptr) {
+        const T rs = T(RS);
+        const T escape = T(ESCAPE_RADIUS);
+        const T step = T(STEP_SIZE);
+        const T inner = T(DISK_INNER);
+        const T outer = T(DISK_OUTER);
+
+        // In the shadow and never crossing the disk: nothing to integrate
+        if (plungesPastDisk(p, p.pos.length())) {
+            return { HitTarget::BLACK_HOLE, p.pos, p.vel };
+        }
+
         // Loop until it crashes or escapes
         while (true) {
             // SAVE THIS BEFORE THE STEP!
-            double old_y = p.pos.y; 
+            T old_y = p.pos.y; 
 
-            double r = p.pos.length();
+            T r = p.pos.length();
 
             // Capture condition
-            if (r <= RS) {
-                return { HitTarget::BLACK_HOLE }; // Fixed return
+            if (r <= rs) {
+                return { HitTarget::BLACK_HOLE, p.pos, p.vel }; // Fixed return
             }
 
-            // Escape condition
-            if (r > ESCAPE_RADIUS) {
-                return { HitTarget::BACKGROUND_SKY }; // Fixed return
+            // Escape condition: past the escape sphere, or already bound for it
+            if (r > escape || inFarField(p, r)) {
+                return farFieldExit(p);
             }
 
-            // Move the photon forward one tick
-            stepRK4(p, STEP_SIZE);
+            // Move the photon forward one tick (one winding step near r = 3M)
+            if (nearPhotonSphere(p, r)) windStep(p);
+            else stepRK4(p, step);
+            if (stats) stats->steps++;
         
-            double new_y = p.pos.y;
+            T new_y = p.pos.y;
             
             // Did we cross the Y=0 plane?
-            if ((old_y > 0.0 && new_y <= 0.0) || (old_y < 0.0 && new_y >= 0.0)) {
-                
+            if ((old_y > T(0) && new_y <= T(0)) || (old_y < T(0) && new_y >= T(0))) {
+                if (stats) stats->crossings++;
+
                 // We crossed the plane! Now check if we are within the disk's rings.
-                double radius_on_disk = std::sqrt(p.pos.x * p.pos.x + p.pos.z * p.pos.z);
+                T radius_on_disk = std::sqrt(p.pos.x * p.pos.x + p.pos.z * p.pos.z);
                     
-                if (radius_on_disk >= DISK_INNER && radius_on_disk <= DISK_OUTER) {
-                    return { HitTarget::ACCRETION_DISK };
+                if (radius_on_disk >= inner && radius_on_disk <= outer) {
+                    return { HitTarget::ACCRETION_DISK, p.pos, p.vel.normalize(), radius_on_disk };
+                }
+
+                // That was the last crossing before it falls in
+                if (plungesPastDisk(p, p.pos.length())) {
+                    return { HitTarget::BLACK_HOLE, p.pos, p.vel };
                 }
             }
         }
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "photon_batch.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+//  Wavefront photon scheduler
+//  traceLanes runs a pack until its slowest lane finishes: sky
+//  rays escape after a few hundred steps while a near-critical
+//  neighbour orbits for thousands, and the finished lanes idle.
+//  Here a pool of live photons (SoA) advances K RK4 steps per
+//  wave. After each wave, terminated photons are compacted out
+//  and the pool is refilled from a photon source, so the packs
+//  stay full until the source runs dry. The per-step arithmetic
+//  is advanceLanes, so results match traceBatch exactly.
+// ============================================================
+namespace Physics {
+
+    struct WavefrontSettings {
+        int stepsPerWave = 16;   // RK4 steps between compactions (< 1: run packs to completion)
+        int slots = 256;         // Live photons kept in flight (rounded up to whole packs)
+    };
+
+    struct WavefrontStats {
+        long rays = 0;        // Photons pulled from the source
+        long waves = 0;
+        long packSteps = 0;   // RK4 pack steps executed (lanes × packSteps lane slots)
+        long laneSteps = 0;   // ... of which carried a live photon
+        int lanes = 0;        // Pack width
+
+        // Fraction of lane slots doing useful work
+        double utilization() const {
+            return packSteps ? static_cast<double>(laneSteps) / (static_cast<double>(packSteps) * lanes) : 0.0;
+        }
+
+        void merge(const WavefrontStats& o) {
+            rays += o.rays;
+            waves += o.waves;
+            packSteps += o.packSteps;
+            laneSteps += o.laneSteps;
+            lanes = o.lanes;
+        }
+    };
+
+    template<typename T>
+    class BasicWavefront {
+    public:
+        using Pack = simd::pack_t<T>;
+        static constexpr int N = Pack::N;
+
+        explicit BasicWavefront(const WavefrontSettings& settings = {}) : settings(settings) {
+            std::size_t packs = (static_cast<std::size_t>(std::max(settings.slots, 1)) + N - 1) / N;
+            capacity = packs * N;
+        }
+
+        // Pull photons with next(photon, id) -> bool until it returns false, and hand
+        // every result to finish(id, hit) exactly once (in termination order)
+        template<typename Source, typename Sink>
+        WavefrontStats run(Source&& next, Sink&& finish) {
+            WavefrontStats stats;
+            stats.lanes = N;
+            live.clear();
+            ids.clear();
+            bool more = true;
+
+            while (true) {
+                // Refill the free slots from the source
+                while (more && live.size() < capacity) {
+                    BasicPhoton<T> p;
+                    std::size_t id;
+                    if (!next(p, id)) {
+                        more = false;
+                        break;
+                    }
+                    stats.rays++;
+                    // Shadow rays that never cross the disk take no steps (plungesPastDisk)
+                    if (plungesPastDisk(p, p.pos.length())) {
+                        finish(id, BasicHitRecord<T>{ HitTarget::BLACK_HOLE, p.pos, p.vel });
+                        continue;
+                    }
+                    live.push(p);
+                    ids.push_back(id);
+                }
+                if (live.size() == 0) break;
+
+                stats.waves++;
+                done.assign(live.size(), 0);
+                for (std::size_t first = 0; first < live.size(); first += N)
+                    stats.packSteps += advancePack(first, finish, stats.laneSteps);
+                compact();
+            }
+            return stats;
+        }
+
+    private:
+        // Load lanes [first, first + N), advance them one wave, store the survivors back
+        template<typename Sink>
+        long advancePack(std::size_t first, Sink& finish, long& laneSteps) {
+            using Mask = typename Pack::mask;
+            alignas(64) T lx[N], ly[N], lz[N], lvx[N], lvy[N], lvz[N];
+
+            // Pad a short final pack with an escaping dummy photon (masked off)
+            int valid = 0;
+            for (int l = 0; l < N; l++) {
+                std::size_t i = first + l;
+                if (i < live.size()) {
+                    lx[l] = live.x[i];   ly[l] = live.y[i];   lz[l] = live.z[i];
+                    lvx[l] = live.vx[i]; lvy[l] = live.vy[i]; lvz[l] = live.vz[i];
+                    valid |= 1 << l;
+                } else {
+                    lx[l] = T(2.0 * ESCAPE_RADIUS); ly[l] = 0; lz[l] = 0;
+                    lvx[l] = 1; lvy[l] = 0; lvz[l] = 0;
+                }
+            }
+
+            vec3pack<Pack> pos{ Pack::load(lx),  Pack::load(ly),  Pack::load(lz) };
+            vec3pack<Pack> vel{ Pack::load(lvx), Pack::load(lvy), Pack::load(lvz) };
+            Mask active = simd::lanes<Pack>(valid);
+
+            // Same HitRecord layout as traceLanes
+            auto retire = [&](Mask m, HitTarget target, const Pack* diskR) {
+                int b = simd::bits(m);
+                if (!b) return;
+                pos.x.store(lx);  pos.y.store(ly);  pos.z.store(lz);
+                vel.x.store(lvx); vel.y.store(lvy); vel.z.store(lvz);
+                alignas(64) T ldr[N] = {};
+                if (diskR) diskR->store(ldr);
+                for (int l = 0; l < N; l++) {
+                    if (!(b >> l & 1)) continue;
+                    BasicHitRecord<T> hit;
+                    hit.target = target;
+                    hit.pos = tvec3<T>(lx[l], ly[l], lz[l]);
+                    tvec3<T> v(lvx[l], lvy[l], lvz[l]);
+                    hit.dir = (target == HitTarget::BLACK_HOLE) ? v : v.normalize();
+                    hit.diskR = ldr[l];
+                    if (target == HitTarget::BACKGROUND_SKY) hit = farFieldExit(BasicPhoton<T>{ hit.pos, v });
+                    done[first + l] = 1;
+                    finish(ids[first + l], hit);
+                }
+            };
+
+            long limit = settings.stepsPerWave > 0 ? settings.stepsPerWave : -1;
+            long steps = advanceLanes<T>(pos, vel, active, limit, retire, &laneSteps);
+
+            pos.x.store(lx);  pos.y.store(ly);  pos.z.store(lz);
+            vel.x.store(lvx); vel.y.store(lvy); vel.z.store(lvz);
+            for (int l = 0; l < N && first + l < live.size(); l++) {
+                std::size_t i = first + l;
+                live.x[i] = lx[l];   live.y[i] = ly[l];   live.z[i] = lz[l];
+                live.vx[i] = lvx[l]; live.vy[i] = lvy[l]; live.vz[i] = lvz[l];
+            }
+            return steps;
+        }
+
+        // Drop terminated photons, keeping the survivors in order
+        // (neighbouring pixels stay in the same pack)
+        void compact() {
+            std::size_t w = 0;
+            for (std::size_t i = 0; i < live.size(); i++) {
+                if (done[i]) continue;
+                live.x[w] = live.x[i];   live.y[w] = live.y[i];   live.z[w] = live.z[i];
+                live.vx[w] = live.vx[i]; live.vy[w] = live.vy[i]; live.vz[w] = live.vz[i];
+                ids[w] = ids[i];
+                w++;
+            }
+            live.x.resize(w);  live.y.resize(w);  live.z.resize(w);
+            live.vx.resize(w); live.vy.resize(w); live.vz.resize(w);
+            ids.resize(w);
+        }
+
+        WavefrontSettings settings;
+        std::size_t capacity = 0;
+        BasicPhotonBatch<T> live;
+        std::vector<std::size_t> ids;
+        std::vector<std::uint8_t> done;
+    };
+
+    using Wavefront = BasicWavefront<double>;
+
+    // Wavefront equivalent of traceBatch
+    template<typename T>
+    inline std::vector<BasicHitRecord<T>> traceWavefront(const BasicPhotonBatch<T>& batch,
+                                                         const WavefrontSettings& settings = {},
+                                                         WavefrontStats* stats = nullptr) {
+        std::vector<BasicHitRecord<T>> hits(batch.size());
+        std::size_t cursor = 0;
+        BasicWavefront<T> wavefront(settings);
+        WavefrontStats st = wavefront.run(
+            [&](BasicPhoton<T>& p, std::size_t& id) {
+                if (cursor == batch.size()) return false;
+                id = cursor;
+                p = batch.photon(cursor++);
+                return true;
+            },
+            [&](std::size_t id, const BasicHitRecord<T>& hit) { hits[id] = hit; });
+        if (stats) *stats = st;
+        return hits;
+    }
+}
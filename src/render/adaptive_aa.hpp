@@ -0,0 +1,173 @@
+#pragma once
+
+#include "cpu_renderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// ============================================================
+//  Adaptive supersampling focused on the photon ring
+//  One primary geodesic per pixel (renderFrame with a G-buffer),
+//  then extra stratified sub-pixel geodesics only where
+//  neighbouring primary rays diverge:
+//    outcome  (HitTarget differs: shadow edge, ring, disk edge)
+//             → edgeSamples
+//    radius / colour (same target, diskR or shaded colour jumps:
+//             particle disk, thin ring layers) → smoothSamples
+//  An optional frame budget caps the extra rays; pixels with the
+//  strongest divergence are served first.
+// ============================================================
+namespace Render {
+
+    struct AASettings {
+        int edgeSamples = 16;           // Sub-pixel geodesics where outcomes differ (rounded to k²)
+        int smoothSamples = 4;          // ... where only disk radius or colour differ
+        double radiusThreshold = 0.02;  // Relative diskR difference between neighbours
+        float colorThreshold = 0.08f;   // Difference of x / (1 + x) in any channel
+        double rayBudget = 0.0;         // Max extra rays per pixel, frame average (0 = unlimited)
+        int uniformSamples = 0;         // > 0: plain SSAA, every pixel gets this many (reference)
+    };
+
+    struct AAStats {
+        long pixels = 0;
+        long primaryRays = 0;
+        long extraRays = 0;
+        long edgePixels = 0;       // Supersampled because outcomes differ
+        long smoothPixels = 0;     // Supersampled because radius / colour differ
+        long budgetDowngrades = 0; // Candidates that got fewer samples than asked (budget)
+
+        double raysPerPixel() const { return pixels ? double(primaryRays + extraRays) / pixels : 0.0; }
+        // Cost relative to uniform n× SSAA (n rays per pixel)
+        double costVsUniform(int n) const { return raysPerPixel() / n; }
+    };
+
+    namespace AA {
+        inline int gridSide(int samples) {
+            return std::max(1, static_cast<int>(std::lround(std::sqrt(std::max(samples, 1)))));
+        }
+
+        inline float compress(float x) {
+            x = std::max(x, 0.0f);
+            return x / (1.0f + x);
+        }
+
+        struct Candidate {
+            int x, y;
+            int samples;      // Requested, k² grid
+            float score;      // Outcome divergence ranks above radius / colour divergence
+        };
+    }
+
+    inline Image renderFrameAA(const Camera& camera, const RenderSettings& settings, ThreadPool& pool,
+                               const AASettings& aa = {}, AAStats* stats = nullptr, FrameCache* cache = nullptr) {
+        using AA::Candidate;
+        const int W = settings.width, H = settings.height;
+
+        AAStats st;
+        st.pixels = static_cast<long>(W) * H;
+
+        // Primary rays (or a reshade when the caller's G-buffer still matches).
+        // Uniform SSAA replaces every centre sample, so it skips them.
+        const bool uniform = aa.uniformSamples > 0 && AA::gridSide(aa.uniformSamples) > 1;
+        FrameCache local;
+        FrameCache& fc = cache ? *cache : local;
+        Image image(W, H);
+        if (!uniform) {
+            const long tracesBefore = fc.gbuffer.traces;
+            image = renderFrame(camera, settings, pool, &fc);
+            st.primaryRays = fc.gbuffer.traces > tracesBefore ? st.pixels : 0;
+        }
+        const std::vector<Physics::HitRecord>& hits = fc.gbuffer.hits;
+
+        // Classify each pixel against its 4-neighbourhood
+        std::vector<Candidate> candidates;
+        if (uniform) {
+            for (int y = 0; y < H; y++)
+                for (int x = 0; x < W; x++) candidates.push_back({ x, y, aa.uniformSamples, 0.0f });
+        } else if (aa.uniformSamples <= 0) {
+            std::vector<std::vector<Candidate>> rows(static_cast<std::size_t>(H));
+            pool.parallelFor(static_cast<std::size_t>(H), [&](std::size_t row, unsigned) {
+                const int y = static_cast<int>(row);
+                for (int x = 0; x < W; x++) {
+                    const Physics::HitRecord& h = hits[static_cast<std::size_t>(y) * W + x];
+                    const float* c = image.at(x, y);
+                    bool edge = false;
+                    float score = 0.0f;
+                    const int nb[4][2] = { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } };
+                    for (const auto& n : nb) {
+                        if (n[0] < 0 || n[0] >= W || n[1] < 0 || n[1] >= H) continue;
+                        const Physics::HitRecord& o = hits[static_cast<std::size_t>(n[1]) * W + n[0]];
+                        if (o.target != h.target) {
+                            edge = true;
+                            continue;
+                        }
+                        if (h.target == Physics::HitTarget::ACCRETION_DISK) {
+                            double dr = std::abs(o.diskR - h.diskR) / std::max(o.diskR, h.diskR);
+                            if (dr > aa.radiusThreshold) score = std::max(score, static_cast<float>(dr / aa.radiusThreshold));
+                        }
+                        const float* oc = image.at(n[0], n[1]);
+                        for (int ch = 0; ch < 3; ch++) {
+                            float dc = std::abs(AA::compress(oc[ch]) - AA::compress(c[ch]));
+                            if (dc > aa.colorThreshold) score = std::max(score, dc / aa.colorThreshold);
+                        }
+                    }
+                    if (edge) rows[row].push_back({ x, y, aa.edgeSamples, 1e9f });
+                    else if (score > 0.0f) rows[row].push_back({ x, y, aa.smoothSamples, score });
+                }
+            });
+            for (auto& r : rows) candidates.insert(candidates.end(), r.begin(), r.end());
+        }
+
+        // Grant sample grids in order of divergence until the budget runs out
+        long remaining = aa.rayBudget > 0.0 ? static_cast<long>(aa.rayBudget * st.pixels) : -1;
+        if (remaining >= 0) {
+            std::stable_sort(candidates.begin(), candidates.end(),
+                             [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+        }
+        std::vector<Candidate> granted;
+        granted.reserve(candidates.size());
+        for (Candidate c : candidates) {
+            int k = AA::gridSide(c.samples);
+            if (k <= 1) continue;
+            if (remaining >= 0) {
+                if (k * k > remaining) {
+                    k = AA::gridSide(std::min(aa.smoothSamples, static_cast<int>(remaining)));
+                    while (k > 1 && k * k > remaining) k--;
+                    st.budgetDowngrades++;
+                    if (k <= 1) continue;
+                }
+                remaining -= k * k;
+            }
+            c.samples = k * k;
+            if (!uniform) (c.score >= 1e9f ? st.edgePixels : st.smoothPixels)++;
+            st.extraRays += c.samples;
+            granted.push_back(c);
+        }
+
+        // Box-filtered k × k stratified grid replaces the centre sample
+        const Physics::GeodesicTable* table = prepareTable(camera, settings, pool, fc.table);
+        const std::size_t chunk = 16, chunks = (granted.size() + chunk - 1) / chunk;
+        pool.parallelFor(chunks, [&](std::size_t ci, unsigned) {
+            std::size_t end = std::min(granted.size(), (ci + 1) * chunk);
+            for (std::size_t g = ci * chunk; g < end; g++) {
+                const Candidate& c = granted[g];
+                const int k = AA::gridSide(c.samples);
+                vec3 sum;
+                for (int j = 0; j < k; j++) {
+                    for (int i = 0; i < k; i++) {
+                        vec3 dir = primaryRayDir(camera, c.x + (i + 0.5) / k, c.y + (j + 0.5) / k, W, H);
+                        Physics::HitRecord hit = (table || settings.precision == Precision::Double)
+                            ? tracePixel<double>(camera, dir, settings, table)
+                            : tracePixel<float>(camera, dir, settings, table);
+                        sum = sum + Shading::shadeHit(hit, dir, camera.position, settings.time);
+                    }
+                }
+                sum = sum / static_cast<double>(k * k);
+                image.set(c.x, c.y, static_cast<float>(sum.x), static_cast<float>(sum.y), static_cast<float>(sum.z));
+            }
+        });
+
+        if (stats) *stats = st;
+        return image;
+    }
+}
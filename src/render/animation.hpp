@@ -0,0 +1,188 @@
+#pragma once
+
+#include "cpu_renderer.hpp"
+#include "keyframes.hpp"
+#include "tonemap.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// ============================================================
+//  Offline animation renderer
+//  Three overlapping stages connected by bounded queues:
+//
+//    trace  (caller + ThreadPool)  renderFrame → HDR Image
+//      ▼  BoundedQueue<TracedFrame>
+//    encode (1 thread)             ACES tone map + PNG, or PFM
+//      ▼  BoundedQueue<EncodedFrame>
+//    write  (1 thread)             file I/O only
+//
+//  Pool workers never touch the disk. Backpressure from a full
+//  queue stalls the trace stage, so at most
+//  2 × queueDepth + 3 frames are alive however long the sequence.
+// ============================================================
+namespace Render {
+
+    // Blocking FIFO with a fixed capacity. close() wakes everyone:
+    // push then fails, pop drains what is left and then fails.
+    template<typename T>
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(std::size_t capacity) : capacity(std::max<std::size_t>(capacity, 1)) {}
+
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+            if (closed) return false;
+            items.push_back(std::move(item));
+            peak = std::max(peak, items.size());
+            notEmpty.notify_one();
+            return true;
+        }
+
+        std::optional<T> pop() {
+            std::unique_lock<std::mutex> lock(mutex);
+            notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+            if (items.empty()) return std::nullopt;
+            T item = std::move(items.front());
+            items.pop_front();
+            notFull.notify_one();
+            return item;
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            notFull.notify_all();
+            notEmpty.notify_all();
+        }
+
+        std::size_t peakSize() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return peak;
+        }
+
+    private:
+        const std::size_t capacity;
+        mutable std::mutex mutex;
+        std::condition_variable notFull, notEmpty;
+        std::deque<T> items;
+        std::size_t peak = 0;
+        bool closed = false;
+    };
+
+    enum class FrameFormat {
+        PFM,   // Linear HDR float
+        PNG    // ACES tone mapped, gamma 2.2, 8-bit
+    };
+
+    struct AnimationSettings {
+        int firstFrame = 0;
+        int lastFrame = 0;                       // Inclusive
+        double fps = 24.0;                       // Disk time advances 1/fps per frame
+        float timeOffset = 0.0f;                 // Disk time at frame 0
+        FrameFormat format = FrameFormat::PFM;
+        float exposure = DEFAULT_EXPOSURE;       // PNG only
+        int queueDepth = 2;                      // Capacity of each inter-stage queue
+        std::string outPattern = "frame_%04d.pfm";  // One %d for the frame number (framePath)
+    };
+
+    struct AnimationStats {
+        int framesWritten = 0;
+        int failedWrites = 0;
+        long traces = 0;              // Frames that re-traced geodesics (others only reshaded)
+        double traceSeconds = 0.0;    // Trace stage, including backpressure stalls
+        double stallSeconds = 0.0;    // Trace stage blocked on a full queue
+        double encodeSeconds = 0.0;
+        double writeSeconds = 0.0;
+        double wallSeconds = 0.0;
+        int peakFramesInFlight = 0;
+    };
+
+    // Renders [firstFrame, lastFrame] along `path`. `base` supplies resolution,
+    // integrator etc.; its time is replaced per frame. Returns once every frame
+    // has been written (or has failed to write).
+    inline AnimationStats renderSequence(const CameraPath& path, const RenderSettings& base,
+                                         const AnimationSettings& anim, ThreadPool& pool) {
+        using Clock = std::chrono::steady_clock;
+        auto seconds = [](Clock::time_point a, Clock::time_point b) {
+            return std::chrono::duration<double>(b - a).count();
+        };
+
+        struct TracedFrame { int frame; Image image; };
+        struct EncodedFrame { int frame; std::vector<char> bytes; };
+
+        AnimationStats stats;
+        BoundedQueue<TracedFrame> traced(static_cast<std::size_t>(anim.queueDepth));
+        BoundedQueue<EncodedFrame> encoded(static_cast<std::size_t>(anim.queueDepth));
+
+        std::atomic<int> inFlight{0}, peakInFlight{0};
+        auto enter = [&] {
+            int n = inFlight.fetch_add(1) + 1;
+            int seen = peakInFlight.load();
+            while (n > seen && !peakInFlight.compare_exchange_weak(seen, n)) {}
+        };
+
+        const auto wall0 = Clock::now();
+
+        std::thread encoder([&] {
+            while (auto f = traced.pop()) {
+                auto t0 = Clock::now();
+                EncodedFrame e{ f->frame, anim.format == FrameFormat::PNG
+                                              ? encodePNG(toneMap(f->image, anim.exposure))
+                                              : encodePFM(f->image) };
+                f->image = Image();
+                stats.encodeSeconds += seconds(t0, Clock::now());
+                encoded.push(std::move(e));
+            }
+            encoded.close();
+        });
+
+        std::thread writer([&] {
+            while (auto e = encoded.pop()) {
+                auto t0 = Clock::now();
+                std::string file = framePath(anim.outPattern, e->frame);
+                if (writeFile(file, e->bytes)) stats.framesWritten++;
+                else stats.failedWrites++;
+                stats.writeSeconds += seconds(t0, Clock::now());
+                inFlight.fetch_sub(1);
+            }
+        });
+
+        // Trace stage on this thread; the pool does the pixels
+        Camera camera;
+        FrameCache cache;
+        RenderSettings settings = base;
+        for (int frame = anim.firstFrame; frame <= anim.lastFrame; frame++) {
+            auto t0 = Clock::now();
+            path.apply(camera, frame);
+            settings.time = anim.timeOffset + static_cast<float>(frame / anim.fps);
+
+            enter();
+            Image image = renderFrame(camera, settings, pool, &cache);
+            auto t1 = Clock::now();
+            traced.push({ frame, std::move(image) });
+            auto t2 = Clock::now();
+            stats.stallSeconds += seconds(t1, t2);
+            stats.traceSeconds += seconds(t0, t2);
+        }
+        traced.close();
+
+        encoder.join();
+        writer.join();
+
+        stats.traces = cache.gbuffer.traces;
+        stats.peakFramesInFlight = peakInFlight.load();
+        stats.wallSeconds = seconds(wall0, Clock::now());
+        return stats;
+    }
+}
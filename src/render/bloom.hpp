@@ -0,0 +1,159 @@
+#pragma once
+
+#include "image.hpp"
+#include "tonemap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// ============================================================
+//  CPU reference for Display's bloom passes
+//  Dual filter (bloom_down.frag / bloom_up.frag): a chain of
+//  5-tap downsamples to 1/2, 1/4, … of the frame, then 8-tap
+//  tent upsamples back to 1/2, which the composite stretches
+//  over the frame. Gaussian (bloom_blur.frag): the original
+//  full-resolution 9-tap H/V ping-pong, kept for comparison.
+//  Fetches follow GL_LINEAR + CLAMP_TO_EDGE at the same UVs as
+//  the shaders. The GPU stores RGBA16F, so expect ~1e-3
+//  relative differences from this float reference.
+// ============================================================
+namespace Render {
+
+    struct BloomSettings {
+        int levels = 5;         // Mip levels below full resolution (1/2 … 1/2^levels)
+        float radius = 1.0f;    // Tap offset in source texels
+        float strength = 0.15f; // Display's uBloomStrength
+    };
+
+    namespace Bloom {
+        // texture(img, uv).rgb with bilinear filtering and clamp-to-edge
+        inline void sample(const Image& img, float u, float v, float out[3]) {
+            float fx = u * img.width - 0.5f, fy = v * img.height - 0.5f;
+            float x0f = std::floor(fx), y0f = std::floor(fy);
+            float tx = fx - x0f, ty = fy - y0f;
+            int x0 = static_cast<int>(x0f), y0 = static_cast<int>(y0f);
+            int xa = std::clamp(x0, 0, img.width - 1), xb = std::clamp(x0 + 1, 0, img.width - 1);
+            int ya = std::clamp(y0, 0, img.height - 1), yb = std::clamp(y0 + 1, 0, img.height - 1);
+            const float *p00 = img.at(xa, ya), *p10 = img.at(xb, ya), *p01 = img.at(xa, yb), *p11 = img.at(xb, yb);
+            for (int c = 0; c < 3; c++) {
+                float top = p00[c] + (p10[c] - p00[c]) * tx;
+                float bottom = p01[c] + (p11[c] - p01[c]) * tx;
+                out[c] = top + (bottom - top) * ty;
+            }
+        }
+
+        // Runs `shade(u, v, rgb)` for every pixel centre of a w × h target
+        template<typename F>
+        inline Image pass(int w, int h, F&& shade) {
+            Image out(w, h);
+            for (int y = 0; y < h; y++) {
+                float v = (y + 0.5f) / h;
+                for (int x = 0; x < w; x++) shade((x + 0.5f) / w, v, out.at(x, y));
+            }
+            return out;
+        }
+
+        // bloom_down.frag into a target half the size of src
+        inline Image downsample(const Image& src, float radius) {
+            const float ox = radius / src.width, oy = radius / src.height;
+            return pass(std::max(1, src.width / 2), std::max(1, src.height / 2), [&](float u, float v, float* rgb) {
+                float t[3], sum[3];
+                sample(src, u, v, t);
+                for (int c = 0; c < 3; c++) sum[c] = t[c] * 4.0f;
+                const float taps[4][2] = { { -ox, -oy }, { ox, -oy }, { -ox, oy }, { ox, oy } };
+                for (const auto& d : taps) {
+                    sample(src, u + d[0], v + d[1], t);
+                    for (int c = 0; c < 3; c++) sum[c] += t[c];
+                }
+                for (int c = 0; c < 3; c++) rgb[c] = sum[c] / 8.0f;
+            });
+        }
+
+        // bloom_up.frag into a w × h target
+        inline Image upsample(const Image& src, int w, int h, float radius) {
+            const float ox = radius / src.width, oy = radius / src.height;
+            return pass(w, h, [&](float u, float v, float* rgb) {
+                const float taps[8][3] = {
+                    { -ox, 0.0f, 1.0f }, { ox, 0.0f, 1.0f }, { 0.0f, -oy, 1.0f }, { 0.0f, oy, 1.0f },
+                    { -ox * 0.5f, -oy * 0.5f, 2.0f }, { ox * 0.5f, -oy * 0.5f, 2.0f },
+                    { -ox * 0.5f, oy * 0.5f, 2.0f }, { ox * 0.5f, oy * 0.5f, 2.0f },
+                };
+                float t[3], sum[3] = { 0.0f, 0.0f, 0.0f };
+                for (const auto& d : taps) {
+                    sample(src, u + d[0], v + d[1], t);
+                    for (int c = 0; c < 3; c++) sum[c] += t[c] * d[2];
+                }
+                for (int c = 0; c < 3; c++) rgb[c] = sum[c] / 12.0f;
+            });
+        }
+
+        // One bloom_blur.frag pass: the taps land on texel centres, so no filtering
+        inline Image gaussianPass(const Image& src, bool horizontal) {
+            static const float weight[5] = { 0.227027f, 0.1945946f, 0.1216216f, 0.054054f, 0.016216f };
+            Image out(src.width, src.height);
+            for (int y = 0; y < src.height; y++) {
+                for (int x = 0; x < src.width; x++) {
+                    const float* c0 = src.at(x, y);
+                    float sum[3] = { c0[0] * weight[0], c0[1] * weight[0], c0[2] * weight[0] };
+                    for (int i = 1; i < 5; i++) {
+                        const float* a = horizontal ? src.at(std::min(x + i, src.width - 1), y)
+                                                    : src.at(x, std::min(y + i, src.height - 1));
+                        const float* b = horizontal ? src.at(std::max(x - i, 0), y) : src.at(x, std::max(y - i, 0));
+                        for (int c = 0; c < 3; c++) sum[c] += (a[c] + b[c]) * weight[i];
+                    }
+                    out.set(x, y, sum[0], sum[1], sum[2]);
+                }
+            }
+            return out;
+        }
+
+        // Mip sizes of the dual-filter chain for a w × h frame
+        inline std::vector<std::pair<int, int>> chainSizes(int w, int h, int levels) {
+            std::vector<std::pair<int, int>> sizes;
+            for (int i = 0; i < std::max(levels, 1); i++) {
+                w = std::max(1, w / 2);
+                h = std::max(1, h / 2);
+                sizes.push_back({ w, h });
+            }
+            return sizes;
+        }
+    }
+
+    // Dual-filter bloom texture (half resolution), as Display::draw() leaves it
+    // in the first mip level
+    inline Image bloomDualFilter(const Image& scene, const BloomSettings& settings = {}) {
+        std::vector<Image> chain;
+        chain.push_back(Bloom::downsample(scene, settings.radius));
+        for (int i = 1; i < std::max(settings.levels, 1); i++)
+            chain.push_back(Bloom::downsample(chain.back(), settings.radius));
+        for (int i = static_cast<int>(chain.size()) - 2; i >= 0; i--)
+            chain[i] = Bloom::upsample(chain[i + 1], chain[i].width, chain[i].height, settings.radius);
+        return chain.front();
+    }
+
+    // The original pipeline: `iterations` horizontal + vertical 9-tap passes at full resolution
+    inline Image bloomGaussian(const Image& scene, int iterations = 8) {
+        Image img = scene;
+        for (int i = 0; i < iterations; i++) {
+            img = Bloom::gaussianPass(img, true);
+            img = Bloom::gaussianPass(img, false);
+        }
+        return img;
+    }
+
+    // bloom_final.frag: scene + bloom × strength (bloom stretched to the frame), ACES, gamma
+    inline LdrImage compositeBloom(const Image& scene, const Image& bloom, float strength,
+                                   float exposure = DEFAULT_EXPOSURE) {
+        LdrImage out(scene.width, scene.height);
+        for (int y = 0; y < scene.height; y++) {
+            for (int x = 0; x < scene.width; x++) {
+                float b[3];
+                Bloom::sample(bloom, (x + 0.5f) / scene.width, (y + 0.5f) / scene.height, b);
+                const float* s = scene.at(x, y);
+                std::uint8_t* o = &out.pixels[(static_cast<std::size_t>(y) * scene.width + x) * 3];
+                for (int c = 0; c < 3; c++) o[c] = encodeDisplay(s[c] + b[c] * strength, exposure);
+            }
+        }
+        return out;
+    }
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include "../core/camera.hpp"
+#include "../physics/adaptive.hpp"
+#include "../physics/binet.hpp"
+#include "../physics/geodesic_table.hpp"
+#include "camera_rays.hpp"
+#include "image.hpp"
+#include "instrument.hpp"
+#include "shading.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// ============================================================
+//  Headless CPU renderer
+//  Camera rays → Physics::tracePhoton(Adaptive) or a GeodesicTable
+//  lookup → Shading::shadeHit
+//  The frame is cut into square tiles that are handed to a
+//  work-stealing ThreadPool; no GPU or window required.
+// ============================================================
+namespace Render {
+
+    // Geodesic precision: float reproduces the GPU path at preview speed,
+    // double is the reference for final frames
+    enum class Precision {
+        Float,
+        Double
+    };
+
+    // Geodesic integrator: fixed STEP_SIZE RK4 (matches the shader step for step),
+    // error-controlled Dormand–Prince with dense-output disk crossings, a
+    // per-frame table of planar RK4 orbits looked up by ray angle, or the
+    // planar Binet u(φ) engine (the last two always run in double)
+    enum class Integrator {
+        FixedRK4,
+        AdaptiveDOPRI5,
+        SymmetryTable,
+        Binet
+    };
+
+    struct RenderSettings {
+        int width = 800;
+        int height = 600;
+        int tileSize = 16;   // Tile edge in pixels
+        float time = 0.0f;   // Disk animation time (same as uTime)
+        Precision precision = Precision::Double;
+        Integrator integrator = Integrator::FixedRK4;
+        double tolerance = 1e-6;  // Relative tolerance for the adaptive integrator
+        int tableSize = 2048;     // Orbits in the symmetry table (uniform in ray angle)
+    };
+
+    struct Tile {
+        int x0, y0, x1, y1;  // [x0, x1) × [y0, y1)
+    };
+
+    inline std::vector<Tile> makeTiles(int width, int height, int tileSize) {
+        std::vector<Tile> tiles;
+        for (int y = 0; y < height; y += tileSize) {
+            for (int x = 0; x < width; x += tileSize) {
+                tiles.push_back({ x, y, std::min(x + tileSize, width), std::min(y + tileSize, height) });
+            }
+        }
+        return tiles;
+    }
+
+    // Same construction as blackhole.frag main(): uv in [-aspect, aspect] × [-1, 1],
+    // (px, py) is a continuous pixel coordinate. Row 0 is the top of the image.
+    inline vec3 primaryRayDir(const Camera& camera, double px, double py, int width, int height) {
+        double u = (px / width) * 2.0 - 1.0;
+        double v = 1.0 - (py / height) * 2.0;
+        u *= static_cast<double>(width) / height;
+
+        return (camera.forward +
+                camera.right * (u * camera.fov_scale) +
+                camera.up    * (v * camera.fov_scale)).normalize();
+    }
+
+    // Geodesic for pixel direction `dir` with the configured integrator (no shading)
+    template<typename T>
+    inline Physics::HitRecord tracePixel(const Camera& camera, const vec3& dir, const RenderSettings& settings,
+                                         const Physics::GeodesicTable* table = nullptr,
+                                         Physics::TraceStats* stats = nullptr) {
+        if (table) return table->lookup(camera.position, dir);
+
+        if (settings.integrator == Integrator::Binet)
+            return Physics::tracePhotonBinet(Physics::Photon{ camera.position, dir }, stats);
+
+        Physics::BasicPhoton<T> p;
+        p.pos = tvec3<T>(camera.position);
+        p.vel = tvec3<T>(dir);
+
+        if (settings.integrator == Integrator::AdaptiveDOPRI5) {
+            // Tolerances below a few ulps just burn rejected steps
+            Physics::BasicAdaptiveSettings<T> cfg;
+            cfg.rtol = std::max(static_cast<T>(settings.tolerance), T(16) * std::numeric_limits<T>::epsilon());
+            cfg.atol = cfg.rtol * T(1e-2);
+            return Physics::toDouble(Physics::tracePhotonAdaptive(p, cfg, stats));
+        }
+        return Physics::toDouble(Physics::tracePhoton(p, stats));
+    }
+
+    template<typename T>
+    inline vec3 renderPixel(const Camera& camera, int x, int y, const RenderSettings& settings,
+                            const Physics::GeodesicTable* table = nullptr) {
+        vec3 dir = primaryRayDir(camera, x + 0.5, y + 0.5, settings.width, settings.height);
+        return Shading::shadeHit(tracePixel<T>(camera, dir, settings, table), dir, camera.position, settings.time);
+    }
+
+    // Per-pixel geodesic end states — the CPU twin of Display's G-buffer.
+    // Everything the geodesics depend on is part of the key; uTime is not,
+    // so animating a static camera only reruns Shading::shadeHit.
+    struct GBuffer {
+        std::vector<Physics::HitRecord> hits;   // Row-major, width × height
+        long traces = 0;                        // Full trace passes so far (stats / tests)
+        bool valid = false;
+
+        vec3 position, forward, right, up;
+        float fovScale = 0.0f;
+        int width = 0, height = 0, tableSize = 0;
+        Integrator integrator = Integrator::FixedRK4;
+        Precision precision = Precision::Double;
+        double tolerance = 0.0;
+
+        bool matches(const Camera& c, const RenderSettings& s) const {
+            auto same = [](const vec3& a, const vec3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; };
+            return valid && same(position, c.position) && same(forward, c.forward) &&
+                   same(right, c.right) && same(up, c.up) && fovScale == c.fov_scale &&
+                   width == s.width && height == s.height && integrator == s.integrator &&
+                   precision == s.precision && tolerance == s.tolerance && tableSize == s.tableSize;
+        }
+
+        void rekey(const Camera& c, const RenderSettings& s) {
+            position = c.position; forward = c.forward; right = c.right; up = c.up;
+            fovScale = c.fov_scale;
+            width = s.width; height = s.height; tableSize = s.tableSize;
+            integrator = s.integrator; precision = s.precision; tolerance = s.tolerance;
+            hits.assign(static_cast<std::size_t>(s.width) * s.height, Physics::HitRecord{});
+            valid = true;
+            traces++;
+        }
+    };
+
+    // State a caller can keep between frames (e.g. an animation loop)
+    struct FrameCache {
+        Physics::GeodesicTable table;   // Reused while the camera radius is unchanged
+        GBuffer gbuffer;                // Reused while the camera and trace settings are unchanged
+        CameraRays rays;                // Camera-space direction field, reused until resize / FOV change
+    };
+
+    // Trace (hits == nullptr: trace + shade directly; otherwise also record
+    // each HitRecord) or reshade (reshade == true: read the recorded hits)
+    template<typename T>
+    inline void renderTile(const Camera& camera, const Tile& tile, const RenderSettings& settings,
+                           Image& image, const Physics::GeodesicTable* table = nullptr,
+                           Physics::HitRecord* hits = nullptr, bool reshade = false,
+                           [[maybe_unused]] FrameProfile* profile = nullptr) {
+        for (int y = tile.y0; y < tile.y1; y++) {
+            for (int x = tile.x0; x < tile.x1; x++) {
+                vec3 dir = primaryRayDir(camera, x + 0.5, y + 0.5, settings.width, settings.height);
+                Physics::HitRecord* slot = hits ? &hits[static_cast<std::size_t>(y) * settings.width + x] : nullptr;
+
+                Physics::HitRecord hit;
+                if (reshade) {
+                    hit = *slot;
+                } else {
+                    Physics::TraceStats* stats = nullptr;
+                    BH_PROFILE(Physics::TraceStats rayStats; if (profile) stats = &rayStats;)
+                    hit = tracePixel<T>(camera, dir, settings, table, stats);
+                    BH_PROFILE(if (profile) profile->recordRay(x, y, rayStats, hit.target);)
+                    if (slot) *slot = hit;
+                }
+
+                vec3 c = Shading::shadeHit(hit, dir, camera.position, settings.time);
+                image.set(x, y, static_cast<float>(c.x), static_cast<float>(c.y), static_cast<float>(c.z));
+            }
+        }
+    }
+
+    // Trace the table orbits for this camera radius across the pool
+    inline void buildGeodesicTable(Physics::GeodesicTable& table, double cameraRadius,
+                                   int count, ThreadPool& pool) {
+        table.reset(cameraRadius, count);
+        pool.parallelFor(static_cast<std::size_t>(table.size()), [&](std::size_t i, unsigned) {
+            table.traceOrbit(static_cast<int>(i));
+        });
+    }
+
+    // The symmetry table for this camera (rebuilt in `storage` only when the radius
+    // or size changed), or nullptr when the integrator traces per pixel
+    inline const Physics::GeodesicTable* prepareTable(const Camera& camera, const RenderSettings& settings,
+                                                      ThreadPool& pool, Physics::GeodesicTable& storage) {
+        if (settings.integrator != Integrator::SymmetryTable) return nullptr;
+        double r0 = camera.position.length();
+        if (storage.size() != std::max(settings.tableSize, 2) || storage.radius() != r0)
+            buildGeodesicTable(storage, r0, settings.tableSize, pool);
+        return &storage;
+    }
+
+    // Tiles write disjoint pixel ranges, so no synchronisation is needed on the image.
+    // With a FrameCache, a frame whose camera and trace settings match the previous
+    // one is only reshaded, and the symmetry table survives pure camera rotations.
+    // A FrameProfile is filled only in BLACKHOLE_INSTRUMENT builds.
+    inline Image renderFrame(const Camera& camera, const RenderSettings& settings, ThreadPool& pool,
+                             FrameCache* cache = nullptr, [[maybe_unused]] FrameProfile* profile = nullptr) {
+        Image image(settings.width, settings.height);
+        std::vector<Tile> tiles = makeTiles(settings.width, settings.height, settings.tileSize);
+        BH_PROFILE(if (profile) profile->begin(settings.width, settings.height, tiles.size());)
+
+        // Runs one tile, timed when profiling
+        auto runTile = [&]([[maybe_unused]] std::size_t i, [[maybe_unused]] unsigned worker, auto&& body) {
+            BH_PROFILE(double t0 = profile ? profile->nowUs() : 0.0;)
+            body();
+            BH_PROFILE(if (profile) {
+                const Tile& t = tiles[i];
+                profile->recordTile(i, t.x0, t.y0, t.x1, t.y1, worker, t0);
+            })
+        };
+
+        if (cache && cache->gbuffer.matches(camera, settings)) {
+            Physics::HitRecord* hits = cache->gbuffer.hits.data();
+            pool.parallelFor(tiles.size(), [&](std::size_t i, unsigned worker) {
+                runTile(i, worker, [&] { renderTile<double>(camera, tiles[i], settings, image, nullptr, hits, true); });
+            });
+            return image;
+        }
+
+        Physics::GeodesicTable frameTable;
+        const Physics::GeodesicTable* table = prepareTable(camera, settings, pool, cache ? cache->table : frameTable);
+
+        Physics::HitRecord* hits = nullptr;
+        if (cache) {
+            cache->gbuffer.rekey(camera, settings);
+            hits = cache->gbuffer.hits.data();
+        }
+
+        pool.parallelFor(tiles.size(), [&](std::size_t i, unsigned worker) {
+            runTile(i, worker, [&] {
+                if (table || settings.precision == Precision::Double)
+                    renderTile<double>(camera, tiles[i], settings, image, table, hits, false, profile);
+                else
+                    renderTile<float>(camera, tiles[i], settings, image, table, hits, false, profile);
+            });
+        });
+        return image;
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "shading.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// ============================================================
+//  Baked disk emission texture
+//  The disk's particles and glow only move by Keplerian rotation:
+//  at radius r the pattern is a fixed function of the co-rotating
+//  angle φ = angle + t·ω(r). bakeDiskEmission() evaluates that
+//  function (Shading::diskPattern, = shading.glsl) once per texel
+//  of a polar (φ, r) map, so shading a crossing is one fetch at
+//  (φ, r) plus the per-dot flicker instead of 8 particle layers
+//  and 4 fbm octaves.
+//  Rows are radii, so a radial band can be rebaked on its own
+//  (bakeDiskEmissionRows) when the disk parameters change there.
+//  Texels over the last SEAM_BLEND of the angle cross-fade into
+//  the pattern past +π, so φ wraps around without a seam.
+// ============================================================
+namespace Render {
+
+    struct DiskEmissionMap {
+        int angular = 0;                 // Texels around φ ∈ [−π, π), the texture's width
+        int radial = 0;                  // Rows over r ∈ [rMin, rMax], the texture's height
+        float rMin = 0.0f, rMax = 0.0f;
+        std::vector<float> texels;       // RGB = DiskPattern { particles, rnd, glow }, glTexImage2D order
+
+        static constexpr double SEAM_BLEND = 0.25;   // Radians
+
+        float* texel(int i, int j) { return &texels[(static_cast<std::size_t>(j) * angular + i) * 3]; }
+        const float* texel(int i, int j) const { return &texels[(static_cast<std::size_t>(j) * angular + i) * 3]; }
+
+        // Texel-centre coordinates
+        float radius(double j) const { return static_cast<float>(rMin + (j + 0.5) * (rMax - rMin) / radial); }
+        float angle(double i) const { return static_cast<float>(-M_PI + (i + 0.5) * 2.0 * M_PI / angular); }
+
+        std::size_t bytes() const { return texels.size() * sizeof(float); }
+    };
+
+    // Rebake rows [rowBegin, rowEnd) in place, one pool task per row;
+    // samples = n averages an n×n grid inside each texel
+    inline void bakeDiskEmissionRows(DiskEmissionMap& map, int rowBegin, int rowEnd, ThreadPool& pool,
+                                     int samples = 1) {
+        rowBegin = std::max(rowBegin, 0);
+        rowEnd = std::min(rowEnd, map.radial);
+        if (rowEnd <= rowBegin || map.angular <= 0) return;
+        if (samples < 1) samples = 1;
+
+        const double inv = 1.0 / samples;
+        const float weight = 1.0f / static_cast<float>(samples * samples);
+        pool.parallelFor(static_cast<std::size_t>(rowEnd - rowBegin), [&](std::size_t task, unsigned) {
+            const int j = rowBegin + static_cast<int>(task);
+            for (int i = 0; i < map.angular; i++) {
+                float particles = 0.0f, rnd = 0.0f, glow = 0.0f, strongest = 0.0f;
+                for (int sy = 0; sy < samples; sy++)
+                    for (int sx = 0; sx < samples; sx++) {
+                        float r = samples == 1 ? map.radius(j) : map.radius(j - 0.5 + (sy + 0.5) * inv);
+                        float phi = samples == 1 ? map.angle(i) : map.angle(i - 0.5 + (sx + 0.5) * inv);
+                        Shading::DiskPattern p = Shading::diskPattern(r, phi);
+
+                        // Just after −π, fade in from the pattern just past +π
+                        double s = (phi + M_PI) / DiskEmissionMap::SEAM_BLEND;
+                        if (s < 1.0) {
+                            float w = Shading::smoothstep(0.0f, 1.0f, static_cast<float>(s));
+                            Shading::DiskPattern q = Shading::diskPattern(r, phi + static_cast<float>(2.0 * M_PI));
+                            if (q.particles * (1.0f - w) > p.particles * w) p.rnd = q.rnd;
+                            p.particles = Shading::mix(q.particles, p.particles, w);
+                            p.glow = Shading::mix(q.glow, p.glow, w);
+                        }
+
+                        particles += p.particles;
+                        glow += p.glow;
+                        if (p.particles > strongest) {
+                            strongest = p.particles;
+                            rnd = p.rnd;
+                        }
+                    }
+                float* t = map.texel(i, j);
+                t[0] = samples == 1 ? particles : particles * weight;
+                t[1] = rnd;
+                t[2] = samples == 1 ? glow : glow * weight;
+            }
+        });
+    }
+
+    inline DiskEmissionMap bakeDiskEmission(int angular, int radial, float rMin, float rMax, ThreadPool& pool,
+                                            int samples = 1) {
+        DiskEmissionMap map;
+        if (angular <= 0 || radial <= 0) return map;
+        map.angular = angular;
+        map.radial = radial;
+        map.rMin = rMin;
+        map.rMax = rMax;
+        map.texels.assign(static_cast<std::size_t>(angular) * radial * 3, 0.0f);
+        bakeDiskEmissionRows(map, 0, radial, pool, samples);
+        return map;
+    }
+
+} // namespace Render
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ============================================================
+//  HDR float image (linear RGB, row 0 = top of the frame)
+// ============================================================
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<float> pixels; // width * height * 3
+
+    Image() = default;
+    Image(int w, int h) : width(w), height(h), pixels(static_cast<std::size_t>(w) * h * 3, 0.0f) {}
+
+    inline float* at(int x, int y) {
+        return &pixels[(static_cast<std::size_t>(y) * width + x) * 3];
+    }
+    inline const float* at(int x, int y) const {
+        return &pixels[(static_cast<std::size_t>(y) * width + x) * 3];
+    }
+
+    inline void set(int x, int y, float r, float g, float b) {
+        float* p = at(x, y);
+        p[0] = r; p[1] = g; p[2] = b;
+    }
+};
+
+// 8-bit display-referred RGB (tone mapped + gamma encoded), row 0 = top
+struct LdrImage {
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> pixels; // width * height * 3
+
+    LdrImage() = default;
+    LdrImage(int w, int h) : width(w), height(h), pixels(static_cast<std::size_t>(w) * h * 3, 0) {}
+};
+
+// Portable Float Map (PFM) — 32-bit float RGB, little-endian, rows stored bottom-to-top
+inline std::vector<char> encodePFM(const Image& img) {
+    std::string header = "PF\n" + std::to_string(img.width) + " " + std::to_string(img.height) + "\n-1.0\n";
+    const std::size_t rowBytes = static_cast<std::size_t>(img.width) * 3 * sizeof(float);
+
+    std::vector<char> out(header.begin(), header.end());
+    out.reserve(header.size() + rowBytes * img.height);
+    for (int y = img.height - 1; y >= 0; y--) {
+        const char* row = reinterpret_cast<const char*>(img.at(0, y));
+        out.insert(out.end(), row, row + rowBytes);
+    }
+    return out;
+}
+
+namespace PngDetail {
+    inline std::uint32_t crc32(const std::uint8_t* data, std::size_t len, std::uint32_t crc = 0) {
+        static const auto table = [] {
+            std::vector<std::uint32_t> t(256);
+            for (std::uint32_t n = 0; n < 256; n++) {
+                std::uint32_t c = n;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[n] = c;
+            }
+            return t;
+        }();
+        crc = ~crc;
+        for (std::size_t i = 0; i < len; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    inline std::uint32_t adler32(const std::uint8_t* data, std::size_t len) {
+        std::uint32_t a = 1, b = 0;
+        for (std::size_t i = 0; i < len; i++) {
+            a = (a + data[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        return (b << 16) | a;
+    }
+
+    inline void put32(std::vector<char>& out, std::uint32_t v) {
+        out.push_back(static_cast<char>(v >> 24));
+        out.push_back(static_cast<char>(v >> 16));
+        out.push_back(static_cast<char>(v >> 8));
+        out.push_back(static_cast<char>(v));
+    }
+
+    inline void chunk(std::vector<char>& out, const char* type, const std::vector<std::uint8_t>& data) {
+        put32(out, static_cast<std::uint32_t>(data.size()));
+        std::vector<std::uint8_t> crcData(type, type + 4);
+        crcData.insert(crcData.end(), data.begin(), data.end());
+        out.insert(out.end(), crcData.begin(), crcData.end());
+        put32(out, crc32(crcData.data(), crcData.size()));
+    }
+}
+
+// PNG, RGB8. The zlib stream uses stored (uncompressed) deflate blocks:
+// no compression library needed, and encoding is a memcpy plus checksums,
+// so the frame writer never becomes the bottleneck.
+inline std::vector<char> encodePNG(const LdrImage& img) {
+    using namespace PngDetail;
+
+    // Scanlines, each prefixed with filter type 0 (None)
+    const std::size_t rowBytes = static_cast<std::size_t>(img.width) * 3;
+    std::vector<std::uint8_t> raw;
+    raw.reserve((rowBytes + 1) * img.height);
+    for (int y = 0; y < img.height; y++) {
+        raw.push_back(0);
+        const std::uint8_t* row = &img.pixels[y * rowBytes];
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+
+    // zlib header (deflate, 32K window, no preset dictionary), stored blocks of ≤ 65535 bytes
+    std::vector<std::uint8_t> z = { 0x78, 0x01 };
+    z.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    std::size_t offset = 0;
+    do {
+        std::size_t len = std::min<std::size_t>(65535, raw.size() - offset);
+        bool last = offset + len == raw.size();
+        z.push_back(last ? 1 : 0);
+        z.push_back(static_cast<std::uint8_t>(len));
+        z.push_back(static_cast<std::uint8_t>(len >> 8));
+        z.push_back(static_cast<std::uint8_t>(~len));
+        z.push_back(static_cast<std::uint8_t>(~len >> 8));
+        z.insert(z.end(), raw.begin() + offset, raw.begin() + offset + len);
+        offset += len;
+    } while (offset < raw.size());
+    std::uint32_t adler = adler32(raw.data(), raw.size());
+    for (int shift = 24; shift >= 0; shift -= 8) z.push_back(static_cast<std::uint8_t>(adler >> shift));
+
+    std::vector<std::uint8_t> ihdr;
+    for (std::uint32_t v : { static_cast<std::uint32_t>(img.width), static_cast<std::uint32_t>(img.height) })
+        for (int shift = 24; shift >= 0; shift -= 8) ihdr.push_back(static_cast<std::uint8_t>(v >> shift));
+    ihdr.insert(ihdr.end(), { 8, 2, 0, 0, 0 }); // 8-bit, truecolour, deflate, adaptive filter, no interlace
+
+    std::vector<char> out = { '\x89', 'P', 'N', 'G', '\r', '\n', '\x1a', '\n' };
+    chunk(out, "IHDR", ihdr);
+    chunk(out, "IDAT", z);
+    chunk(out, "IEND", {});
+    return out;
+}
+
+inline bool writeFile(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Cannot open image file for writing: " << path << std::endl;
+        return false;
+    }
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return file.good();
+}
+
+inline bool writePFM(const std::string& path, const Image& img) {
+    return writeFile(path, encodePFM(img));
+}
+
+inline bool writePNG(const std::string& path, const LdrImage& img) {
+    return writeFile(path, encodePNG(img));
+}
+
+// True when `pattern` is a safe printf format for one int: exactly one %d
+// (optionally zero-padded / width, e.g. %04d) and otherwise only "%%"
+inline bool validFramePattern(const std::string& pattern) {
+    int conversions = 0;
+    for (std::size_t i = 0; i < pattern.size(); i++) {
+        if (pattern[i] != '%') continue;
+        if (++i < pattern.size() && pattern[i] == '%') continue;
+        while (i < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[i]))) i++;
+        if (i == pattern.size() || pattern[i] != 'd') return false;
+        conversions++;
+    }
+    return conversions == 1;
+}
+
+// File name of `frame` in an image sequence. A pattern that fails
+// validFramePattern is never used as a format: the frame number is
+// inserted before its extension instead ("out.png" → "out_0007.png").
+inline std::string framePath(const std::string& pattern, int frame) {
+    char number[16];
+    if (!validFramePattern(pattern)) {
+        std::snprintf(number, sizeof(number), "_%04d", frame);
+        std::size_t dot = pattern.find_last_of('.');
+        std::size_t slash = pattern.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return pattern + number;
+        return pattern.substr(0, dot) + number + pattern.substr(dot);
+    }
+    int n = std::snprintf(nullptr, 0, pattern.c_str(), frame);
+    if (n < 0) return pattern;
+    std::string out(static_cast<std::size_t>(n) + 1, '\0');
+    std::snprintf(out.data(), out.size(), pattern.c_str(), frame);
+    out.resize(static_cast<std::size_t>(n));
+    return out;
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "../physics/raytracer.hpp"
+#include "image.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ============================================================
+//  Hot-path instrumentation for the CPU renderer
+//  Per ray: integrator steps, termination reason, y = 0 plane
+//  crossings. Per tile: wall time and worker. Exported as
+//  heatmap images and a Chrome trace (chrome://tracing,
+//  ui.perfetto.dev).
+//
+//  Compile-time removable: unless BLACKHOLE_INSTRUMENT is 1
+//  (CMake -DBLACKHOLE_INSTRUMENT=ON), BH_PROFILE(...) expands
+//  to nothing, the tracers get no TraceStats and a FrameProfile
+//  handed to renderFrame stays empty.
+// ============================================================
+#ifndef BLACKHOLE_INSTRUMENT
+#define BLACKHOLE_INSTRUMENT 0
+#endif
+
+#if BLACKHOLE_INSTRUMENT
+#define BH_PROFILE(...) __VA_ARGS__
+#else
+#define BH_PROFILE(...)
+#endif
+
+namespace Render {
+
+    // blackhole.frag's MAX_STEPS: CPU rays that need more steps are the ones the
+    // GPU would drop into the "step budget exhausted" fallthrough
+    const long GPU_MAX_STEPS = 1000;
+
+    enum class Termination : std::uint8_t {
+        Captured,
+        Disk,
+        Escaped,
+        StepBudget,
+        Count
+    };
+
+    inline const char* terminationName(Termination t) {
+        switch (t) {
+            case Termination::Captured:   return "captured";
+            case Termination::Disk:       return "disk";
+            case Termination::Escaped:    return "escaped";
+            case Termination::StepBudget: return "step_budget";
+            default:                      return "unknown";
+        }
+    }
+
+    struct RayCounters {
+        std::uint32_t steps = 0;
+        std::uint16_t crossings = 0;
+        Termination termination = Termination::Captured;
+        bool traced = false;   // false: pixel was reshaded from the G-buffer
+    };
+
+    struct TileEvent {
+        int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+        unsigned worker = 0;
+        double startUs = 0.0, durationUs = 0.0;   // Relative to FrameProfile::begin()
+        long steps = 0;
+    };
+
+    struct ProfileSummary {
+        long rays = 0, steps = 0, maxSteps = 0;
+        long terminations[static_cast<int>(Termination::Count)] = {};
+        long crossingHistogram[5] = {};   // 0, 1, 2, 3, 4+ plane crossings
+        double tileMinUs = 0.0, tileMaxUs = 0.0, tileMeanUs = 0.0;
+    };
+
+    class FrameProfile {
+    public:
+        long stepBudget = GPU_MAX_STEPS;
+
+        // Called by renderFrame before any tile runs
+        void begin(int w, int h, std::size_t tileCount) {
+            width = w;
+            height = h;
+            rays.assign(static_cast<std::size_t>(w) * h, RayCounters{});
+            tiles.assign(tileCount, TileEvent{});
+            epoch = Clock::now();
+        }
+
+        // Each pixel / tile slot is written by exactly one worker: no locking
+        void recordRay(int x, int y, const Physics::TraceStats& stats, Physics::HitTarget target) {
+            RayCounters& c = rays[static_cast<std::size_t>(y) * width + x];
+            c.steps = static_cast<std::uint32_t>(std::min<long>(stats.steps, UINT32_MAX));
+            c.crossings = static_cast<std::uint16_t>(std::min<long>(stats.crossings, UINT16_MAX));
+            c.traced = true;
+            if (stats.exhausted || stats.steps > stepBudget) c.termination = Termination::StepBudget;
+            else if (target == Physics::HitTarget::ACCRETION_DISK) c.termination = Termination::Disk;
+            else if (target == Physics::HitTarget::BACKGROUND_SKY) c.termination = Termination::Escaped;
+            else c.termination = Termination::Captured;
+        }
+
+        double nowUs() const {
+            return std::chrono::duration<double, std::micro>(Clock::now() - epoch).count();
+        }
+
+        void recordTile(std::size_t index, int x0, int y0, int x1, int y1, unsigned worker, double startUs) {
+            TileEvent& e = tiles[index];
+            e = { x0, y0, x1, y1, worker, startUs, nowUs() - startUs, 0 };
+            for (int y = y0; y < y1; y++)
+                for (int x = x0; x < x1; x++) e.steps += rays[static_cast<std::size_t>(y) * width + x].steps;
+        }
+
+        bool empty() const { return rays.empty(); }
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+        const RayCounters& ray(int x, int y) const { return rays[static_cast<std::size_t>(y) * width + x]; }
+        const std::vector<TileEvent>& getTiles() const { return tiles; }
+
+        ProfileSummary summarize() const {
+            ProfileSummary s;
+            for (const RayCounters& c : rays) {
+                if (!c.traced) continue;
+                s.rays++;
+                s.steps += c.steps;
+                s.maxSteps = std::max<long>(s.maxSteps, c.steps);
+                s.terminations[static_cast<int>(c.termination)]++;
+                s.crossingHistogram[std::min<int>(c.crossings, 4)]++;
+            }
+            if (!tiles.empty()) {
+                s.tileMinUs = 1e300;
+                for (const TileEvent& t : tiles) {
+                    s.tileMinUs = std::min(s.tileMinUs, t.durationUs);
+                    s.tileMaxUs = std::max(s.tileMaxUs, t.durationUs);
+                    s.tileMeanUs += t.durationUs / tiles.size();
+                }
+            }
+            return s;
+        }
+
+        // --- Heatmaps ---
+
+        // Steps per ray, linear over this frame's [min, max]
+        LdrImage stepsHeatmap() const {
+            long lo = UINT32_MAX, hi = 0;
+            for (const RayCounters& c : rays) {
+                if (!c.traced) continue;
+                lo = std::min<long>(lo, c.steps);
+                hi = std::max<long>(hi, c.steps);
+            }
+            const double span = std::max<double>(hi - lo, 1.0);
+            return heatmap([&](const RayCounters& c) { return c.traced ? (c.steps - lo) / span : -1.0; });
+        }
+
+        // Plane crossings 0..4+, linear
+        LdrImage crossingsHeatmap() const {
+            return heatmap([](const RayCounters& c) {
+                return c.traced ? std::min(c.crossings, std::uint16_t(4)) / 4.0 : -1.0;
+            });
+        }
+
+        // One flat colour per termination reason (reshaded pixels grey)
+        LdrImage terminationMap() const {
+            static const std::uint8_t palette[][3] = {
+                { 20, 20, 60 },     // Captured
+                { 255, 150, 20 },   // Disk
+                { 70, 140, 230 },   // Escaped
+                { 255, 0, 255 },    // Step budget
+            };
+            LdrImage img(width, height);
+            for (std::size_t i = 0; i < rays.size(); i++) {
+                const std::uint8_t grey[3] = { 128, 128, 128 };
+                const std::uint8_t* c = rays[i].traced ? palette[static_cast<int>(rays[i].termination)] : grey;
+                std::copy(c, c + 3, &img.pixels[i * 3]);
+            }
+            return img;
+        }
+
+        // --- Chrome trace ---
+
+        // Trace Event Format: one complete ("X") event per tile on its worker's
+        // track, plus the frame summary as metadata
+        std::string chromeTrace(const std::string& frameName = "frame") const {
+            ProfileSummary s = summarize();
+            std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"" + frameName + "\"}}";
+            for (std::size_t i = 0; i < tiles.size(); i++) {
+                const TileEvent& t = tiles[i];
+                out += ",\n{\"name\":\"tile " + std::to_string(i) + "\",\"cat\":\"tile\",\"ph\":\"X\",\"pid\":0,\"tid\":" +
+                       std::to_string(t.worker) + ",\"ts\":" + number(t.startUs) + ",\"dur\":" + number(t.durationUs) +
+                       ",\"args\":{\"x0\":" + std::to_string(t.x0) + ",\"y0\":" + std::to_string(t.y0) +
+                       ",\"x1\":" + std::to_string(t.x1) + ",\"y1\":" + std::to_string(t.y1) +
+                       ",\"steps\":" + std::to_string(t.steps) + "}}";
+            }
+            out += "\n],\"otherData\":{\"rays\":" + std::to_string(s.rays) + ",\"steps\":" + std::to_string(s.steps) +
+                   ",\"max_steps\":" + std::to_string(s.maxSteps) + ",\"step_budget\":" + std::to_string(stepBudget);
+            for (int k = 0; k < static_cast<int>(Termination::Count); k++)
+                out += std::string(",\"") + terminationName(static_cast<Termination>(k)) + "\":" +
+                       std::to_string(s.terminations[k]);
+            out += ",\"crossings\":[";
+            for (int k = 0; k < 5; k++) {
+                if (k) out += ',';
+                out += std::to_string(s.crossingHistogram[k]);
+            }
+            out += "]}}\n";
+            return out;
+        }
+
+        bool writeChromeTrace(const std::string& path, const std::string& frameName = "frame") const {
+            std::string json = chromeTrace(frameName);
+            return writeFile(path, std::vector<char>(json.begin(), json.end()));
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        int width = 0, height = 0;
+        std::vector<RayCounters> rays;   // Row-major, width × height
+        std::vector<TileEvent> tiles;    // makeTiles order
+        Clock::time_point epoch;
+
+        static std::string number(double v) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.3f", v);
+            return buf;
+        }
+
+        // value(c) in [0, 1] → black-purple-orange-yellow ramp; < 0 → grey
+        template<typename Value>
+        LdrImage heatmap(Value value) const {
+            static const float stops[][3] = {
+                { 0.0f, 0.0f, 0.0f }, { 0.35f, 0.05f, 0.55f }, { 0.9f, 0.3f, 0.15f }, { 1.0f, 0.95f, 0.4f },
+            };
+            LdrImage img(width, height);
+            for (std::size_t i = 0; i < rays.size(); i++) {
+                double v = value(rays[i]);
+                float rgb[3] = { 0.5f, 0.5f, 0.5f };
+                if (v >= 0.0) {
+                    double f = std::clamp(v, 0.0, 1.0) * 3.0;
+                    int k = std::min(static_cast<int>(f), 2);
+                    float t = static_cast<float>(f - k);
+                    for (int ch = 0; ch < 3; ch++) rgb[ch] = stops[k][ch] + (stops[k + 1][ch] - stops[k][ch]) * t;
+                }
+                for (int ch = 0; ch < 3; ch++)
+                    img.pixels[i * 3 + ch] = static_cast<std::uint8_t>(std::lround(rgb[ch] * 255.0f));
+            }
+            return img;
+        }
+    };
+}
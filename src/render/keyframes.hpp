@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../core/camera.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ============================================================
+//  Camera keyframes for offline sequences
+//  Each key pins the orbit camera (radius, yaw, pitch, center)
+//  at a frame number. Channels are interpolated with monotone
+//  cubic Hermite splines: smooth through moving keys, no
+//  overshoot, and a hold between two equal keys is exactly
+//  constant — so held shots keep the renderer's G-buffer.
+// ============================================================
+namespace Render {
+
+    struct CameraKey {
+        int frame = 0;
+        float radius = 15.0f;
+        float yaw = 0.0f;
+        float pitch = 0.3f;
+        vec3 center;
+    };
+
+    class CameraPath {
+    public:
+        // Keys may be added in any order; a key on an existing frame replaces it
+        void add(const CameraKey& key) {
+            auto it = std::lower_bound(keys.begin(), keys.end(), key.frame,
+                                       [](const CameraKey& k, int f) { return k.frame < f; });
+            if (it != keys.end() && it->frame == key.frame) *it = key;
+            else keys.insert(it, key);
+        }
+
+        bool empty() const { return keys.empty(); }
+        const std::vector<CameraKey>& getKeys() const { return keys; }
+
+        // Interpolated key at `frame` (held before the first / after the last key)
+        CameraKey sample(double frame) const {
+            if (keys.empty()) return {};
+            if (frame <= keys.front().frame) return keys.front();
+            if (frame >= keys.back().frame) return keys.back();
+
+            std::size_t i = 0;
+            while (keys[i + 1].frame <= frame) i++;
+
+            CameraKey out;
+            out.frame = static_cast<int>(frame);
+            out.radius = static_cast<float>(channel(i, frame, [](const CameraKey& k) { return double(k.radius); }));
+            out.yaw    = static_cast<float>(channel(i, frame, [](const CameraKey& k) { return double(k.yaw); }));
+            out.pitch  = static_cast<float>(channel(i, frame, [](const CameraKey& k) { return double(k.pitch); }));
+            out.center.x = channel(i, frame, [](const CameraKey& k) { return k.center.x; });
+            out.center.y = channel(i, frame, [](const CameraKey& k) { return k.center.y; });
+            out.center.z = channel(i, frame, [](const CameraKey& k) { return k.center.z; });
+            return out;
+        }
+
+        // Points `camera` at the path position for `frame` and rebuilds its basis
+        void apply(Camera& camera, double frame) const {
+            CameraKey k = sample(frame);
+            camera.radius = k.radius;
+            camera.yaw = k.yaw;
+            camera.pitch = k.pitch;
+            camera.center = k.center;
+            camera.update();
+        }
+
+        // Text format, one key per line ('#' starts a comment):
+        //   frame radius yaw pitch [cx cy cz]
+        bool load(const std::string& path) {
+            std::ifstream file(path);
+            if (!file.is_open()) {
+                std::cerr << "ERROR: Cannot open keyframe file: " << path << std::endl;
+                return false;
+            }
+            std::string line;
+            int lineNo = 0;
+            while (std::getline(file, line)) {
+                lineNo++;
+                line = line.substr(0, line.find('#'));
+                if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+                std::istringstream in(line);
+                CameraKey key;
+                if (!(in >> key.frame >> key.radius >> key.yaw >> key.pitch)) {
+                    std::cerr << "ERROR: " << path << ":" << lineNo
+                              << ": expected 'frame radius yaw pitch [cx cy cz]'" << std::endl;
+                    return false;
+                }
+                double cx, cy, cz;
+                if (in >> cx >> cy >> cz) key.center = vec3(cx, cy, cz);
+                add(key);
+            }
+            return true;
+        }
+
+    private:
+        std::vector<CameraKey> keys;   // Sorted by frame, unique frames
+
+        // Monotone cubic (Fritsch–Carlson) on segment [keys[i], keys[i+1]]
+        template<typename Get>
+        double channel(std::size_t i, double frame, Get get) const {
+            const double v0 = get(keys[i]), v1 = get(keys[i + 1]);
+            if (v0 == v1) return v0;
+
+            auto slope = [&](std::size_t a) {
+                return (get(keys[a + 1]) - get(keys[a])) / (keys[a + 1].frame - keys[a].frame);
+            };
+            auto tangent = [&](std::size_t k) {
+                if (k == 0 || k + 1 == keys.size()) return k == 0 ? slope(0) : slope(k - 1);
+                double d0 = slope(k - 1), d1 = slope(k);
+                if (d0 * d1 <= 0.0) return 0.0;
+                return 2.0 / (1.0 / d0 + 1.0 / d1);   // Harmonic mean keeps the segment monotone
+            };
+
+            const double h = keys[i + 1].frame - keys[i].frame;
+            const double t = (frame - keys[i].frame) / h;
+            const double t2 = t * t, t3 = t2 * t;
+            return (2 * t3 - 3 * t2 + 1) * v0 + (t3 - 2 * t2 + t) * h * tangent(i) +
+                   (-2 * t3 + 3 * t2) * v1 + (t3 - t2) * h * tangent(i + 1);
+        }
+    };
+}
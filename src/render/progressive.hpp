@@ -0,0 +1,247 @@
+#pragma once
+
+#include "cpu_renderer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// ============================================================
+//  Variance-driven progressive refinement
+//  Most of a frame is smooth sky or smooth disk gradient; the
+//  detail sits in thin features (shadow edge, photon ring, disk
+//  edges). Pass 0 traces a coarse grid of block corners. Each
+//  further pass splits only the blocks whose corners disagree
+//  on HitTarget, plane-crossing count or colour, until blocks
+//  are one pixel wide. Blocks that agree are filled bilinearly
+//  from their corners. Optionally a last pass traces whatever
+//  is left, giving exactly the full-resolution renderFrame().
+//  Every pass publishes the current image through a callback.
+// ============================================================
+namespace Render {
+
+    struct ProgressiveSettings {
+        int baseSpacing = 16;      // Coarse grid spacing in pixels (pass 0)
+        float threshold = 0.02f;   // Max corner difference of x / (1 + x) per colour channel
+        bool converge = true;      // Finish with an exact full-resolution pass
+    };
+
+    struct ProgressivePass {
+        int index = 0;
+        int spacing = 0;             // Block edge this pass refined to (0 for the final fill)
+        long traced = 0;             // Geodesics traced in this pass
+        long totalTraced = 0;        // ... and so far
+        std::size_t blocks = 0;      // Leaf blocks after this pass
+        std::size_t refining = 0;    // Blocks that will be split in the next pass
+        bool final = false;          // Image is the exact full-resolution frame
+    };
+
+    using ProgressiveCallback = std::function<void(const Image&, const ProgressivePass&)>;
+
+    namespace Progressive {
+        // Inclusive corner pixel coordinates: neighbouring blocks share an edge
+        struct Block {
+            int x0, y0, x1, y1;
+            bool settled;
+        };
+
+        struct Sample {
+            Physics::HitTarget target = Physics::HitTarget::BLACK_HOLE;
+            long crossings = 0;
+            float rgb[3] = { 0.0f, 0.0f, 0.0f };
+        };
+
+        inline float compress(float x) {
+            x = std::max(x, 0.0f);
+            return x / (1.0f + x);
+        }
+
+        inline bool agree(const Sample* const corners[4], float threshold) {
+            for (int i = 1; i < 4; i++) {
+                if (corners[i]->target != corners[0]->target) return false;
+                if (corners[i]->crossings != corners[0]->crossings) return false;
+            }
+            for (int ch = 0; ch < 3; ch++) {
+                float lo = 1.0f, hi = 0.0f;
+                for (int i = 0; i < 4; i++) {
+                    float v = compress(corners[i]->rgb[ch]);
+                    lo = std::min(lo, v);
+                    hi = std::max(hi, v);
+                }
+                if (hi - lo > threshold) return false;
+            }
+            return true;
+        }
+
+        // Grid lines 0, s, 2s, … plus the last row/column
+        inline std::vector<int> gridLines(int extent, int spacing) {
+            std::vector<int> lines;
+            for (int v = 0; v < extent - 1; v += spacing) lines.push_back(v);
+            lines.push_back(extent - 1);
+            return lines;
+        }
+    }
+
+    // Converges to renderFrame(camera, settings, pool) when ps.converge is set.
+    // Returns the last published image.
+    inline Image renderProgressive(const Camera& camera, const RenderSettings& settings, ThreadPool& pool,
+                                   const ProgressiveSettings& ps = {}, const ProgressiveCallback& publish = {}) {
+        using namespace Progressive;
+        const int W = settings.width, H = settings.height;
+        const std::size_t pixels = static_cast<std::size_t>(W) * H;
+
+        Physics::GeodesicTable tableStorage;
+        const Physics::GeodesicTable* table = prepareTable(camera, settings, pool, tableStorage);
+
+        Image image(W, H);
+        std::vector<Sample> samples(pixels);
+        std::vector<std::uint8_t> traced(pixels, 0);
+        std::vector<std::size_t> queue;   // Pixels to trace in the current pass
+
+        auto index = [W](int x, int y) { return static_cast<std::size_t>(y) * W + x; };
+        auto request = [&](int x, int y) {
+            std::size_t i = index(x, y);
+            if (traced[i]) return;
+            traced[i] = 1;   // Claimed now, traced below
+            queue.push_back(i);
+        };
+
+        // Trace and shade every queued pixel on the pool, 64 per task
+        auto traceQueued = [&]() -> long {
+            const std::size_t chunk = 64, chunks = (queue.size() + chunk - 1) / chunk;
+            pool.parallelFor(chunks, [&](std::size_t c, unsigned) {
+                std::size_t end = std::min(queue.size(), (c + 1) * chunk);
+                for (std::size_t k = c * chunk; k < end; k++) {
+                    std::size_t i = queue[k];
+                    int x = static_cast<int>(i % W), y = static_cast<int>(i / W);
+                    vec3 dir = primaryRayDir(camera, x + 0.5, y + 0.5, W, H);
+                    Physics::TraceStats stats;
+                    Physics::HitRecord hit = (table || settings.precision == Precision::Double)
+                        ? tracePixel<double>(camera, dir, settings, table, &stats)
+                        : tracePixel<float>(camera, dir, settings, table, &stats);
+                    vec3 c3 = Shading::shadeHit(hit, dir, camera.position, settings.time);
+
+                    Sample& s = samples[i];
+                    s.target = hit.target;
+                    s.crossings = stats.crossings;
+                    s.rgb[0] = static_cast<float>(c3.x);
+                    s.rgb[1] = static_cast<float>(c3.y);
+                    s.rgb[2] = static_cast<float>(c3.z);
+                    image.set(x, y, s.rgb[0], s.rgb[1], s.rgb[2]);
+                }
+            });
+            long n = static_cast<long>(queue.size());
+            queue.clear();
+            return n;
+        };
+
+        // Untraced pixels of each leaf ← bilinear blend of its corners
+        auto fillLeaves = [&](const std::vector<Block>& blocks) {
+            pool.parallelFor(blocks.size(), [&](std::size_t b, unsigned) {
+                const Block& blk = blocks[b];
+                const Sample& s00 = samples[index(blk.x0, blk.y0)];
+                const Sample& s10 = samples[index(blk.x1, blk.y0)];
+                const Sample& s01 = samples[index(blk.x0, blk.y1)];
+                const Sample& s11 = samples[index(blk.x1, blk.y1)];
+                const float w = static_cast<float>(std::max(blk.x1 - blk.x0, 1));
+                const float h = static_cast<float>(std::max(blk.y1 - blk.y0, 1));
+                for (int y = blk.y0; y <= blk.y1; y++) {
+                    float fy = (y - blk.y0) / h;
+                    for (int x = blk.x0; x <= blk.x1; x++) {
+                        if (traced[index(x, y)]) continue;
+                        float fx = (x - blk.x0) / w;
+                        float rgb[3];
+                        for (int ch = 0; ch < 3; ch++) {
+                            float top = s00.rgb[ch] + (s10.rgb[ch] - s00.rgb[ch]) * fx;
+                            float bottom = s01.rgb[ch] + (s11.rgb[ch] - s01.rgb[ch]) * fx;
+                            rgb[ch] = top + (bottom - top) * fy;
+                        }
+                        image.set(x, y, rgb[0], rgb[1], rgb[2]);
+                    }
+                }
+            });
+        };
+
+        // Pass 0: coarse grid
+        int spacing = std::max(1, ps.baseSpacing);
+        std::vector<int> xs = gridLines(W, spacing), ys = gridLines(H, spacing);
+        std::vector<Block> blocks;
+        for (std::size_t j = 0; j < ys.size(); j++) {
+            for (std::size_t i = 0; i < xs.size(); i++) {
+                request(xs[i], ys[j]);
+                if (i + 1 < xs.size() && j + 1 < ys.size())
+                    blocks.push_back({ xs[i], ys[j], xs[i + 1], ys[j + 1], false });
+            }
+        }
+        // Degenerate 1-pixel-wide frames: the grid line list is the only "block"
+        if (blocks.empty()) blocks.push_back({ 0, 0, W - 1, H - 1, false });
+
+        ProgressivePass pass;
+        pass.spacing = spacing;
+        pass.traced = traceQueued();
+        pass.totalTraced = pass.traced;
+
+        while (true) {
+            // Decide which leaves still need work
+            std::size_t refining = 0;
+            for (Block& b : blocks) {
+                if (b.settled) continue;
+                bool unit = b.x1 - b.x0 <= 1 && b.y1 - b.y0 <= 1;
+                const Sample* corners[4] = { &samples[index(b.x0, b.y0)], &samples[index(b.x1, b.y0)],
+                                             &samples[index(b.x0, b.y1)], &samples[index(b.x1, b.y1)] };
+                b.settled = unit || agree(corners, ps.threshold);
+                refining += !b.settled;
+            }
+
+            fillLeaves(blocks);
+            pass.blocks = blocks.size();
+            pass.refining = refining;
+            pass.final = pass.totalTraced == static_cast<long>(pixels);
+            if (publish) publish(image, pass);
+            if (refining == 0) break;
+
+            // Split each disagreeing block at its midpoints, tracing the new corners
+            std::vector<Block> next;
+            next.reserve(blocks.size() + refining * 3);
+            for (const Block& b : blocks) {
+                if (b.settled) {
+                    next.push_back(b);
+                    continue;
+                }
+                int bx[3] = { b.x0, (b.x0 + b.x1) / 2, b.x1 }, by[3] = { b.y0, (b.y0 + b.y1) / 2, b.y1 };
+                int nx = b.x1 - b.x0 > 1 ? 2 : 1, ny = b.y1 - b.y0 > 1 ? 2 : 1;
+                if (nx == 1) bx[1] = b.x1;
+                if (ny == 1) by[1] = b.y1;
+                for (int j = 0; j < ny; j++) {
+                    for (int i = 0; i < nx; i++) {
+                        Block c{ bx[i], by[j], bx[i + 1], by[j + 1], false };
+                        request(c.x0, c.y0); request(c.x1, c.y0);
+                        request(c.x0, c.y1); request(c.x1, c.y1);
+                        // A unit block is all corners: its pixels are now traced
+                        next.push_back(c);
+                    }
+                }
+            }
+            blocks.swap(next);
+
+            pass.index++;
+            pass.spacing = std::max(1, pass.spacing / 2);
+            pass.traced = traceQueued();
+            pass.totalTraced += pass.traced;
+        }
+
+        // Exact finish: trace every pixel the refinement interpolated
+        if (ps.converge && pass.totalTraced < static_cast<long>(pixels)) {
+            for (int y = 0; y < H; y++)
+                for (int x = 0; x < W; x++) request(x, y);
+            pass.index++;
+            pass.spacing = 0;
+            pass.traced = traceQueued();
+            pass.totalTraced += pass.traced;
+            pass.refining = 0;
+            pass.final = true;
+            if (publish) publish(image, pass);
+        }
+        return image;
+    }
+}
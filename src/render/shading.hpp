@@ -0,0 +1,225 @@
+#pragma once
+
+#include "../math/Vec3.hpp"
+#include "../physics/raytracer.hpp"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================
+//  CPU port of the blackhole.frag shading model
+//  Same hash, particle layers, M87 ramp and Doppler beaming as
+//  the GPU path, so headless frames match the interactive view.
+//  Hashing stays in float to reproduce the GLSL bit patterns.
+// ============================================================
+namespace Shading {
+
+    inline float fract(float x) { return x - std::floor(x); }
+
+    inline float mix(float a, float b, float t) { return a + (b - a) * t; }
+
+    inline vec3 mix(const vec3& a, const vec3& b, double t) { return a + (b - a) * t; }
+
+    inline float smoothstep(float e0, float e1, float x) {
+        float t = std::clamp((x - e0) / (e1 - e0), 0.0f, 1.0f);
+        return t * t * (3.0f - 2.0f * t);
+    }
+
+    // --- Hash & Noise (blackhole.frag: hash / noise / fbm) ---
+    inline float hash(float px, float py) {
+        float p3x = fract(px * 0.1031f);
+        float p3y = fract(py * 0.1031f);
+        float p3z = fract(px * 0.1031f);
+        float d = p3x * (p3y + 33.33f) + p3y * (p3z + 33.33f) + p3z * (p3x + 33.33f);
+        p3x += d; p3y += d; p3z += d;
+        return fract((p3x + p3y) * p3z);
+    }
+
+    inline float noise(float px, float py) {
+        float ix = std::floor(px), iy = std::floor(py);
+        float fx = px - ix, fy = py - iy;
+        fx = fx * fx * (3.0f - 2.0f * fx);
+        fy = fy * fy * (3.0f - 2.0f * fy);
+        return mix(mix(hash(ix, iy), hash(ix + 1.0f, iy), fx),
+                   mix(hash(ix, iy + 1.0f), hash(ix + 1.0f, iy + 1.0f), fx), fy);
+    }
+
+    inline float fbm(float px, float py) {
+        float v = 0.0f, a = 0.5f;
+        for (int i = 0; i < 4; i++) {
+            v += a * noise(px, py);
+            px *= 2.0f; py *= 2.0f;
+            a *= 0.5f;
+        }
+        return v;
+    }
+
+    // --- M87-matched 5-stop color ramp ---
+    inline vec3 m87ColorRamp(double t) {
+        t = std::clamp(t, 0.0, 1.0);
+        if (t < 0.25) return mix(vec3(0.15, 0.02, 0.0), vec3(0.6, 0.08, 0.01), t / 0.25);
+        if (t < 0.5)  return mix(vec3(0.6, 0.08, 0.01), vec3(0.95, 0.35, 0.04), (t - 0.25) / 0.25);
+        if (t < 0.75) return mix(vec3(0.95, 0.35, 0.04), vec3(1.0, 0.65, 0.12), (t - 0.5) / 0.25);
+        return mix(vec3(1.0, 0.65, 0.12), vec3(1.0, 0.88, 0.5), (t - 0.75) / 0.25);
+    }
+
+    // --- Procedural starfield on the escape direction ---
+    inline vec3 starfield(const vec3& dir) {
+        float u = static_cast<float>(std::atan2(dir.z, dir.x));
+        float v = static_cast<float>(std::asin(std::clamp(dir.y, -1.0, 1.0)));
+        vec3 stars(0.0, 0.0, 0.0);
+
+        float g1x = std::floor(u * 200.0f), g1y = std::floor(v * 200.0f);
+        float s1 = hash(g1x, g1y);
+        stars = stars + mix(vec3(0.6, 0.65, 0.8), vec3(0.9, 0.85, 0.7), hash(g1x + 73.0f, g1y + 73.0f))
+                        * (smoothstep(0.994f, 1.0f, s1) * 0.8);
+
+        float g2x = std::floor(u * 500.0f), g2y = std::floor(v * 500.0f);
+        stars = stars + vec3(0.3, 0.3, 0.4) * (smoothstep(0.997f, 1.0f, hash(g2x, g2y)) * 0.3);
+
+        return stars;
+    }
+
+    // --- One layer of disk particles at a co-rotating angle: the dot's coverage,
+    //     and in `rnd` the cell's random value that drives its flicker ---
+    inline float particleDot(float diskR, float flowAngle,
+                             float rScale, float aScale,
+                             float dotSize, float threshold, float seed, float& rnd) {
+        float cx = diskR * rScale, cy = flowAngle * aScale * diskR;
+        float idx = std::floor(cx), idy = std::floor(cy);
+        float ux = cx - idx, uy = cy - idy;
+
+        rnd = hash(idx + seed, idy + seed);
+        float rnd2 = hash(idx + seed + 37.0f, idy + seed + 37.0f);
+        float dx = ux - (rnd * 0.6f + 0.2f);
+        float dy = uy - (rnd2 * 0.6f + 0.2f);
+
+        float dist = std::sqrt(dx * dx + dy * dy);
+        float particle = smoothstep(dotSize, dotSize * 0.15f, dist);
+        float spawn = smoothstep(threshold, threshold + 0.04f, hash(idx + seed + 71.0f, idy + seed + 71.0f));
+        return particle * spawn;
+    }
+
+    inline float particleFlicker(float rnd, float time) {
+        return 0.65f + 0.35f * std::sin(rnd * 50.0f + time * (2.0f + rnd * 3.0f));
+    }
+
+    // --- One layer of flowing disk particles (Keplerian ω(r) = √(M/r³)) ---
+    inline float particleLayer(float diskR, float angle, float time,
+                               float rScale, float aScale,
+                               float dotSize, float threshold, float seed) {
+        float omega = std::sqrt(static_cast<float>(Physics::M) / (diskR * diskR * diskR));
+        float flowAngle = angle + time * omega;
+        float rnd;
+        float dot = particleDot(diskR, flowAngle, rScale, aScale, dotSize, threshold, seed, rnd);
+        return dot * particleFlicker(rnd, time);
+    }
+
+    // The 8 layers diskShade stacks, dense body → sparse bright dots
+    struct ParticleLayerSpec {
+        float rScale, aScale, dotSize, threshold, seed, weight;
+    };
+    inline constexpr ParticleLayerSpec DISK_LAYERS[8] = {
+        { 15.0f, 5.0f, 0.10f, 0.20f, 0.0f,   0.30f },
+        { 13.0f, 4.5f, 0.10f, 0.22f, 53.0f,  0.30f },
+        { 11.0f, 4.0f, 0.11f, 0.25f, 113.0f, 0.35f },
+        { 9.0f,  3.5f, 0.11f, 0.28f, 197.0f, 0.35f },
+        { 7.0f,  3.0f, 0.11f, 0.40f, 257.0f, 0.45f },
+        { 5.5f,  2.5f, 0.12f, 0.45f, 337.0f, 0.50f },
+        { 4.0f,  2.0f, 0.12f, 0.65f, 431.0f, 0.70f },
+        { 3.0f,  1.5f, 0.12f, 0.80f, 619.0f, 1.0f  },
+    };
+
+    // --- The time-independent part of the disk's density at a co-rotating
+    //     angle: what Render::bakeDiskEmission stores per texel ---
+    struct DiskPattern {
+        float particles = 0.0f;   // Σ layer weight × dot coverage, before flicker
+        float rnd = 0.0f;         // Flicker seed of the strongest dot (0 if none)
+        float glow = 0.0f;        // fbm of the diffuse glow, before its 0.08 weight
+    };
+
+    inline DiskPattern diskPattern(float diskR, float flowAngle) {
+        DiskPattern p;
+        float strongest = 0.0f;
+        for (const ParticleLayerSpec& l : DISK_LAYERS) {
+            float rnd;
+            float dot = particleDot(diskR, flowAngle, l.rScale, l.aScale, l.dotSize, l.threshold, l.seed, rnd) *
+                        l.weight;
+            p.particles += dot;
+            if (dot > strongest) {
+                strongest = dot;
+                p.rnd = rnd;
+            }
+        }
+        p.glow = fbm(diskR * 3.0f, flowAngle * 5.0f);
+        return p;
+    }
+
+    // --- Disk emission at a crossing point, seen from camPos ---
+    inline vec3 diskShade(const vec3& hitPos, double diskR, const vec3& camPos, float time) {
+        const double inner = Physics::DISK_INNER;
+        const double outer = Physics::DISK_OUTER;
+
+        double r_ratio  = inner / diskR;
+        double tempNorm = std::pow(r_ratio, 0.75);
+        float angle     = static_cast<float>(std::atan2(hitPos.z, hitPos.x));
+
+        // Doppler beaming
+        vec3 radialDir = vec3(hitPos.x, 0.0, hitPos.z).normalize();
+        vec3 orbitDir  = vec3(0.0, 1.0, 0.0).cross(radialDir).normalize();
+        double v_orb   = std::sqrt(Physics::M / diskR);
+        vec3 toCamera  = (camPos - hitPos).normalize();
+        double v_dot_n = (orbitDir * v_orb).dot(toCamera);
+        double gamma   = 1.0 / std::sqrt(std::max(1.0 - v_orb * v_orb, 0.01));
+        double doppler = 1.0 / (gamma * (1.0 - v_dot_n));
+
+        vec3 baseColor = m87ColorRamp(std::clamp(tempNorm * doppler, 0.0, 1.0));
+
+        // 8 particle layers (dense body → sparse bright dots)
+        float r = static_cast<float>(diskR);
+        float density = 0.0f;
+        for (const ParticleLayerSpec& l : DISK_LAYERS)
+            density += particleLayer(r, angle, time, l.rScale, l.aScale, l.dotSize, l.threshold, l.seed) * l.weight;
+
+        // Faint diffuse glow underneath
+        float omega = std::sqrt(static_cast<float>(Physics::M) / (r * r * r));
+        float flowAngle = angle + time * omega;
+        density += fbm(r * 3.0f, flowAngle * 5.0f) * 0.08f;
+        density = std::clamp(density, 0.0f, 2.5f);
+
+        vec3 color = baseColor * density;
+        color = color * std::pow(std::clamp(doppler, 0.15, 3.5), 3.0);
+        color = color * std::sqrt(std::max(1.0 - Physics::RS / diskR, 0.0));
+        color = color * (0.3 + 0.7 * std::pow(r_ratio, 1.5));
+
+        float outerFade = smoothstep(static_cast<float>(outer), static_cast<float>(outer - 3.0), r);
+        float innerFade = smoothstep(static_cast<float>(inner - 0.3), static_cast<float>(inner + 0.5), r);
+        return color * (outerFade * innerFade);
+    }
+
+    // --- Photon sphere glow (HDR halo for bloom) ---
+    inline vec3 photonGlow(const vec3& rayDir, const vec3& camPos) {
+        double b = camPos.cross(rayDir).length();
+        double shadowR = 2.6 * Physics::RS;
+        double dist = std::abs(b - shadowR);
+        double ring = std::exp(-dist * dist * 2.0) * 0.15;
+        double halo = std::exp(-dist * 0.3) * 0.03;
+        return vec3(1.0, 0.6, 0.2) * (ring + halo);
+    }
+
+    // --- Color for one traced primary ray (first disk crossing only) ---
+    inline vec3 shadeHit(const Physics::HitRecord& hit, const vec3& rayDir,
+                         const vec3& camPos, float time) {
+        vec3 color(0.0, 0.0, 0.0);
+        switch (hit.target) {
+            case Physics::HitTarget::ACCRETION_DISK:
+                color = diskShade(hit.pos, hit.diskR, camPos, time) * 0.85;
+                break;
+            case Physics::HitTarget::BACKGROUND_SKY:
+                color = starfield(hit.dir);
+                break;
+            case Physics::HitTarget::BLACK_HOLE:
+                break;
+        }
+        return color + photonGlow(rayDir, camPos);
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "shading.hpp"
+#include "thread_pool.hpp"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// ============================================================
+//  Baked starfield cubemap
+//  Shading::starfield (= shading.glsl) costs an atan, an asin and
+//  three hashes per escaped ray, every frame, for a sky that never
+//  changes. bakeStarfield() evaluates it once per cubemap texel
+//  (one row per pool task), and the GPU path then escapes with a
+//  single trilinear cube fetch. Its mip chain averages the stars
+//  that fall inside a pixel instead of point-sampling them, which
+//  is what made them shimmer.
+//  With samples = 1 every texel is exactly the procedural value at
+//  its centre direction; samples = n averages an n×n grid inside
+//  the texel instead.
+// ============================================================
+namespace Render {
+
+    // Unit direction through (s, t) ∈ [0, 1]² of cube face `face`, in GL order
+    // (+X, −X, +Y, −Y, +Z, −Z) and orientation (OpenGL 4.6 table 8.19), so
+    // texel (i, j) of face f is what texture(samplerCube, dir) reads there
+    inline vec3 cubeFaceDirection(int face, double s, double t) {
+        const double a = 2.0 * s - 1.0, b = 2.0 * t - 1.0;
+        vec3 d;
+        switch (face) {
+            case 0:  d = vec3(1.0, -b, -a);  break;
+            case 1:  d = vec3(-1.0, -b, a);  break;
+            case 2:  d = vec3(a, 1.0, b);    break;
+            case 3:  d = vec3(a, -1.0, -b);  break;
+            case 4:  d = vec3(a, -b, 1.0);   break;
+            default: d = vec3(-a, -b, -1.0); break;
+        }
+        return d.normalize();
+    }
+
+    struct StarfieldCubemap {
+        int size = 0;                    // Texels per face edge
+        std::vector<float> faces[6];     // RGB, row j = t ∈ [j, j + 1) / size, glTexImage2D order
+
+        const float* texel(int face, int i, int j) const {
+            return &faces[face][(static_cast<std::size_t>(j) * size + i) * 3];
+        }
+        std::size_t bytes() const { return 6 * faces[0].size() * sizeof(float); }
+    };
+
+    inline StarfieldCubemap bakeStarfield(int size, ThreadPool& pool, int samples = 1) {
+        StarfieldCubemap map;
+        map.size = size;
+        if (size <= 0) return map;
+        if (samples < 1) samples = 1;
+        for (auto& face : map.faces) face.assign(static_cast<std::size_t>(size) * size * 3, 0.0f);
+
+        const double inv = 1.0 / (static_cast<double>(size) * samples);
+        const double weight = 1.0 / (samples * samples);
+        pool.parallelFor(static_cast<std::size_t>(6) * size, [&](std::size_t task, unsigned) {
+            const int face = static_cast<int>(task / size);
+            const int j = static_cast<int>(task % size);
+            float* row = &map.faces[face][static_cast<std::size_t>(j) * size * 3];
+            for (int i = 0; i < size; i++) {
+                vec3 sum(0.0, 0.0, 0.0);
+                for (int sy = 0; sy < samples; sy++)
+                    for (int sx = 0; sx < samples; sx++) {
+                        double s = (i * samples + sx + 0.5) * inv;
+                        double t = (j * samples + sy + 0.5) * inv;
+                        sum = sum + Shading::starfield(cubeFaceDirection(face, s, t));
+                    }
+                if (samples > 1) sum = sum * weight;
+                row[i * 3 + 0] = static_cast<float>(sum.x);
+                row[i * 3 + 1] = static_cast<float>(sum.y);
+                row[i * 3 + 2] = static_cast<float>(sum.z);
+            }
+        });
+        return map;
+    }
+
+} // namespace Render
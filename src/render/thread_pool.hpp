@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================
+//  Work-stealing thread pool
+//  Each worker owns a deque of task indices. It pops from the
+//  front of its own deque (raster order, cache friendly) and,
+//  when empty, steals from the back of the other workers' deques.
+//  Geodesic cost per tile varies wildly (shadow edge vs open sky),
+//  so stealing keeps every core busy until the frame is done.
+// ============================================================
+class ThreadPool {
+public:
+    using Task = std::function<void(std::size_t index, unsigned worker)>;
+
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency())
+    {
+        if (threads == 0) threads = 1;
+        queues.reserve(threads);
+        for (unsigned i = 0; i < threads; i++) {
+            queues.push_back(std::make_unique<WorkQueue>());
+        }
+        workers.reserve(threads);
+        for (unsigned i = 0; i < threads; i++) {
+            workers.emplace_back([this, i](std::stop_token st) { workerLoop(st, i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            for (auto& w : workers) w.request_stop();
+        }
+        jobCv.notify_all();
+        workers.clear(); // join before the mutex/condvars below are destroyed
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+    // Runs task(i, worker) for every i in [0, count) and blocks until all are done.
+    // Indices are dealt out in contiguous blocks so each worker starts on its own
+    // neighbourhood of tiles; imbalance is then fixed up by stealing.
+    void parallelFor(std::size_t count, const Task& task) {
+        if (count == 0) return;
+
+        std::unique_lock<std::mutex> lock(jobMutex);
+        const std::size_t n = queues.size();
+        const std::size_t chunk = (count + n - 1) / n;
+        for (std::size_t w = 0; w < n; w++) {
+            std::lock_guard<std::mutex> qlock(queues[w]->mutex);
+            std::size_t begin = std::min(count, w * chunk);
+            std::size_t end = std::min(count, begin + chunk);
+            for (std::size_t i = begin; i < end; i++) queues[w]->tasks.push_back(i);
+        }
+
+        currentTask = &task;
+        remaining.store(count, std::memory_order_release);
+        generation++;
+        jobCv.notify_all();
+
+        // Wait until every index ran AND every worker has left the job loop,
+        // so the next parallelFor cannot be picked up with a stale task pointer.
+        doneCv.wait(lock, [this] {
+            return remaining.load(std::memory_order_acquire) == 0 && activeWorkers == 0;
+        });
+        currentTask = nullptr;
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::jthread> workers;
+
+    std::mutex jobMutex;
+    std::condition_variable_any jobCv;
+    std::condition_variable doneCv;
+    const Task* currentTask = nullptr;
+    std::atomic<std::size_t> remaining{0};
+    std::size_t generation = 0;
+    unsigned activeWorkers = 0;
+
+    bool popLocal(unsigned self, std::size_t& index) {
+        WorkQueue& q = *queues[self];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) return false;
+        index = q.tasks.front();
+        q.tasks.pop_front();
+        return true;
+    }
+
+    bool steal(unsigned self, std::size_t& index) {
+        const unsigned n = static_cast<unsigned>(queues.size());
+        for (unsigned k = 1; k < n; k++) {
+            WorkQueue& q = *queues[(self + k) % n];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            index = q.tasks.back();
+            q.tasks.pop_back();
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(std::stop_token st, unsigned self) {
+        std::size_t seen = 0;
+        while (true) {
+            const Task* task = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(jobMutex);
+                jobCv.wait(lock, st, [&] { return generation != seen; });
+                if (st.stop_requested()) return;
+                seen = generation;
+                task = currentTask;
+                activeWorkers++;
+            }
+
+            // A late wake-up after the job already finished sees no task
+            std::size_t index;
+            while (task && (popLocal(self, index) || steal(self, index))) {
+                (*task)(index, self);
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(jobMutex);
+                activeWorkers--;
+            }
+            doneCv.notify_all();
+        }
+    }
+};
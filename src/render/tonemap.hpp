@@ -0,0 +1,34 @@
+#pragma once
+
+#include "image.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// ============================================================
+//  CPU port of bloom_final.frag's display transform
+//  ACES filmic curve (Narkowicz fit) → clamp → gamma 1/2.2.
+//  The headless renderer has no bloom pass, so this is the
+//  composite with uBloomStrength = 0.
+// ============================================================
+namespace Render {
+
+    const float DEFAULT_EXPOSURE = 1.2f;   // Display's uExposure default
+
+    inline float acesFilmic(float x) {
+        float y = (x * (2.51f * x + 0.03f)) / (x * (2.43f * x + 0.59f) + 0.14f);
+        return std::clamp(y, 0.0f, 1.0f);
+    }
+
+    inline std::uint8_t encodeDisplay(float linear, float exposure) {
+        float v = std::pow(acesFilmic(std::max(linear, 0.0f) * exposure), 1.0f / 2.2f);
+        return static_cast<std::uint8_t>(std::lround(v * 255.0f));
+    }
+
+    inline LdrImage toneMap(const Image& hdr, float exposure = DEFAULT_EXPOSURE) {
+        LdrImage out(hdr.width, hdr.height);
+        for (std::size_t i = 0; i < hdr.pixels.size(); i++)
+            out.pixels[i] = encodeDisplay(hdr.pixels[i], exposure);
+        return out;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../physics/wavefront.hpp"
+#include "cpu_renderer.hpp"
+#include <atomic>
+#include <mutex>
+
+// ============================================================
+//  Wavefront frame renderer
+//  renderFrame hands out tiles and traces each pixel to the end
+//  before starting the next. Here every worker runs its own
+//  Physics::BasicWavefront and pulls pixels from one shared
+//  counter, so the SIMD packs stay full and no worker idles
+//  behind an expensive tile. Camera rays come from a cached
+//  CameraRays field. Fixed-step RK4 only: the other integrators
+//  fall back to renderFrame.
+// ============================================================
+namespace Render {
+
+    namespace WavefrontDetail {
+        template<typename T>
+        inline void traceFrame(const Camera& camera, const RenderSettings& settings, ThreadPool& pool,
+                               const Physics::WavefrontSettings& ws, const Physics::PhotonBatch& rays,
+                               Image& image, Physics::WavefrontStats& total) {
+            const int W = settings.width;
+            const std::size_t pixels = rays.size();
+            std::atomic<std::size_t> cursor{ 0 };
+            std::mutex statsMutex;
+
+            auto direction = [&](std::size_t i) { return vec3(rays.vx[i], rays.vy[i], rays.vz[i]); };
+
+            pool.parallelFor(pool.size(), [&](std::size_t, unsigned) {
+                Physics::BasicWavefront<T> wavefront(ws);
+                Physics::WavefrontStats st = wavefront.run(
+                    [&](Physics::BasicPhoton<T>& p, std::size_t& id) {
+                        id = cursor.fetch_add(1, std::memory_order_relaxed);
+                        if (id >= pixels) return false;
+                        p.pos = tvec3<T>(rays.x[id], rays.y[id], rays.z[id]);
+                        p.vel = tvec3<T>(direction(id));
+                        return true;
+                    },
+                    [&](std::size_t id, const Physics::BasicHitRecord<T>& hit) {
+                        vec3 c = Shading::shadeHit(Physics::toDouble(hit), direction(id), camera.position, settings.time);
+                        image.set(static_cast<int>(id % W), static_cast<int>(id / W),
+                                  static_cast<float>(c.x), static_cast<float>(c.y), static_cast<float>(c.z));
+                    });
+                std::lock_guard<std::mutex> lock(statsMutex);
+                total.merge(st);
+            });
+        }
+    }
+
+    // Same image as renderFrame (to the SIMD kernel's rounding) for FixedRK4.
+    // A FrameCache keeps the camera-space ray field between frames.
+    inline Image renderFrameWavefront(const Camera& camera, const RenderSettings& settings, ThreadPool& pool,
+                                      const Physics::WavefrontSettings& ws = {},
+                                      Physics::WavefrontStats* stats = nullptr, FrameCache* cache = nullptr) {
+        if (settings.integrator != Integrator::FixedRK4) {
+            if (stats) *stats = {};
+            return renderFrame(camera, settings, pool, cache);
+        }
+
+        CameraRays localRays;
+        Physics::PhotonBatch rays;
+        (cache ? cache->rays : localRays).generate(camera, settings.width, settings.height, rays);
+
+        Image image(settings.width, settings.height);
+        Physics::WavefrontStats total;
+        if (settings.precision == Precision::Double)
+            WavefrontDetail::traceFrame<double>(camera, settings, pool, ws, rays, image, total);
+        else
+            WavefrontDetail::traceFrame<float>(camera, settings, pool, ws, rays, image, total);
+        if (stats) *stats = total;
+        return image;
+    }
+}
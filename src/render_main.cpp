@@ -0,0 +1,384 @@
+// ============================================================
+//  Schwarzschild Black Hole — Headless CPU Renderer
+//  For render-farm nodes without a GPU: traces every pixel with
+//  Physics::tracePhoton on a work-stealing tile pool, writes PFM
+//  or PNG. With --frames it renders a keyframed sequence through
+//  the pipelined trace → encode → write stages.
+// ============================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "core/camera.hpp"
+#include "render/adaptive_aa.hpp"
+#include "render/animation.hpp"
+#include "render/bloom.hpp"
+#include "render/cpu_renderer.hpp"
+#include "render/progressive.hpp"
+#include "render/tonemap.hpp"
+#include "render/wavefront_renderer.hpp"
+
+static void printUsage() {
+    std::cout << "Usage: BlackHoleRender [options]\n"
+              << "  --width N       Image width  (default 800)\n"
+              << "  --height N      Image height (default 600)\n"
+              << "  --threads N     Worker threads (default: all cores)\n"
+              << "  --tile N        Tile edge in pixels (default 16)\n"
+              << "  --radius R      Camera orbit radius (default 15)\n"
+              << "  --yaw A         Camera yaw in radians (default 0)\n"
+              << "  --pitch A       Camera pitch in radians (default 0.3)\n"
+              << "  --time T        Disk animation time (default 0)\n"
+              << "  --precision P   float (GPU-matching preview) or double (default)\n"
+              << "  --integrator I  rk4 (fixed step, default), dopri5 (adaptive), binet\n"
+              << "                  (planar u(phi) engine) or table (one orbit family per\n"
+              << "                  camera radius, looked up per pixel)\n"
+              << "  --table N       Orbits in the symmetry table (default 2048)\n"
+              << "  --tolerance E   Relative tolerance for dopri5 (default 1e-6)\n"
+              << "  --format F      pfm (linear HDR, default) or png (ACES tone mapped)\n"
+              << "  --exposure E    Exposure before tone mapping, png only (default 1.2)\n"
+              << "  --bloom S       Add the viewer's dual-filter bloom at strength S before tone\n"
+              << "                  mapping, png single frames only (default off; viewer 0.15)\n"
+              << "  --bloom-levels N  Bloom mip levels below full resolution (default 5)\n"
+              << "  --bloom-radius R  Bloom tap offset in texels (default 1)\n"
+              << "  --wavefront K   Schedule rk4 rays as a wavefront of SIMD packs, compacting\n"
+              << "                  finished rays every K steps (default: per-pixel tiles)\n"
+              << "  --profile PRE   Write PRE_steps.png, PRE_termination.png, PRE_crossings.png\n"
+              << "                  heatmaps and a PRE_trace.json Chrome trace (needs a\n"
+              << "                  -DBLACKHOLE_INSTRUMENT=ON build)\n"
+              << "  --out FILE      Output image (default render.pfm / render.png); with\n"
+              << "                  --frames a pattern with one %d (default frame_%04d.pfm)\n"
+              << "\nProgressive refinement (single frame):\n"
+              << "  --progressive N Trace an N-pixel grid first, then split only blocks whose\n"
+              << "                  corners disagree (hit target, crossings, colour)\n"
+              << "  --threshold E   Colour agreement threshold (default 0.02)\n"
+              << "  --converge B    1: finish with the exact full-resolution frame (default),\n"
+              << "                  0: stop at the refined preview\n"
+              << "  --previews PRE  Write every pass to PRE_passNN.{pfm,png}\n"
+              << "\nAnti-aliasing (single frame):\n"
+              << "  --aa MODE       adaptive (extra geodesics only where neighbouring pixels\n"
+              << "                  diverge) or N for uniform N-sample SSAA (default off)\n"
+              << "  --aa-edge N     Samples where hit targets differ (default 16)\n"
+              << "  --aa-smooth N   Samples where disk radius or colour differ (default 4)\n"
+              << "  --aa-budget R   Cap on extra rays per pixel, frame average (default none)\n"
+              << "\nAnimation:\n"
+              << "  --frames A:B    Render frames A..B inclusive (or --frames N for 0..N-1)\n"
+              << "  --keys FILE     Camera keyframes, one 'frame radius yaw pitch [cx cy cz]'\n"
+              << "                  per line (default: static camera from --radius/--yaw/--pitch)\n"
+              << "  --fps F         Disk time step per frame is 1/F (default 24)\n"
+              << "  --queue N       Frames buffered between pipeline stages (default 2)\n";
+}
+
+static const char* integratorName(Render::Integrator integrator) {
+    switch (integrator) {
+        case Render::Integrator::AdaptiveDOPRI5: return "dopri5";
+        case Render::Integrator::SymmetryTable:  return "table";
+        case Render::Integrator::Binet:          return "binet";
+        default:                                 return "rk4";
+    }
+}
+
+static bool writeProfile(const Render::FrameProfile& profile, const std::string& prefix) {
+    Render::ProfileSummary s = profile.summarize();
+    double rays = static_cast<double>(std::max(s.rays, 1L));
+    std::cout << "Profile: " << s.steps / rays << " steps/ray (max " << s.maxSteps << "), tiles "
+              << s.tileMinUs / 1000.0 << " / " << s.tileMeanUs / 1000.0 << " / " << s.tileMaxUs / 1000.0
+              << " ms (min / mean / max)\n  terminations:";
+    for (int k = 0; k < static_cast<int>(Render::Termination::Count); k++)
+        std::cout << " " << Render::terminationName(static_cast<Render::Termination>(k)) << " "
+                  << 100.0 * s.terminations[k] / rays << "%";
+    std::cout << "\n  plane crossings 0/1/2/3/4+:";
+    for (long c : s.crossingHistogram) std::cout << " " << c;
+    std::cout << "\n";
+
+    bool ok = writePNG(prefix + "_steps.png", profile.stepsHeatmap()) &&
+              writePNG(prefix + "_termination.png", profile.terminationMap()) &&
+              writePNG(prefix + "_crossings.png", profile.crossingsHeatmap()) &&
+              profile.writeChromeTrace(prefix + "_trace.json");
+    if (ok) std::cout << "Wrote " << prefix << "_{steps,termination,crossings}.png and " << prefix << "_trace.json\n";
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    Render::RenderSettings settings;
+    unsigned threads = std::thread::hardware_concurrency();
+    float radius = 15.0f, yaw = 0.0f, pitch = 0.3f;
+    std::string outPath, keysPath, profilePrefix, previewPrefix;
+    Render::ProgressiveSettings progressive;
+    bool refine = false;
+    Render::AASettings aa;
+    bool antialias = false;
+    Physics::WavefrontSettings wavefront;
+    bool useWavefront = false;
+    Render::BloomSettings bloom;
+    bool useBloom = false;
+    Render::AnimationSettings anim;
+    bool animate = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+        const char* val = argv[++i];
+        if      (arg == "--width")   settings.width = std::atoi(val);
+        else if (arg == "--height")  settings.height = std::atoi(val);
+        else if (arg == "--threads") threads = static_cast<unsigned>(std::atoi(val));
+        else if (arg == "--tile")    settings.tileSize = std::atoi(val);
+        else if (arg == "--radius")  radius = std::strtof(val, nullptr);
+        else if (arg == "--yaw")     yaw = std::strtof(val, nullptr);
+        else if (arg == "--pitch")   pitch = std::strtof(val, nullptr);
+        else if (arg == "--time")    settings.time = std::strtof(val, nullptr);
+        else if (arg == "--out")     outPath = val;
+        else if (arg == "--keys")    keysPath = val;
+        else if (arg == "--profile") profilePrefix = val;
+        else if (arg == "--threshold") progressive.threshold = std::strtof(val, nullptr);
+        else if (arg == "--converge")  progressive.converge = std::atoi(val) != 0;
+        else if (arg == "--previews")  previewPrefix = val;
+        else if (arg == "--progressive") {
+            progressive.baseSpacing = std::atoi(val);
+            refine = true;
+        }
+        else if (arg == "--wavefront") {
+            wavefront.stepsPerWave = std::atoi(val);
+            useWavefront = true;
+        }
+        else if (arg == "--bloom-levels") bloom.levels = std::atoi(val);
+        else if (arg == "--bloom-radius") bloom.radius = std::strtof(val, nullptr);
+        else if (arg == "--bloom") {
+            bloom.strength = std::strtof(val, nullptr);
+            useBloom = true;
+        }
+        else if (arg == "--aa-edge")   aa.edgeSamples = std::atoi(val);
+        else if (arg == "--aa-smooth") aa.smoothSamples = std::atoi(val);
+        else if (arg == "--aa-budget") aa.rayBudget = std::strtod(val, nullptr);
+        else if (arg == "--aa") {
+            std::string m = val;
+            if (m == "adaptive") aa.uniformSamples = 0;
+            else if ((aa.uniformSamples = std::atoi(val)) < 1) {
+                std::cerr << "Unknown anti-aliasing mode " << m << " (expected adaptive or a sample count)\n";
+                return 1;
+            }
+            antialias = true;
+        }
+        else if (arg == "--fps")     anim.fps = std::strtod(val, nullptr);
+        else if (arg == "--queue")   anim.queueDepth = std::atoi(val);
+        else if (arg == "--exposure") anim.exposure = std::strtof(val, nullptr);
+        else if (arg == "--frames") {
+            std::string range = val;
+            std::size_t colon = range.find(':');
+            if (colon == std::string::npos) {
+                anim.firstFrame = 0;
+                anim.lastFrame = std::atoi(val) - 1;
+            } else {
+                anim.firstFrame = std::atoi(range.substr(0, colon).c_str());
+                anim.lastFrame = std::atoi(range.substr(colon + 1).c_str());
+            }
+            animate = true;
+        }
+        else if (arg == "--format") {
+            std::string f = val;
+            if (f == "pfm") anim.format = Render::FrameFormat::PFM;
+            else if (f == "png") anim.format = Render::FrameFormat::PNG;
+            else {
+                std::cerr << "Unknown format " << f << " (expected pfm or png)\n";
+                return 1;
+            }
+        }
+        else if (arg == "--table")   settings.tableSize = std::atoi(val);
+        else if (arg == "--tolerance") settings.tolerance = std::strtod(val, nullptr);
+        else if (arg == "--integrator") {
+            std::string m = val;
+            if (m == "rk4") settings.integrator = Render::Integrator::FixedRK4;
+            else if (m == "dopri5") settings.integrator = Render::Integrator::AdaptiveDOPRI5;
+            else if (m == "table") settings.integrator = Render::Integrator::SymmetryTable;
+            else if (m == "binet") settings.integrator = Render::Integrator::Binet;
+            else {
+                std::cerr << "Unknown integrator " << m << " (expected rk4, dopri5, binet or table)\n";
+                return 1;
+            }
+        }
+        else if (arg == "--precision") {
+            std::string p = val;
+            if (p == "float") settings.precision = Render::Precision::Float;
+            else if (p == "double") settings.precision = Render::Precision::Double;
+            else {
+                std::cerr << "Unknown precision " << p << " (expected float or double)\n";
+                return 1;
+            }
+        }
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (settings.width <= 0 || settings.height <= 0 || settings.tileSize <= 0 || settings.tableSize < 2) {
+        std::cerr << "Width, height and tile size must be positive, table size at least 2\n";
+        return 1;
+    }
+
+    if (!profilePrefix.empty() && (!BLACKHOLE_INSTRUMENT || animate)) {
+        std::cerr << (animate ? "--profile applies to single frames only\n"
+                              : "--profile needs a build configured with -DBLACKHOLE_INSTRUMENT=ON\n");
+        return 1;
+    }
+
+    if (refine && (animate || !profilePrefix.empty() || progressive.baseSpacing < 1)) {
+        std::cerr << "--progressive needs a positive spacing and excludes --frames / --profile\n";
+        return 1;
+    }
+
+    if (antialias && (animate || refine || !profilePrefix.empty() || aa.edgeSamples < 1 || aa.smoothSamples < 1)) {
+        std::cerr << "--aa needs positive sample counts and excludes --frames / --progressive / --profile\n";
+        return 1;
+    }
+
+    if (useWavefront && (animate || refine || antialias || !profilePrefix.empty() || wavefront.stepsPerWave < 1 ||
+                         settings.integrator != Render::Integrator::FixedRK4)) {
+        std::cerr << "--wavefront needs a positive step count and the rk4 integrator, and excludes\n"
+                  << "--frames / --progressive / --aa / --profile\n";
+        return 1;
+    }
+
+    const bool png = anim.format == Render::FrameFormat::PNG;
+    if (useBloom && (!png || animate || refine || bloom.levels < 1 || bloom.radius <= 0.0f)) {
+        std::cerr << "--bloom needs --format png, positive --bloom-levels / --bloom-radius, and excludes\n"
+                  << "--frames / --progressive\n";
+        return 1;
+    }
+
+    ThreadPool pool(threads);
+
+    if (animate) {
+        if (anim.lastFrame < anim.firstFrame || anim.fps <= 0.0 || anim.queueDepth < 1) {
+            std::cerr << "Empty frame range, or non-positive --fps / --queue\n";
+            return 1;
+        }
+        if (!outPath.empty() && !validFramePattern(outPath)) {
+            std::cerr << "--out with --frames needs exactly one %d (e.g. frame_%04d.pfm), got " << outPath << "\n";
+            return 1;
+        }
+
+        Render::CameraPath path;
+        if (!keysPath.empty()) {
+            if (!path.load(keysPath)) return 1;
+            if (path.empty()) {
+                std::cerr << "No keyframes in " << keysPath << "\n";
+                return 1;
+            }
+        } else {
+            path.add({ anim.firstFrame, radius, yaw, pitch, vec3() });
+        }
+
+        anim.timeOffset = settings.time;
+        anim.outPattern = outPath.empty() ? (png ? "frame_%04d.png" : "frame_%04d.pfm") : outPath;
+        int count = anim.lastFrame - anim.firstFrame + 1;
+
+        std::cout << "Rendering frames " << anim.firstFrame << ".." << anim.lastFrame << " at "
+                  << settings.width << "x" << settings.height << " on " << pool.size() << " threads ("
+                  << integratorName(settings.integrator) << ", " << (png ? "png" : "pfm")
+                  << ", queue " << anim.queueDepth << ") → " << anim.outPattern << "\n";
+
+        Render::AnimationStats stats = Render::renderSequence(path, settings, anim, pool);
+
+        std::cout << "Done in " << stats.wallSeconds << " s (" << count / stats.wallSeconds << " frames/s)\n"
+                  << "  trace  " << stats.traceSeconds << " s (" << stats.stallSeconds << " s waiting on queue, "
+                  << stats.traces << " of " << count << " frames re-traced)\n"
+                  << "  encode " << stats.encodeSeconds << " s, write " << stats.writeSeconds << " s\n"
+                  << "  peak frames in flight " << stats.peakFramesInFlight << "\n"
+                  << "Wrote " << stats.framesWritten << " frames";
+        if (stats.failedWrites) std::cout << ", " << stats.failedWrites << " failed";
+        std::cout << "\n";
+        return stats.failedWrites ? 1 : 0;
+    }
+
+    if (outPath.empty()) outPath = png ? "render.png" : "render.pfm";
+    Camera camera(radius, yaw, pitch);
+
+    if (refine) {
+        const double pixels = static_cast<double>(settings.width) * settings.height;
+        std::cout << "Progressive " << settings.width << "x" << settings.height << " from a "
+                  << progressive.baseSpacing << "px grid on " << pool.size() << " threads ("
+                  << integratorName(settings.integrator) << ")...\n";
+
+        auto t0 = std::chrono::steady_clock::now();
+        Image image = Render::renderProgressive(camera, settings, pool, progressive,
+            [&](const Image& img, const Render::ProgressivePass& pass) {
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+                std::printf("  pass %2d  %3dpx  %8ld rays  %5.1f%% traced  %6zu blocks (%zu refining)  %8.1f ms%s\n",
+                            pass.index, pass.spacing, pass.traced, 100.0 * pass.totalTraced / pixels,
+                            pass.blocks, pass.refining, ms, pass.final ? "  [exact]" : "");
+                if (previewPrefix.empty()) return;
+                char suffix[32];
+                std::snprintf(suffix, sizeof(suffix), "_pass%02d.%s", pass.index, png ? "png" : "pfm");
+                std::string file = previewPrefix + suffix;
+                if (png) writePNG(file, Render::toneMap(img, anim.exposure));
+                else writePFM(file, img);
+            });
+
+        bool ok = png ? writePNG(outPath, Render::toneMap(image, anim.exposure)) : writePFM(outPath, image);
+        if (!ok) return 1;
+        std::cout << "Wrote " << outPath << "\n";
+        return 0;
+    }
+
+    std::cout << "Rendering " << settings.width << "x" << settings.height
+              << " on " << pool.size() << " threads ("
+              << (useWavefront ? "wavefront K=" + std::to_string(wavefront.stepsPerWave)
+                               : std::to_string(settings.tileSize) + "px tiles") << ", "
+              << (settings.precision == Render::Precision::Float ? "float" : "double") << ", "
+              << integratorName(settings.integrator) << ")...\n";
+
+    Render::FrameProfile profile;
+    Render::FrameProfile* profiling = profilePrefix.empty() ? nullptr : &profile;
+
+    Render::AAStats aaStats;
+    Physics::WavefrontStats waveStats;
+    auto t0 = std::chrono::steady_clock::now();
+    Image image = antialias    ? Render::renderFrameAA(camera, settings, pool, aa, &aaStats)
+                : useWavefront ? Render::renderFrameWavefront(camera, settings, pool, wavefront, &waveStats)
+                               : Render::renderFrame(camera, settings, pool, nullptr, profiling);
+    auto t1 = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    double rays = static_cast<double>(settings.width) * settings.height;
+    if (antialias) rays *= aaStats.raysPerPixel();
+    std::cout << "Done in " << seconds << " s (" << rays / seconds / 1e6 << " Mrays/s)\n";
+    if (antialias)
+        std::cout << "Anti-aliasing: " << aaStats.raysPerPixel() << " rays/pixel, " << aaStats.edgePixels
+                  << " edge + " << aaStats.smoothPixels << " smooth pixels supersampled"
+                  << (aaStats.budgetDowngrades ? ", " + std::to_string(aaStats.budgetDowngrades) + " cut by budget" : "")
+                  << "\n";
+    if (useWavefront)
+        std::cout << "Wavefront: " << waveStats.lanes << " lanes, " << 100.0 * waveStats.utilization()
+                  << "% lane utilization over " << waveStats.waves << " waves\n";
+
+    if (profiling && !writeProfile(profile, profilePrefix)) return 1;
+
+    LdrImage ldr;
+    if (useBloom) {
+        auto b0 = std::chrono::steady_clock::now();
+        ldr = Render::compositeBloom(image, Render::bloomDualFilter(image, bloom), bloom.strength, anim.exposure);
+        std::cout << "Bloom: " << bloom.levels << " levels in "
+                  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - b0).count() << " ms\n";
+    } else if (png) {
+        ldr = Render::toneMap(image, anim.exposure);
+    }
+
+    bool ok = png ? writePNG(outPath, ldr) : writePFM(outPath, image);
+    if (!ok) return 1;
+    std::cout << "Wrote " << outPath << "\n";
+    return 0;
+}
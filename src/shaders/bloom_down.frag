@@ -0,0 +1,21 @@
+#version 330 core
+
+// Dual-filter bloom, downsample pass: renders the next mip level at
+// half the size of uImage. 5 bilinear taps: the centre and the four
+// diagonals one source texel (× uRadius) out, weighted 4 : 1 : 1 : 1 : 1
+
+in vec2 fragUV;
+out vec4 FragColor;
+
+uniform sampler2D uImage;
+uniform float uRadius;
+
+void main() {
+    vec2 o = uRadius / vec2(textureSize(uImage, 0));
+    vec3 sum = texture(uImage, fragUV).rgb * 4.0;
+    sum += texture(uImage, fragUV + vec2(-o.x, -o.y)).rgb;
+    sum += texture(uImage, fragUV + vec2( o.x, -o.y)).rgb;
+    sum += texture(uImage, fragUV + vec2(-o.x,  o.y)).rgb;
+    sum += texture(uImage, fragUV + vec2( o.x,  o.y)).rgb;
+    FragColor = vec4(sum / 8.0, 1.0);
+}
@@ -9,9 +9,41 @@ uniform sampler2D uScene;
 uniform sampler2D uBloom;
 uniform float uBloomStrength;
 uniform float uExposure;
+uniform bool uUpscale;      // Scene rendered below window resolution (dynamic resolution)
+
+// Catmull-Rom bicubic in 9 bilinear fetches: the weights of the two middle
+// taps per axis share one fetch placed between them. Sharper than plain
+// bilinear when stretching a reduced-resolution scene over the window.
+vec3 sampleCatmullRom(sampler2D tex, vec2 uv) {
+    vec2 size = vec2(textureSize(tex, 0));
+    vec2 pos = uv * size;
+    vec2 t1 = floor(pos - 0.5) + 0.5;
+    vec2 f = pos - t1;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+    vec2 w12 = w1 + w2;
+
+    vec2 p0 = (t1 - 1.0) / size;
+    vec2 p12 = (t1 + w2 / w12) / size;
+    vec2 p3 = (t1 + 2.0) / size;
+
+    vec3 c = texture(tex, vec2(p0.x,  p0.y)).rgb  * w0.x  * w0.y
+           + texture(tex, vec2(p12.x, p0.y)).rgb  * w12.x * w0.y
+           + texture(tex, vec2(p3.x,  p0.y)).rgb  * w3.x  * w0.y
+           + texture(tex, vec2(p0.x,  p12.y)).rgb * w0.x  * w12.y
+           + texture(tex, vec2(p12.x, p12.y)).rgb * w12.x * w12.y
+           + texture(tex, vec2(p3.x,  p12.y)).rgb * w3.x  * w12.y
+           + texture(tex, vec2(p0.x,  p3.y)).rgb  * w0.x  * w3.y
+           + texture(tex, vec2(p12.x, p3.y)).rgb  * w12.x * w3.y
+           + texture(tex, vec2(p3.x,  p3.y)).rgb  * w3.x  * w3.y;
+    return max(c, 0.0);   // The negative lobes can ring below zero next to the shadow edge
+}
 
 void main() {
-    vec3 scene = texture(uScene, fragUV).rgb;
+    vec3 scene = uUpscale ? sampleCatmullRom(uScene, fragUV) : texture(uScene, fragUV).rgb;
     vec3 bloom = texture(uBloom, fragUV).rgb;
 
     // Additive blend
@@ -0,0 +1,24 @@
+#version 330 core
+
+// Dual-filter bloom, upsample pass: renders the next larger mip level
+// from uImage. 8-tap tent: edge taps one source texel (× uRadius) out
+// with weight 1, diagonal taps half a texel out with weight 2
+
+in vec2 fragUV;
+out vec4 FragColor;
+
+uniform sampler2D uImage;
+uniform float uRadius;
+
+void main() {
+    vec2 o = uRadius / vec2(textureSize(uImage, 0));
+    vec3 sum = texture(uImage, fragUV + vec2(-o.x, 0.0)).rgb;
+    sum += texture(uImage, fragUV + vec2( o.x, 0.0)).rgb;
+    sum += texture(uImage, fragUV + vec2(0.0, -o.y)).rgb;
+    sum += texture(uImage, fragUV + vec2(0.0,  o.y)).rgb;
+    sum += texture(uImage, fragUV + vec2(-o.x, -o.y) * 0.5).rgb * 2.0;
+    sum += texture(uImage, fragUV + vec2( o.x, -o.y) * 0.5).rgb * 2.0;
+    sum += texture(uImage, fragUV + vec2(-o.x,  o.y) * 0.5).rgb * 2.0;
+    sum += texture(uImage, fragUV + vec2( o.x,  o.y) * 0.5).rgb * 2.0;
+    FragColor = vec4(sum / 12.0, 1.0);
+}
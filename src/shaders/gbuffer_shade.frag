@@ -0,0 +1,53 @@
+#version 330 core
+
+// ============================================================
+//  Geodesic G-buffer — reshading pass
+//  Rebuilds the HDR scene from cached geodesic end states. Only
+//  uTime-dependent work (disk particles, flicker) runs here, so a
+//  static camera costs a few texel fetches + shading per pixel
+//  instead of up to MAX_STEPS RK4 steps.
+//  Output matches blackhole.frag for the same uniforms.
+// ============================================================
+
+in vec2 fragUV;
+out vec4 FragColor;
+
+uniform sampler2D uGTermination;
+uniform sampler2D uGCrossing0;
+uniform sampler2D uGCrossing1;
+uniform sampler2D uGCrossing2;
+uniform sampler2D uGCrossing3;
+
+#include "geodesic.glsl"
+#include "shading.glsl"
+
+void main() {
+    ivec2 px = ivec2(gl_FragCoord.xy);
+    vec4 termination = texelFetch(uGTermination, px, 0);
+    vec4 crossings[4] = vec4[4](
+        texelFetch(uGCrossing0, px, 0),
+        texelFetch(uGCrossing1, px, 0),
+        texelFetch(uGCrossing2, px, 0),
+        texelFetch(uGCrossing3, px, 0)
+    );
+
+    // Front-to-back compositing of the recorded disk crossings
+    vec3 color = vec3(0.0);
+    float transmittance = 1.0;
+    for (int i = 0; i < QUALITY_DISK_CROSSINGS; i++) {
+        if (crossings[i].w <= 0.0) break;
+        float opacity = crossingOpacity(i + 1);
+        color += transmittance * diskShade(crossings[i].xyz, crossings[i].w, uCamPos) * opacity;
+        transmittance *= (1.0 - opacity);
+    }
+
+    // Whatever is left of the ray
+    if (termination.w == TERM_ESCAPED)
+        color += transmittance * starfield(termination.xyz);
+    else if (termination.w == TERM_MAX_STEPS)
+        color += transmittance * vec3(0.002, 0.001, 0.003);
+
+    color += photonGlow(primaryRayDir(fragUV), uCamPos);
+
+    FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,79 @@
+#version 330 core
+
+// ============================================================
+//  Geodesic G-buffer — trace pass
+//  Same integration as blackhole.frag traceRay(), but instead of
+//  shading it records where each ray ended up. Only runs when the
+//  camera (position, basis, FOV) or the viewport has changed;
+//  gbuffer_shade.frag rebuilds the image from these targets.
+// ============================================================
+
+in vec2 fragUV;
+
+layout(location = 0) out vec4 gTermination;  // xyz: escape direction, w: TERM_* code
+layout(location = 1) out vec4 gCrossing0;    // xyz: disk hit position, w: diskR (0 = none)
+layout(location = 2) out vec4 gCrossing1;
+layout(location = 3) out vec4 gCrossing2;
+layout(location = 4) out vec4 gCrossing3;
+
+#include "geodesic.glsl"
+#include "shading.glsl"
+
+void main() {
+    vec3 pos = uCamPos;
+    vec3 vel = primaryRayDir(fragUV);
+
+    vec4 crossings[4] = vec4[4](vec4(0.0), vec4(0.0), vec4(0.0), vec4(0.0));
+    int diskHits = 0;
+    float transmittance = 1.0;
+    vec4 termination = vec4(0.0, 0.0, 0.0, TERM_MAX_STEPS);
+    bool plunged = plungesPastDisk(pos, vel, length(pos));
+
+    for (int i = 0; i < MAX_STEPS; i++) {
+        float old_y = pos.y;
+        float r = length(pos);
+
+        // --- Capture (or past its last possible disk crossing) ---
+        if (r <= RS || plunged) {
+            termination = vec4(0.0, 0.0, 0.0, TERM_CAPTURED);
+            break;
+        }
+
+        // --- Escape (or bound for it: analytic far-field exit) ---
+        if (r > ESCAPE_R || inFarField(pos, vel, r)) {
+            termination = vec4(farFieldExit(pos, vel), TERM_ESCAPED);
+            break;
+        }
+
+        float dt = stepSizeFor(r);
+        if (nearPhotonSphere(pos, vel, r)) windStep(pos, vel);
+        else stepRK4(pos, vel, dt);
+        float new_y = pos.y;
+
+        // --- Disk crossing ---
+        if ((old_y > 0.0 && new_y <= 0.0) || (old_y < 0.0 && new_y >= 0.0)) {
+            float t_hit = old_y / (old_y - new_y);
+            vec3 hitPos = pos - vel * dt * (1.0 - t_hit);
+            float diskR = length(vec2(hitPos.x, hitPos.z));
+
+            if (diskR >= DISK_INNER && diskR <= DISK_OUTER) {
+                crossings[diskHits] = vec4(hitPos, diskR);
+                diskHits++;
+
+                // Same early-out as traceRay: nothing behind is visible
+                transmittance *= (1.0 - crossingOpacity(diskHits));
+                if (transmittance < 0.01 || diskHits >= QUALITY_DISK_CROSSINGS) {
+                    termination = vec4(0.0, 0.0, 0.0, TERM_OPAQUE);
+                    break;
+                }
+            }
+            plunged = plungesPastDisk(pos, vel, length(pos));
+        }
+    }
+
+    gTermination = termination;
+    gCrossing0 = crossings[0];
+    gCrossing1 = crossings[1];
+    gCrossing2 = crossings[2];
+    gCrossing3 = crossings[3];
+}
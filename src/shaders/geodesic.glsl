@@ -0,0 +1,306 @@
+// ============================================================
+//  geodesic.glsl — shared by every pass that integrates rays
+//  Physics constants, Schwarzschild acceleration, RK4 and the
+//  radius-keyed step heuristic. Pulled in with #include, which
+//  ShaderLibrary resolves before compilation.
+// ============================================================
+
+// --- Quality knobs: Display #defines these per program variant
+//     (core/quality.hpp); the defaults are the "high" preset ---
+#ifndef QUALITY_MAX_STEPS
+#define QUALITY_MAX_STEPS 1000
+#endif
+#ifndef QUALITY_STEP_SCALE
+#define QUALITY_STEP_SCALE 1.0
+#endif
+#ifndef QUALITY_PARTICLE_LAYERS
+#define QUALITY_PARTICLE_LAYERS 8
+#endif
+#ifndef QUALITY_FBM_OCTAVES
+#define QUALITY_FBM_OCTAVES 4
+#endif
+#ifndef QUALITY_DISK_CROSSINGS
+#define QUALITY_DISK_CROSSINGS 4
+#endif
+#ifndef QUALITY_BAKED_STARFIELD
+#define QUALITY_BAKED_STARFIELD 1
+#endif
+#ifndef QUALITY_BAKED_DISK
+#define QUALITY_BAKED_DISK 1
+#endif
+
+// --- Camera / integration uniforms ---
+uniform vec2  uResolution;
+uniform vec3  uCamPos;
+uniform vec3  uCamForward;
+uniform vec3  uCamRight;
+uniform vec3  uCamUp;
+uniform float uFovScale;
+uniform float uStepSize;
+
+// --- Physics Constants ---
+const float M          = 1.0;
+const float RS         = 2.0;
+const float DISK_INNER = 3.0;
+const float DISK_OUTER = 15.0;
+const float ESCAPE_R   = 50.0;
+const int   MAX_STEPS  = QUALITY_MAX_STEPS;
+const float PHOTON_R   = 3.0;
+
+// Termination codes (G-buffer gTermination.w)
+const float TERM_CAPTURED  = 0.0;   // Fell through the horizon
+const float TERM_ESCAPED   = 1.0;   // Left ESCAPE_R; xyz = escape direction
+const float TERM_OPAQUE    = 2.0;   // Disk crossings absorbed the ray
+const float TERM_MAX_STEPS = 3.0;   // Ran out of MAX_STEPS
+
+// ============================================================
+//  Schwarzschild geodesic acceleration
+// ============================================================
+vec3 accel(vec3 pos, vec3 vel) {
+    float r2 = dot(pos, pos);
+    float r  = sqrt(r2);
+    vec3 h   = cross(pos, vel);
+    float h2 = dot(h, h);
+    float r5 = r2 * r2 * r;
+    return pos * (-3.0 * M * h2 / r5);
+}
+
+// ============================================================
+//  RK4 integrator
+// ============================================================
+void stepRK4(inout vec3 pos, inout vec3 vel, float dt) {
+    vec3 k1v = accel(pos, vel);
+    vec3 k1p = vel;
+    vec3 k2v = accel(pos + k1p * (dt * 0.5), vel + k1v * (dt * 0.5));
+    vec3 k2p = vel + k1v * (dt * 0.5);
+    vec3 k3v = accel(pos + k2p * (dt * 0.5), vel + k2v * (dt * 0.5));
+    vec3 k3p = vel + k2v * (dt * 0.5);
+    vec3 k4v = accel(pos + k3p * dt, vel + k3v * dt);
+    vec3 k4p = vel + k3v * dt;
+    vel += (k1v + 2.0 * k2v + 2.0 * k3v + k4v) * (dt / 6.0);
+    pos += (k1p + 2.0 * k2p + 2.0 * k3p + k4p) * (dt / 6.0);
+}
+
+// ============================================================
+//  Far-field exit (physics/far_field.hpp)
+//  Past DISK_OUTER an outbound ray, or an inbound one whose
+//  periapsis lies beyond DISK_OUTER, can only reach the sky.
+//  Its direction on the ESCAPE_R sphere follows from the
+//  conserved A = w² + u² − 2Mu³ (u = 1/r, w = du/dφ) as an
+//  orbit-angle quadrature, instead of hundreds of RK4 steps.
+// ============================================================
+const float FAR_FIELD_BARRIER = (1.0 - 2.0 * M / DISK_OUTER) / (DISK_OUTER * DISK_OUTER);
+
+// 8-point Gauss–Legendre nodes / weights on [-1, 1] (positive half)
+const vec4 GL8_X = vec4(0.1834346425, 0.5255324099, 0.7966664774, 0.9602898565);
+const vec4 GL8_W = vec4(0.3626837834, 0.3137066459, 0.2223810345, 0.1012285363);
+
+bool inFarField(vec3 pos, vec3 vel, float r) {
+    if (r <= DISK_OUTER) return false;
+    if (dot(pos, vel) >= 0.0) return true;
+    vec3 h = cross(pos, vel);
+    float u = 1.0 / r;
+    return dot(vel, vel) < (FAR_FIELD_BARRIER + 2.0 * M * u * u * u) * dot(h, h);
+}
+
+// 8-point Gauss–Legendre of 1 / sqrt(1 − 2μ g(θ)), g = sin θ + 1/(1 + sin θ)
+float periapsisSweep(float mu, float a, float b) {
+    float mid = 0.5 * (a + b), span = 0.5 * (b - a);
+    vec4 s1 = sin(mid - span * GL8_X), s2 = sin(mid + span * GL8_X);
+    vec4 f1 = inversesqrt(1.0 - 2.0 * mu * (s1 + 1.0 / (1.0 + s1)));
+    vec4 f2 = inversesqrt(1.0 - 2.0 * mu * (s2 + 1.0 / (1.0 + s2)));
+    return dot(GL8_W, f1 + f2) * span;
+}
+
+// Escape direction on the ESCAPE_R sphere of a ray with inFarField()
+vec3 farFieldExit(vec3 pos, vec3 vel) {
+    float r = length(pos);
+    vec3 h = cross(pos, vel);
+    float hLen = length(h);
+    if (r >= ESCAPE_R || hLen <= 1e-6 * r * length(vel)) return normalize(vel);
+
+    // Orbital plane: e1 radial, e2 towards the ray
+    vec3 e1 = pos / r;
+    vec3 e2 = normalize(cross(h, e1));
+    float u = 1.0 / r;
+    float w = -u * dot(pos, vel) / hLen;
+    float A = w * w + u * u - 2.0 * M * u * u * u;
+    const float uEnd = 1.0 / ESCAPE_R;
+    float wEnd = -sqrt(max(A - uEnd * uEnd + 2.0 * M * uEnd * uEnd * uEnd, 0.0));
+
+    float phi;
+    const float top = 1.0 / (3.0 * M);
+    if (A >= top * top * (1.0 - 2.0 * M * top)) {
+        // No periapsis: integrate du / sqrt(F) directly
+        float mid = 0.5 * (u + uEnd), span = 0.5 * (u - uEnd);
+        vec4 x1 = mid - span * GL8_X, x2 = mid + span * GL8_X;
+        vec4 f1 = inversesqrt(A - x1 * x1 + 2.0 * M * x1 * x1 * x1);
+        vec4 f2 = inversesqrt(A - x2 * x2 + 2.0 * M * x2 * x2 * x2);
+        phi = dot(GL8_W, f1 + f2) * span;
+    } else {
+        // Periapsis u_p: Newton on u² − 2Mu³ = A, bracketed in [u, 1/3M]
+        float lo = u, hi = top;
+        float up = clamp(sqrt(A) * (1.0 + M * sqrt(A)), lo, hi);
+        for (int i = 0; i < 12; i++) {
+            float f = up * up * (1.0 - 2.0 * M * up) - A;
+            if (f < 0.0) lo = up; else hi = up;
+            float next = up - f / (up * (2.0 - 6.0 * M * up));
+            up = (next > lo && next < hi) ? next : 0.5 * (lo + hi);
+        }
+
+        float mu = M * up;
+        float s0 = min(u / up, 1.0);
+        float c0 = abs(w) / (up * sqrt(1.0 - 2.0 * mu * (s0 + 1.0 / (1.0 + s0))));
+        float theta0 = atan(s0, c0);
+        float st = min(uEnd / up, 1.0);
+        float thetaEnd = atan(st, sqrt((1.0 - st) * (1.0 + st)));
+        const float HALF_PI = 1.5707963268;
+        phi = w <= 0.0 ? periapsisSweep(mu, thetaEnd, theta0)
+                       : periapsisSweep(mu, theta0, HALF_PI) + periapsisSweep(mu, thetaEnd, HALF_PI);
+    }
+
+    vec3 radial = e1 * cos(phi) + e2 * sin(phi);
+    vec3 along = e2 * cos(phi) - e1 * sin(phi);
+    return normalize(radial * -wEnd + along * uEnd);
+}
+
+// ============================================================
+//  Early capture (physics/capture.hpp)
+//  Outside the photon sphere an inbound ray with b < 3√3 M
+//  falls straight in, meeting y = 0 every π of orbit angle.
+//  Once its next crossing lies beyond the angle at which it
+//  drops inside DISK_INNER, it has nothing left to hit. That
+//  angle is a quadrature in u = u_c + √ε sinh t (u_c = 1/3M,
+//  ε = A − 1/27M²), smooth however close to critical.
+// ============================================================
+const float CAPTURE_BARRIER = 1.0 / (27.0 * M * M);
+const int   PLUNGE_PANELS   = 48;   // Unit-width t panels at most
+
+float plungeSweep(float A, float u0, float u1) {
+    const float uc = 1.0 / (3.0 * M);
+    float root = sqrt(max(A - CAPTURE_BARRIER, 1e-12));
+    float t0 = asinh((u0 - uc) / root), t1 = asinh((u1 - uc) / root);
+    int panels = clamp(int(ceil(t1 - t0)), 1, PLUNGE_PANELS);
+    float span = 0.5 * (t1 - t0) / float(panels);
+
+    float phi = 0.0;
+    for (int k = 0; k < PLUNGE_PANELS; k++) {
+        if (k >= panels) break;
+        float mid = t0 + (2.0 * float(k) + 1.0) * span;
+        vec4 ta = mid - span * GL8_X, tb = mid + span * GL8_X;
+        vec4 sa = sinh(ta), sb = sinh(tb);
+        vec4 f1 = cosh(ta) * inversesqrt(1.0 + (2.0 * M * (uc + root * sa) + 1.0 / 3.0) * sa * sa);
+        vec4 f2 = cosh(tb) * inversesqrt(1.0 + (2.0 * M * (uc + root * sb) + 1.0 / 3.0) * sb * sb);
+        phi += dot(GL8_W, f1 + f2) * span;
+    }
+    return phi;
+}
+
+bool plungesPastDisk(vec3 pos, vec3 vel, float r) {
+    if (r <= PHOTON_R || r > ESCAPE_R || dot(pos, vel) >= 0.0) return false;
+    vec3 h = cross(pos, vel);
+    float u = 1.0 / r;
+    if (!(dot(vel, vel) > (CAPTURE_BARRIER + 2.0 * M * u * u * u) * dot(h, h))) return false;
+
+    // Radial rays and rays in the disk plane never register a crossing
+    float hLen = length(h);
+    if (hLen <= 1e-6 * r * length(vel)) return true;
+    vec3 e1 = pos / r;
+    vec3 e2 = normalize(cross(h, e1));
+    if (abs(e1.y) < 1e-6 && abs(e2.y) < 1e-6) return true;
+
+    // Orbit angle to the next y = 0 crossing (OrbitalPlane::firstDiskCrossing)
+    float next = mod(atan(-e1.y, e2.y), 3.14159265359);
+    if (next <= 1e-6) next = 3.14159265359;
+    float A = dot(vel, vel) / (hLen * hLen) - 2.0 * M * u * u * u;
+    return next >= plungeSweep(A, u, 1.0 / DISK_INNER);
+}
+
+// ============================================================
+//  Winding around the photon sphere (physics/photon_sphere.hpp)
+//  Near r = 3M a near-critical ray winds on a one-radian scale
+//  in orbit angle: u = u_c + δ obeys δ'' = δ + 3Mδ². Inside
+//  PHOTON_BAND a near-circular ray takes RK4 steps of up to
+//  WIND_STEP radians on the Binet equation, each clipped to land
+//  exactly on its next y = 0 crossing, instead of the fine
+//  Cartesian steps that used to exhaust MAX_STEPS there.
+// ============================================================
+const float PHOTON_BAND = 1.2 * PHOTON_R;
+const float WIND_STEP   = 0.1;    // Max dφ per winding step (radians)
+const float WIND_SLOPE  = 0.25;   // Near-circular: |cot α| below this
+
+bool nearPhotonSphere(vec3 pos, vec3 vel, float r) {
+    if (r >= PHOTON_BAND) return false;
+    float radial = dot(pos, vel);
+    vec3 h = cross(pos, vel);
+    return radial * radial < WIND_SLOPE * WIND_SLOPE * dot(h, h);
+}
+
+// (u, du/dφ)' for u'' + u = 3Mu²
+vec2 binetRHS(vec2 s) {
+    return vec2(s.y, 3.0 * M * s.x * s.x - s.x);
+}
+
+void windStep(inout vec3 pos, inout vec3 vel) {
+    float r = length(pos);
+    vec3 h = cross(pos, vel);
+    float hLen = length(h);
+    vec3 e1 = pos / r;
+    vec3 e2 = cross(h, e1) / hLen;
+
+    // Next y = 0 crossing in (0, π]: π when starting on the plane
+    float next = WIND_STEP + 1.0;
+    if (abs(e1.y) >= 1e-6 || abs(e2.y) >= 1e-6) {
+        next = mod(atan(-e1.y, e2.y), 3.14159265359);
+        if (next <= 0.0) next = 3.14159265359;
+    }
+    bool landing = next <= WIND_STEP;
+    float dphi = landing ? next : WIND_STEP;
+
+    // RK4 in φ, then one Newton step on w back onto A = w² + u² − 2Mu³
+    float u = 1.0 / r;
+    vec2 s = vec2(u, -u * dot(pos, vel) / hLen);
+    float A = s.y * s.y + s.x * s.x - 2.0 * M * s.x * s.x * s.x;
+    vec2 k1 = binetRHS(s);
+    vec2 k2 = binetRHS(s + k1 * (0.5 * dphi));
+    vec2 k3 = binetRHS(s + k2 * (0.5 * dphi));
+    vec2 k4 = binetRHS(s + k3 * dphi);
+    s += (k1 + 2.0 * k2 + 2.0 * k3 + k4) * (dphi / 6.0);
+    float drift = A - (s.y * s.y + s.x * s.x - 2.0 * M * s.x * s.x * s.x);
+    if (abs(drift) < 0.01 * s.y * s.y) s.y += drift / (2.0 * s.y);
+
+    vec3 radial = e1 * cos(dphi) + e2 * sin(dphi);
+    vec3 along = e2 * cos(dphi) - e1 * sin(dphi);
+    pos = radial / s.x;
+    if (landing) pos.y = 0.0;
+    vel = (radial * -s.y + along * s.x) * hLen;
+}
+
+// ============================================================
+//  Step heuristic: finer near the photon sphere
+// ============================================================
+float stepSizeFor(float r) {
+    float h = uStepSize * QUALITY_STEP_SCALE;
+    if (r < PHOTON_R * 1.2)
+        return h * 0.15;
+    else if (r < PHOTON_R * 2.0)
+        return h * 0.4;
+    else if (r < 10.0)
+        return h * 0.7;
+    return h;
+}
+
+// ============================================================
+//  Primary ray for a fullscreen-quad UV (same as the CPU path)
+// ============================================================
+vec3 primaryRayDir(vec2 uv01) {
+    vec2 uv = uv01 * 2.0 - 1.0;
+    float aspect = uResolution.x / uResolution.y;
+    uv.x *= aspect;
+
+    return normalize(
+        uCamForward +
+        uCamRight * (uv.x * uFovScale) +
+        uCamUp    * (uv.y * uFovScale)
+    );
+}
@@ -0,0 +1,272 @@
+// ============================================================
+//  shading.glsl — disk, starfield and glow shading
+//  Pure functions of a geodesic's end state (plus uTime), so the
+//  G-buffer reshading pass can rerun them without re-tracing.
+// ============================================================
+
+#include "geodesic.glsl"
+
+uniform float uTime;
+uniform samplerCube uStarfield;   // Render::bakeStarfield of starfield() below
+uniform sampler2D uDiskEmission;  // Render::bakeDiskEmission over (φ, r): particles, flicker seed, glow
+uniform vec2 uDiskEmissionRange;  // r of its first and last row edges
+
+// ============================================================
+//  Hash & Noise
+// ============================================================
+float hash(vec2 p) {
+    vec3 p3 = fract(vec3(p.xyx) * 0.1031);
+    p3 += dot(p3, p3.yzx + 33.33);
+    return fract((p3.x + p3.y) * p3.z);
+}
+
+float noise(vec2 p) {
+    vec2 i = floor(p);
+    vec2 f = fract(p);
+    f = f * f * (3.0 - 2.0 * f);
+    return mix(mix(hash(i), hash(i + vec2(1, 0)), f.x),
+               mix(hash(i + vec2(0, 1)), hash(i + vec2(1, 1)), f.x), f.y);
+}
+
+float fbm(vec2 p) {
+    float v = 0.0, a = 0.5;
+    for (int i = 0; i < QUALITY_FBM_OCTAVES; i++) {
+        v += a * noise(p);
+        p *= 2.0;
+        a *= 0.5;
+    }
+    return v;
+}
+
+// ============================================================
+//  M87-matched color ramp
+//  Maps normalized temperature [0,1] to the orange-red palette
+//  observed in EHT imagery
+//
+//  0.0 = deep dark red (outer, coolest)
+//  0.5 = rich orange
+//  0.8 = golden yellow
+//  1.0 = bright yellow-white (inner, hottest)
+// ============================================================
+vec3 m87ColorRamp(float t) {
+    t = clamp(t, 0.0, 1.0);
+
+    // 5-stop gradient matched to M87* EHT palette
+    // Stop 0: very dark red-brown   (0.15, 0.02, 0.0)
+    // Stop 1: deep red              (0.6,  0.08, 0.01)
+    // Stop 2: rich orange           (0.95, 0.35, 0.04)
+    // Stop 3: golden yellow         (1.0,  0.65, 0.12)
+    // Stop 4: yellow-white          (1.0,  0.85, 0.45)
+
+    vec3 c;
+    if (t < 0.25) {
+        float s = t / 0.25;
+        c = mix(vec3(0.15, 0.02, 0.0), vec3(0.6, 0.08, 0.01), s);
+    } else if (t < 0.5) {
+        float s = (t - 0.25) / 0.25;
+        c = mix(vec3(0.6, 0.08, 0.01), vec3(0.95, 0.35, 0.04), s);
+    } else if (t < 0.75) {
+        float s = (t - 0.5) / 0.25;
+        c = mix(vec3(0.95, 0.35, 0.04), vec3(1.0, 0.65, 0.12), s);
+    } else {
+        float s = (t - 0.75) / 0.25;
+        c = mix(vec3(1.0, 0.65, 0.12), vec3(1.0, 0.88, 0.5), s);
+    }
+    return c;
+}
+
+// ============================================================
+//  Starfield — baked into uStarfield once at startup; the
+//  procedural version is what the bake evaluates per texel
+// ============================================================
+vec3 starfield(vec3 dir) {
+#if QUALITY_BAKED_STARFIELD
+    return texture(uStarfield, dir).rgb;
+#else
+    vec2 uv = vec2(atan(dir.z, dir.x), asin(clamp(dir.y, -1.0, 1.0)));
+    vec3 stars = vec3(0.0);
+
+    vec2 g1 = floor(uv * 200.0);
+    float s1 = hash(g1);
+    stars += smoothstep(0.994, 1.0, s1) * mix(vec3(0.6, 0.65, 0.8), vec3(0.9, 0.85, 0.7), hash(g1 + 73.0)) * 0.8;
+
+    vec2 g2 = floor(uv * 500.0);
+    stars += smoothstep(0.997, 1.0, hash(g2)) * vec3(0.3, 0.3, 0.4) * 0.3;
+
+    return stars;
+#endif
+}
+
+// ============================================================
+//  Disk shading — The disk IS flowing particles
+//  Each dot orbits at ω(r) = √(M / r³), colored by M87 gradient.
+//  Angular grid scaled by r to prevent arc-length stretching.
+// ============================================================
+
+// Helper: generate one particle layer
+// rScale = radial grid density
+// aScale = angular grid per unit radius (multiplied by diskR internally)
+float particleLayer(float diskR, float angle, float time,
+                    float rScale, float aScale,
+                    float dotSize, float threshold, float seed) {
+    float omega = sqrt(M / (diskR * diskR * diskR));
+    float flowAngle = angle + time * omega;
+
+    // KEY FIX: angular cells scale with r so dots have uniform arc-length
+    vec2 cell = vec2(diskR * rScale, flowAngle * aScale * diskR);
+    vec2 cellId = floor(cell);
+    vec2 cellUV = fract(cell);
+
+    // Random position within cell (avoids grid artifacts)
+    float rnd = hash(cellId + seed);
+    float rnd2 = hash(cellId + seed + 37.0);
+    vec2 particlePos = vec2(rnd * 0.6 + 0.2, rnd2 * 0.6 + 0.2);
+    vec2 delta = cellUV - particlePos;
+
+    // Uniform small dot
+    float dist = length(delta);
+    float particle = smoothstep(dotSize, dotSize * 0.15, dist);
+
+    // Spawn probability
+    float spawn = smoothstep(threshold, threshold + 0.04, hash(cellId + seed + 71.0));
+
+    // Flicker
+    float flicker = 0.65 + 0.35 * sin(rnd * 50.0 + time * (2.0 + rnd * 3.0));
+
+    return particle * spawn * flicker;
+}
+
+// The same 8 layers + glow from the baked map: one fetch at the
+// co-rotating angle, then each dot's flicker. Inside the ray loop
+// there are no screen-space derivatives, so the mip level comes
+// from the pixel's footprint at the hit instead.
+float bakedDiskDensity(vec3 hitPos, float diskR, float angle, vec3 camPos) {
+    const float TWO_PI = 6.28318530718;
+    float omega = sqrt(M / (diskR * diskR * diskR));
+    float flowAngle = angle + uTime * omega;
+    float span = uDiskEmissionRange.y - uDiskEmissionRange.x;
+    vec2 uv = vec2(flowAngle / TWO_PI + 0.5, (diskR - uDiskEmissionRange.x) / span);
+
+    vec2 size = vec2(textureSize(uDiskEmission, 0));
+    float footprint = distance(hitPos, camPos) * 2.0 * uFovScale / uResolution.y;
+    float texel = max(TWO_PI * diskR / size.x, span / size.y);
+    vec3 e = textureLod(uDiskEmission, uv, log2(max(footprint / texel, 1.0))).rgb;
+
+    float flicker = 0.65 + 0.35 * sin(e.g * 50.0 + uTime * (2.0 + e.g * 3.0));
+    return e.r * flicker + e.b * 0.08;
+}
+
+vec3 diskShade(vec3 hitPos, float diskR, vec3 camPos) {
+
+    float r_ratio  = DISK_INNER / diskR;
+    float tempNorm = pow(r_ratio, 0.75);
+    float angle    = atan(hitPos.z, hitPos.x);
+
+    // --- Doppler beaming ---
+    vec3 radialDir = normalize(vec3(hitPos.x, 0.0, hitPos.z));
+    vec3 orbitDir  = normalize(cross(vec3(0.0, 1.0, 0.0), radialDir));
+    float v_orb    = sqrt(M / diskR);
+    vec3 toCamera  = normalize(camPos - hitPos);
+    float v_dot_n  = dot(orbitDir * v_orb, toCamera);
+    float gamma    = 1.0 / sqrt(max(1.0 - v_orb * v_orb, 0.01));
+    float doppler  = 1.0 / (gamma * (1.0 - v_dot_n));
+
+    float dopplerTemp = clamp(tempNorm * doppler, 0.0, 1.0);
+    vec3 baseColor = m87ColorRamp(dopplerTemp);
+
+#if QUALITY_BAKED_DISK
+    float density = bakedDiskDensity(hitPos, diskR, angle, camPos);
+#else
+    // === BUILD DISK FROM PARTICLES (8 layers, uniform small dots) ===
+    // Each layer's `>= n` is its rank: lower presets keep the body,
+    // then the brightest sparks, then fill-in, and rescale so the
+    // disk keeps its overall brightness.
+    float density = 0.0;
+    float weight = 0.0;
+
+    // Dense base layers (many tiny dots — form the body of the disk)
+#if QUALITY_PARTICLE_LAYERS >= 1
+    density += particleLayer(diskR, angle, uTime, 15.0, 5.0, 0.10, 0.20, 0.0)   * 0.30; weight += 0.30;
+#endif
+#if QUALITY_PARTICLE_LAYERS >= 6
+    density += particleLayer(diskR, angle, uTime, 13.0, 4.5, 0.10, 0.22, 53.0)  * 0.30; weight += 0.30;
+#endif
+#if QUALITY_PARTICLE_LAYERS >= 4
+    density += particleLayer(diskR, angle, uTime, 11.0, 4.0, 0.11, 0.25, 113.0) * 0.35; weight += 0.35;
+#endif
+#if QUALITY_PARTICLE_LAYERS >= 8
+    density += particleLayer(diskR, angle, uTime, 9.0,  3.5, 0.11, 0.28, 197.0) * 0.35; weight += 0.35;
+#endif
+
+    // Medium density layers (visible individual dots)
+#if QUALITY_PARTICLE_LAYERS >= 3
+    density += particleLayer(diskR, angle, uTime, 7.0,  3.0, 0.11, 0.40, 257.0) * 0.45; weight += 0.45;
+#endif
+#if QUALITY_PARTICLE_LAYERS >= 7
+    density += particleLayer(diskR, angle, uTime, 5.5,  2.5, 0.12, 0.45, 337.0) * 0.50; weight += 0.50;
+#endif
+
+    // Sparse bright dots (stand out, bloom catches them)
+#if QUALITY_PARTICLE_LAYERS >= 5
+    density += particleLayer(diskR, angle, uTime, 4.0,  2.0, 0.12, 0.65, 431.0) * 0.70; weight += 0.70;
+#endif
+#if QUALITY_PARTICLE_LAYERS >= 2
+    density += particleLayer(diskR, angle, uTime, 3.0,  1.5, 0.12, 0.80, 619.0) * 1.0;  weight += 1.0;
+#endif
+
+#if QUALITY_PARTICLE_LAYERS > 0 && QUALITY_PARTICLE_LAYERS < 8
+    density *= 3.95 / weight;   // 3.95 = all 8 weights
+#endif
+
+    // Faint diffuse glow underneath
+    float omega = sqrt(M / (diskR * diskR * diskR));
+    float flowAngle = angle + uTime * omega;
+    density += fbm(vec2(diskR * 3.0, flowAngle * 5.0)) * 0.08;
+#endif
+
+    density = clamp(density, 0.0, 2.5);
+
+    // --- Apply color and physics ---
+    vec3 color = baseColor * density;
+
+    float intensity = pow(clamp(doppler, 0.15, 3.5), 3.0);
+    color *= intensity;
+
+    float grav = sqrt(max(1.0 - RS / diskR, 0.0));
+    color *= grav;
+
+    float emission = pow(r_ratio, 1.5);
+    color *= (0.3 + 0.7 * emission);
+
+    float outerFade = smoothstep(DISK_OUTER, DISK_OUTER - 3.0, diskR);
+    float innerFade = smoothstep(DISK_INNER - 0.3, DISK_INNER + 0.5, diskR);
+    color *= outerFade * innerFade;
+
+    return color;
+}
+
+// ============================================================
+//  Post-process: photon sphere glow (HDR values for bloom)
+// ============================================================
+vec3 photonGlow(vec3 rayDir, vec3 camPos) {
+    vec3 cp = cross(camPos, rayDir);
+    float b = length(cp);
+    float shadowR = 2.6 * RS;
+
+    float dist = abs(b - shadowR);
+    // Stronger glow — bloom will spread this
+    float ring = exp(-dist * dist * 2.0) * 0.15;
+    float halo = exp(-dist * 0.3) * 0.03;
+
+    return vec3(1.0, 0.6, 0.2) * (ring + halo);
+}
+
+// ============================================================
+//  Opacity of the n-th disk crossing (1-based); higher-order
+//  crossings (photon ring) are more transparent
+// ============================================================
+float crossingOpacity(int n) {
+    if (n == 1) return 0.85;
+    else if (n == 2) return 0.6;
+    return 0.4;
+}
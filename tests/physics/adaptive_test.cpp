@@ -0,0 +1,150 @@
+#include "physics/adaptive.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for the adaptive Dormand–Prince tracer
+//  Tests: dense output, disk crossings, agreement with the
+//  fixed-step tracer, accuracy and step savings
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+static double maxDiff(const vec3& a, const vec3& b) {
+    return std::max({ std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z) });
+}
+
+int main() {
+    std::cout << "=== Adaptive Integrator Unit Tests ===\n\n";
+
+    // Same oblique ray fan as the batch tests: capture, disk and sky
+    std::vector<Physics::Photon> fan;
+    vec3 cam(0.0, 4.5, 14.0);
+    vec3 fwd = (vec3(0, 0, 0) - cam).normalize();
+    vec3 right = fwd.cross(vec3(0, 1, 0)).normalize();
+    vec3 up = right.cross(fwd);
+    for (int i = 0; i < 37; i++) {
+        double u = -0.9 + 1.8 * i / 36.0;
+        double v = 0.35 * std::sin(i * 0.7);
+        fan.push_back({ cam, (fwd + right * u + up * v).normalize() });
+    }
+
+    // --------------------------------------------------
+    //  Test 1: Dense output hits both endpoints and the
+    //  midpoint of a large step (vs two half steps)
+    // --------------------------------------------------
+    {
+        Physics::PhaseState<double> y{ vec3(6.0, 1.0, 0.0), vec3(0.0, 0.2, 1.0).normalize() };
+        Physics::PhaseState<double> k1 = Physics::geodesicRHS(y);
+        const double h = 1.0;
+
+        Physics::DopriStep<double> full;
+        full.attempt(y, k1, h, 1e-8, 1e-10);
+        Physics::DopriStep<double> half;
+        half.attempt(y, k1, h * 0.5, 1e-8, 1e-10);
+
+        ASSERT_TRUE(maxDiff(full.dense(0.0).pos, y.pos) < 1e-14, "Dense output at theta=0 is the start");
+        ASSERT_TRUE(maxDiff(full.dense(1.0).pos, full.y1.pos) < 1e-12, "Dense output at theta=1 is the end");
+        double midErr = std::max(maxDiff(full.dense(0.5).pos, half.y1.pos),
+                                 maxDiff(full.dense(0.5).vel, half.y1.vel));
+        ASSERT_TRUE(midErr < 1e-6, "Dense output midpoint matches a half step");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Disk hits sit exactly on the y = 0 plane
+    // --------------------------------------------------
+    {
+        Physics::HitRecord hit = Physics::tracePhotonAdaptive(
+            Physics::Photon{ vec3(0.0, 5.0, 10.0), (vec3(0.0, -1.0, -1.2)).normalize() });
+        ASSERT_TRUE(hit.target == Physics::HitTarget::ACCRETION_DISK, "Downward ray hits the disk");
+        ASSERT_NEAR(hit.pos.y, 0.0, 1e-12, "Interpolated crossing lies on y = 0");
+        ASSERT_NEAR(hit.diskR, std::sqrt(hit.pos.x * hit.pos.x + hit.pos.z * hit.pos.z), 1e-12,
+                    "diskR is the radius of the crossing point");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Same classification as the fixed-step tracer
+    // --------------------------------------------------
+    {
+        int mismatched = 0, captured = 0, sky = 0, disk = 0;
+        double worstR = 0.0;
+        for (const auto& p : fan) {
+            Physics::HitRecord ref = Physics::tracePhoton(p);
+            Physics::HitRecord hit = Physics::tracePhotonAdaptive(p);
+            if (ref.target != hit.target) { mismatched++; continue; }
+            if (ref.target == Physics::HitTarget::BLACK_HOLE) captured++;
+            if (ref.target == Physics::HitTarget::BACKGROUND_SKY) sky++;
+            if (ref.target == Physics::HitTarget::ACCRETION_DISK) {
+                disk++;
+                worstR = std::max(worstR, std::abs(ref.diskR - hit.diskR));
+            }
+        }
+        ASSERT_TRUE(mismatched == 0, "Adaptive hit targets match fixed-step tracePhoton");
+        ASSERT_TRUE(captured > 0 && sky > 0 && disk > 0, "Ray fan exercises all three outcomes");
+        // Fixed-step diskR is the post-step point, up to one STEP_SIZE off the plane
+        ASSERT_TRUE(worstR < 2.0 * Physics::STEP_SIZE, "Disk radii agree within the fixed step length");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Converges to a tight-tolerance reference
+    //  with far fewer steps than the fixed-step path
+    // --------------------------------------------------
+    {
+        Physics::AdaptiveSettings tight;
+        tight.rtol = 1e-12;
+        tight.atol = 1e-14;
+
+        double worstR = 0.0, worstDir = 0.0;
+        Physics::TraceStats fixedStats, adaptiveStats;
+        for (const auto& p : fan) {
+            Physics::HitRecord ref = Physics::tracePhotonAdaptive(p, tight);
+            Physics::HitRecord hit = Physics::tracePhotonAdaptive(p, {}, &adaptiveStats);
+            Physics::tracePhoton(p, &fixedStats);
+            if (ref.target != hit.target) { worstR = 1e9; continue; }
+            if (ref.target == Physics::HitTarget::ACCRETION_DISK)
+                worstR = std::max(worstR, std::abs(ref.diskR - hit.diskR));
+            if (ref.target == Physics::HitTarget::BACKGROUND_SKY)
+                worstDir = std::max(worstDir, maxDiff(ref.dir, hit.dir));
+        }
+        ASSERT_TRUE(worstR < 1e-5, "Default tolerance diskR within 1e-5 of reference");
+        ASSERT_TRUE(worstDir < 1e-5, "Default tolerance escape direction within 1e-5 of reference");
+        ASSERT_TRUE(adaptiveStats.steps * 5 < fixedStats.steps, "Adaptive takes < 1/5 of the fixed steps");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: Step budget terminates trapped orbits
+    // --------------------------------------------------
+    {
+        Physics::AdaptiveSettings capped;
+        capped.maxSteps = 3;
+        Physics::TraceStats stats;
+        Physics::HitRecord hit = Physics::tracePhotonAdaptive(
+            Physics::Photon{ vec3(0.0, 0.0, 15.0), vec3(0.0, 0.0, -1.0) }, capped, &stats);
+        ASSERT_TRUE(stats.steps == 3 && hit.target == Physics::HitTarget::BLACK_HOLE,
+                    "Exhausted step budget reports capture");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+#include "physics/adaptive.hpp"
+#include "physics/binet.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for the planar Binet-equation engine
+//  Tests: photon-sphere fixed point, weak-field deflection,
+//  HitRecord agreement with tracePhoton (tilted and edge-on
+//  cameras), step savings
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+int main() {
+    std::cout << "=== Binet Engine Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: u = 1/3M is the circular photon orbit
+    // --------------------------------------------------
+    {
+        Physics::BinetState s{ 1.0 / (3.0 * Physics::M), 0.0 };
+        for (int i = 0; i < 314; i++) Physics::stepBinet(s, Physics::BINET_STEP);
+        ASSERT_NEAR(1.0 / s.u, 3.0, 1e-9, "Photon sphere stays at r = 3M for 2π");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Weak field: a grazing ray bends towards
+    //  the hole by the same angle as in the Cartesian tracer
+    // --------------------------------------------------
+    {
+        Physics::Photon far{ vec3(0.0, 0.0, 19.0), vec3(1.0, 0.0, -0.05).normalize() };
+        Physics::HitRecord hit = Physics::tracePhotonBinet(far);
+        Physics::HitRecord ref = Physics::tracePhoton(far);
+        vec3 in = far.vel.normalize();
+        double bend = std::acos(std::clamp(in.dot(hit.dir), -1.0, 1.0));
+        double refBend = std::acos(std::clamp(in.dot(ref.dir), -1.0, 1.0));
+        ASSERT_TRUE(hit.target == Physics::HitTarget::BACKGROUND_SKY, "Grazing far ray escapes");
+        ASSERT_TRUE(hit.dir.z < in.z, "Ray bends towards the hole");
+        ASSERT_NEAR(bend, refBend, 2e-3, "Deflection matches the Cartesian tracer");
+    }
+
+    // Oblique ray fan (capture, disk and sky)
+    std::vector<Physics::Photon> fan;
+    vec3 cam(0.0, 4.5, 14.0);
+    vec3 fwd = (vec3(0, 0, 0) - cam).normalize();
+    vec3 right = fwd.cross(vec3(0, 1, 0)).normalize();
+    vec3 up = right.cross(fwd);
+    for (int y = 0; y < 12; y++) {
+        for (int x = 0; x < 24; x++) {
+            double u = -0.9 + 1.8 * x / 23.0;
+            double v = -0.6 + 1.2 * y / 11.0;
+            fan.push_back({ cam, (fwd + right * u + up * v).normalize() });
+        }
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Same HitRecords as the Cartesian tracer
+    // --------------------------------------------------
+    {
+        int mismatched = 0, captured = 0, sky = 0, disk = 0;
+        double worstR = 0.0, worstDir = 0.0, worstY = 0.0;
+        for (const auto& p : fan) {
+            Physics::HitRecord ref = Physics::tracePhoton(p);
+            Physics::HitRecord hit = Physics::tracePhotonBinet(p);
+            if (ref.target != hit.target) { mismatched++; continue; }
+            if (ref.target == Physics::HitTarget::BLACK_HOLE) captured++;
+            if (ref.target == Physics::HitTarget::BACKGROUND_SKY) {
+                sky++;
+                worstDir = std::max(worstDir, (ref.dir - hit.dir).length());
+            }
+            if (ref.target == Physics::HitTarget::ACCRETION_DISK) {
+                disk++;
+                worstR = std::max(worstR, std::abs(ref.diskR - hit.diskR));
+                worstY = std::max(worstY, std::abs(hit.pos.y));
+            }
+        }
+        ASSERT_TRUE(captured > 0 && sky > 0 && disk > 0, "Fan exercises all three outcomes");
+        ASSERT_TRUE(mismatched * 50 < static_cast<int>(fan.size()), "Binet classification matches for > 98% of rays");
+        // Fixed-step diskR is the post-step point, up to one STEP_SIZE off the plane
+        ASSERT_TRUE(worstR < 2.0 * Physics::STEP_SIZE, "Disk radii agree within the fixed step length");
+        ASSERT_TRUE(worstDir < 1e-2, "Escape directions agree");
+        ASSERT_TRUE(worstY == 0.0, "Binet disk hits sit on y = 0");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Accuracy vs a tight adaptive reference, in
+    //  far fewer steps than the Cartesian tracer
+    // --------------------------------------------------
+    {
+        Physics::AdaptiveSettings tight;
+        tight.rtol = 1e-12;
+        tight.atol = 1e-14;
+        double worstR = 0.0;
+        Physics::TraceStats cartesian, binet;
+        for (const auto& p : fan) {
+            Physics::HitRecord ref = Physics::tracePhotonAdaptive(p, tight);
+            Physics::HitRecord hit = Physics::tracePhotonBinet(p, &binet);
+            Physics::tracePhoton(p, &cartesian);
+            if (ref.target == Physics::HitTarget::ACCRETION_DISK && hit.target == ref.target)
+                worstR = std::max(worstR, std::abs(ref.diskR - hit.diskR));
+        }
+        ASSERT_TRUE(worstR < 1e-3, "Binet diskR within 1e-3 of the reference");
+        ASSERT_TRUE(binet.steps * 2 < cartesian.steps, "Binet takes < 1/2 of the Cartesian steps");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: Radial rays
+    // --------------------------------------------------
+    {
+        Physics::HitRecord in = Physics::tracePhotonBinet({ cam, fwd });
+        Physics::HitRecord out = Physics::tracePhotonBinet({ cam, fwd * -1.0 });
+        ASSERT_TRUE(in.target == Physics::HitTarget::BLACK_HOLE, "Radial infall captured");
+        ASSERT_TRUE(out.target == Physics::HitTarget::BACKGROUND_SKY, "Radial outward ray escapes");
+    }
+
+    // --------------------------------------------------
+    //  Test 6: Edge-on camera (pitch 0): every orbital
+    //  plane starts on y = 0, rays pointing down still
+    //  meet the disk half an orbit later
+    // --------------------------------------------------
+    {
+        vec3 flat(0.0, 0.0, 15.0);
+        vec3 flatFwd = (vec3(0, 0, 0) - flat).normalize();
+        vec3 flatRight = flatFwd.cross(vec3(0, 1, 0)).normalize();
+        vec3 flatUp = flatRight.cross(flatFwd);
+        int mismatched = 0, total = 0, downDisk = 0;
+        double worstR = 0.0;
+        for (int y = 0; y < 12; y++) {
+            for (int x = 0; x < 24; x++) {
+                double u = -0.9 + 1.8 * x / 23.0;
+                double v = -0.6 + 1.2 * y / 11.0;
+                Physics::Photon p{ flat, (flatFwd + flatRight * u + flatUp * v).normalize() };
+                Physics::HitRecord ref = Physics::tracePhoton(p);
+                Physics::HitRecord hit = Physics::tracePhotonBinet(p);
+                total++;
+                if (ref.target != hit.target) { mismatched++; continue; }
+                if (ref.target == Physics::HitTarget::ACCRETION_DISK) {
+                    downDisk += p.vel.y < 0.0;
+                    worstR = std::max(worstR, std::abs(ref.diskR - hit.diskR));
+                }
+            }
+        }
+        ASSERT_TRUE(downDisk > 0, "Pitch 0: downward rays hit the disk");
+        ASSERT_TRUE(mismatched * 50 < total, "Pitch 0: classification matches for > 98% of rays");
+        ASSERT_TRUE(worstR < 2.0 * Physics::STEP_SIZE, "Pitch 0: disk radii agree within the fixed step length");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
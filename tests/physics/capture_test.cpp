@@ -0,0 +1,177 @@
+#include "physics/binet.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for early capture
+//  Tests: plunge sweep vs fine Binet RK4, winding near b_crit,
+//  plungesPastDisk cases, close-up frame vs the fully stepped
+//  loop, shadow step cost
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+// tracePhoton without early capture or far-field exit: RK4 (winding steps
+// near r = 3M) until r <= RS, r > ESCAPE_RADIUS or a disk hit
+static Physics::HitRecord traceStepped(Physics::Photon p, Physics::TraceStats* stats) {
+    while (true) {
+        double old_y = p.pos.y;
+        double r = p.pos.length();
+        if (r <= Physics::RS) return { Physics::HitTarget::BLACK_HOLE, p.pos, p.vel };
+        if (r > Physics::ESCAPE_RADIUS) return { Physics::HitTarget::BACKGROUND_SKY, p.pos, p.vel.normalize() };
+        if (Physics::nearPhotonSphere(p, r)) Physics::windStep(p);
+        else Physics::stepRK4(p, Physics::STEP_SIZE);
+        stats->steps++;
+        if ((old_y > 0.0 && p.pos.y <= 0.0) || (old_y < 0.0 && p.pos.y >= 0.0)) {
+            double radius = std::sqrt(p.pos.x * p.pos.x + p.pos.z * p.pos.z);
+            if (radius >= Physics::DISK_INNER && radius <= Physics::DISK_OUTER)
+                return { Physics::HitTarget::ACCRETION_DISK, p.pos, p.vel.normalize(), radius };
+        }
+    }
+}
+
+// Binet RK4 at dφ = 1e-3 from u0 inward to u1, Newton steps onto it
+static double sweepStepped(double A, double u0, double u1) {
+    Physics::BinetState s{ u0, std::sqrt(A - u0 * u0 + 2.0 * Physics::M * u0 * u0 * u0) };
+    double phi = 0.0;
+    while (s.u < u1) {
+        Physics::stepBinet(s, 1e-3);
+        phi += 1e-3;
+    }
+    for (int i = 0; i < 3; i++) {
+        double back = (u1 - s.u) / s.w;
+        Physics::stepBinet(s, back);
+        phi += back;
+    }
+    return phi;
+}
+
+int main() {
+    std::cout << "=== Early Capture Unit Tests ===\n\n";
+
+    const double critical = 1.0 / (27.0 * Physics::M * Physics::M);
+
+    // --------------------------------------------------
+    //  Test 1: Plunge sweep vs fine RK4 in φ, from far
+    //  below critical to 1e-6 of it
+    // --------------------------------------------------
+    {
+        double worst = 0.0;
+        for (double eps : { 1e-1, 1e-2, 1e-4, 1e-6 })
+            for (double u1 : { 1.0 / 3.0, 1.0 / Physics::DISK_INNER, 1.0 / Physics::RS }) {
+                double A = critical + eps;
+                worst = std::max(worst, std::abs(Physics::plungeSweep(A, 1.0 / 15.0, u1, Physics::M) -
+                                                 sweepStepped(A, 1.0 / 15.0, u1)));
+            }
+        ASSERT_NEAR(worst, 0.0, 1e-9, "Plunge angle within 1e-9 rad of RK4");
+        ASSERT_TRUE(Physics::plungeSweep(critical + 0.1, 0.1, 0.2, Physics::M) ==
+                    Physics::plungeSweep(critical + 0.1, 0.2, 0.1, Physics::M), "Symmetric in its limits");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Near b_crit the winding grows as ln(1/ε):
+    //  100× closer adds ln 100 of orbit angle across u_c
+    // --------------------------------------------------
+    {
+        bool logarithmic = true;
+        for (double eps : { 1e-6, 1e-8, 1e-10 }) {
+            double a = Physics::plungeSweep(critical + eps, 0.1, 0.5, Physics::M);
+            double b = Physics::plungeSweep(critical + eps / 100.0, 0.1, 0.5, Physics::M);
+            logarithmic = logarithmic && std::isfinite(b) && std::abs(b - a - std::log(100.0)) < 1e-3;
+        }
+        ASSERT_TRUE(logarithmic, "φ(ε/100) − φ(ε) = ln 100");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Which rays plungesPastDisk takes
+    // --------------------------------------------------
+    {
+        const vec3 cam(0.0, 0.0, 15.0);
+        Physics::Photon equatorial{ cam, vec3(0.2, 0.0, -1.0) };                 // b ≈ 2.9, stays on y = 0
+        Physics::Photon steep{ vec3(0.0, 6.0, 14.0), vec3(0.0, -6.0, -14.0) };   // Radial
+        Physics::Photon crossing{ vec3(0.0, 0.5, 15.0), vec3(0.0, -0.2, -1.0) }; // Crosses at r ≈ 12
+        Physics::Photon polar{ vec3(0.0, 0.5, 15.0), vec3(0.0, 0.32, -1.0) };    // b ≈ 5.05: over the pole onto the disk
+        Physics::Photon steeper{ vec3(0.0, 0.5, 15.0), vec3(0.0, 0.3, -1.0) };   // b ≈ 4.79: falls in first
+        Physics::Photon wide{ cam, vec3(0.6, 0.1, -1.0) };                        // b ≈ 7.6 > b_crit
+        Physics::Photon outbound{ cam, vec3(0.2, 0.1, 1.0) };
+        Physics::Photon inside{ vec3(0.0, 0.5, 2.9), vec3(0.0, -0.1, -1.0) };
+        auto plunges = [](const Physics::Photon& p) { return Physics::plungesPastDisk(p, p.pos.length()); };
+        ASSERT_TRUE(plunges(equatorial) && plunges(steep), "Disk-plane and radial infall: no crossings to wait for");
+        ASSERT_TRUE(plunges(steeper) && Physics::tracePhoton(polar).target == Physics::HitTarget::ACCRETION_DISK,
+                    "Below DISK_INNER before the far-side crossing");
+        ASSERT_TRUE(!plunges(crossing) && !plunges(polar), "Crossings ahead above DISK_INNER: keep integrating");
+        ASSERT_TRUE(!plunges(wide) && !plunges(outbound) && !plunges(inside),
+                    "Super-critical, outbound, inside r = 3M: not classified");
+    }
+
+    // Close-up frame: camera just above the disk at r ≈ 7, ~100° FOV
+    vec3 cam(0.0, 1.2, 7.0);
+    vec3 fwd = (vec3(0, 0, 0) - cam).normalize();
+    vec3 right = fwd.cross(vec3(0, 1, 0)).normalize();
+    vec3 up = right.cross(fwd);
+    std::vector<Physics::Photon> frame;
+    for (int y = 0; y < 30; y++)
+        for (int x = 0; x < 40; x++) {
+            double u = -1.2 + 2.4 * (x + 0.5) / 40.0;
+            double v = -0.9 + 1.8 * (y + 0.5) / 30.0;
+            frame.push_back({ cam, (fwd + right * u + up * v).normalize() });
+        }
+
+    // --------------------------------------------------
+    //  Test 4: Same image as the fully stepped loop;
+    //  shadow rays cost next to nothing
+    // --------------------------------------------------
+    {
+        int mismatched = 0, captured = 0, disk = 0, free = 0;
+        double worstDisk = 0.0;
+        Physics::TraceStats fast, stepped, shadowFast, shadowStepped;
+        for (const Physics::Photon& p : frame) {
+            Physics::TraceStats f, s;
+            Physics::HitRecord hit = Physics::tracePhoton(p, &f);
+            Physics::HitRecord ref = traceStepped(p, &s);
+            fast.steps += f.steps;
+            stepped.steps += s.steps;
+            if (hit.target != ref.target) { mismatched++; continue; }
+            if (hit.target == Physics::HitTarget::ACCRETION_DISK) {
+                disk++;
+                worstDisk = std::max(worstDisk, std::abs(hit.diskR - ref.diskR));
+            }
+            if (hit.target == Physics::HitTarget::BLACK_HOLE) {
+                captured++;
+                free += f.steps == 0;
+                shadowFast.steps += f.steps;
+                shadowStepped.steps += s.steps;
+            }
+        }
+        std::cout << "  Close-up frame: " << stepped.steps << " → " << fast.steps << " RK4 steps ("
+                  << shadowStepped.steps << " → " << shadowFast.steps << " in the shadow)\n";
+        ASSERT_TRUE(captured > 0 && disk > 0 && mismatched == 0, "Same targets as the stepped loop");
+        ASSERT_NEAR(worstDisk, 0.0, 1e-12, "Disk hits untouched");
+        ASSERT_TRUE(free > 0, "Some shadow rays take no steps at all");
+        ASSERT_TRUE(shadowFast.steps * 5 < shadowStepped.steps, "Shadow rays take < 1/5 of their steps");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+#include "physics/binet.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for the far-field exit
+//  Tests: quadrature vs the weak-field deflection series,
+//  periapsis and sweep vs fine Binet RK4, tracePhoton exits vs
+//  the fully stepped loop, far-field criterion, step savings
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+// tracePhoton as it was before the far-field exit: RK4 all the way out,
+// plus Newton steps back onto the escape sphere
+static Physics::HitRecord traceStepped(Physics::Photon p, Physics::TraceStats* stats) {
+    while (true) {
+        double old_y = p.pos.y;
+        double r = p.pos.length();
+        if (r <= Physics::RS) return { Physics::HitTarget::BLACK_HOLE, p.pos, p.vel };
+        if (r > Physics::ESCAPE_RADIUS) {
+            for (int i = 0; i < 3; i++)
+                Physics::stepRK4(p, (Physics::ESCAPE_RADIUS - p.pos.length()) * p.pos.length() / p.pos.dot(p.vel));
+            return { Physics::HitTarget::BACKGROUND_SKY, p.pos, p.vel.normalize() };
+        }
+        Physics::stepRK4(p, Physics::STEP_SIZE);
+        stats->steps++;
+        if ((old_y > 0.0 && p.pos.y <= 0.0) || (old_y < 0.0 && p.pos.y >= 0.0)) {
+            double radius = std::sqrt(p.pos.x * p.pos.x + p.pos.z * p.pos.z);
+            if (radius >= Physics::DISK_INNER && radius <= Physics::DISK_OUTER)
+                return { Physics::HitTarget::ACCRETION_DISK, p.pos, p.vel.normalize(), radius };
+        }
+    }
+}
+
+// Binet RK4 at dφ = 1e-3 out to uEnd, Newton steps back onto it
+static Physics::FarFieldSweep sweepStepped(double u, double w, double uEnd) {
+    Physics::BinetState s{ u, w };
+    double phi = 0.0;
+    while (s.u > uEnd) {
+        Physics::stepBinet(s, 1e-3);
+        phi += 1e-3;
+    }
+    for (int i = 0; i < 3; i++) {
+        double back = (uEnd - s.u) / s.w;
+        Physics::stepBinet(s, back);
+        phi += back;
+    }
+    return { phi, s.w };
+}
+
+int main() {
+    std::cout << "=== Far-Field Exit Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: From and to infinity the quadrature is the
+    //  weak-field series; the residual is its next term,
+    //  (3584/5)(M/b)⁵
+    // --------------------------------------------------
+    {
+        bool bounded = true;
+        for (double b : { 12.0, 20.0, 50.0, 200.0, 1000.0 }) {
+            double e = Physics::M / b;
+            double exact = Physics::farFieldSweep(0.0, 1.0 / b, 0.0, Physics::M).phi - M_PI;
+            double series = Physics::weakFieldDeflection(b, Physics::M);
+            bounded = bounded && std::abs(exact - series) < 1200.0 * std::pow(e, 5) &&
+                      std::abs(exact - series) > 600.0 * std::pow(e, 5);
+        }
+        ASSERT_TRUE(bounded, "Deflection − series within (600, 1200) × (M/b)⁵");
+        ASSERT_NEAR(Physics::farFieldSweep(0.0, 1e-5, 0.0, Physics::M).phi - M_PI, 4e-5, 2e-9,
+                    "Leading term 4M/b");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Periapsis is the root of F, inside the
+    //  photon sphere bracket; none below b = 3√3 M
+    // --------------------------------------------------
+    {
+        bool roots = true;
+        for (double b : { 5.3, 6.0, 12.0, 40.0 }) {
+            double A = 1.0 / (b * b);
+            double up = Physics::periapsisU(A, 0.01, Physics::M);
+            roots = roots && up > 0.01 && up < 1.0 / 3.0 &&
+                    std::abs(up * up * (1.0 - 2.0 * up) - A) < 1e-15;
+        }
+        ASSERT_TRUE(roots, "u_p² − 2Mu_p³ = 1/b²");
+        ASSERT_TRUE(Physics::periapsisU(1.0 / (5.1 * 5.1), 0.01, Physics::M) < 0.0, "b < 3√3 M: no periapsis");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Error bound of the sweep vs fine RK4 in φ,
+    //  outbound (incl. just past periapsis and without one)
+    //  and inbound through a periapsis past DISK_OUTER
+    // --------------------------------------------------
+    {
+        const double uEnd = 1.0 / Physics::ESCAPE_RADIUS;
+        double worstPhi = 0.0, worstW = 0.0;
+        int cases = 0;
+        for (double r : { 12.5, 15.0, 19.0 }) {
+            double u = 1.0 / r;
+            for (double w : { -0.3, -0.05, -0.01, -1e-6, 0.0, 0.004, 0.02 }) {
+                double A = w * w + u * u - 2.0 * u * u * u;
+                if (w > 0.0 && A >= Physics::FAR_FIELD_BARRIER) continue;   // Would come inside DISK_OUTER
+                Physics::FarFieldSweep fast = Physics::farFieldSweep(u, w, uEnd, Physics::M);
+                Physics::FarFieldSweep ref = sweepStepped(u, w, uEnd);
+                worstPhi = std::max(worstPhi, std::abs(fast.phi - ref.phi));
+                worstW = std::max(worstW, std::abs(fast.w - ref.w));
+                cases++;
+            }
+        }
+        ASSERT_TRUE(cases >= 15, "Outbound and inbound starts covered");
+        ASSERT_NEAR(worstPhi, 0.0, 1e-12, "Sweep angle within 1e-12 rad of RK4");
+        ASSERT_NEAR(worstW, 0.0, 1e-14, "Exit du/dφ within 1e-14 of RK4");
+    }
+
+    // Wide-FOV frame (~110°) from outside the disk
+    vec3 cam(0.0, 3.0, 18.0);
+    vec3 fwd = (vec3(0, 0, 0) - cam).normalize();
+    vec3 right = fwd.cross(vec3(0, 1, 0)).normalize();
+    vec3 up = right.cross(fwd);
+    std::vector<Physics::Photon> frame;
+    for (int y = 0; y < 24; y++)
+        for (int x = 0; x < 32; x++) {
+            double u = -1.4 + 2.8 * (x + 0.5) / 32.0;
+            double v = -1.05 + 2.1 * (y + 0.5) / 24.0;
+            frame.push_back({ cam, (fwd + right * u + up * v).normalize() });
+        }
+
+    // --------------------------------------------------
+    //  Test 4: tracePhoton exits land on the escape sphere
+    //  and agree with the fully stepped loop; no ray
+    //  changes target
+    // --------------------------------------------------
+    {
+        int mismatched = 0, sky = 0, disk = 0;
+        double worstStepped = 0.0, worstSphere = 0.0, worstDisk = 0.0;
+        for (const Physics::Photon& p : frame) {
+            Physics::TraceStats st;
+            Physics::HitRecord hit = Physics::tracePhoton(p);
+            Physics::HitRecord ref = traceStepped(p, &st);
+            if (hit.target != ref.target) { mismatched++; continue; }
+            if (hit.target == Physics::HitTarget::ACCRETION_DISK) {
+                disk++;
+                worstDisk = std::max(worstDisk, std::abs(hit.diskR - ref.diskR));
+            }
+            if (hit.target != Physics::HitTarget::BACKGROUND_SKY) continue;
+            sky++;
+            worstSphere = std::max(worstSphere, std::abs(hit.pos.length() - Physics::ESCAPE_RADIUS));
+            worstStepped = std::max(worstStepped, (hit.dir - ref.dir).length());
+        }
+        ASSERT_TRUE(sky > 0 && disk > 0 && mismatched == 0, "Same targets as the stepped loop");
+        ASSERT_NEAR(worstDisk, 0.0, 1e-12, "Disk hits untouched");
+        ASSERT_NEAR(worstSphere, 0.0, 1e-9, "Sky hits sit on ESCAPE_RADIUS");
+        ASSERT_NEAR(worstStepped, 0.0, 1e-9, "Escape directions match the stepped loop");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: The far-field test never fires for a ray
+    //  that would still reach DISK_OUTER
+    // --------------------------------------------------
+    {
+        bool safe = true;
+        int fired = 0;
+        for (const Physics::Photon& p0 : frame) {
+            Physics::Photon p = p0;
+            bool far = false;
+            double minR = Physics::ESCAPE_RADIUS;
+            for (double r = p.pos.length(); r > Physics::RS && r <= Physics::ESCAPE_RADIUS; r = p.pos.length()) {
+                far = far || Physics::inFarField(p, r);
+                if (far) minR = std::min(minR, r);
+                Physics::stepRK4(p, Physics::STEP_SIZE);
+            }
+            fired += far;
+            safe = safe && (!far || minR > Physics::DISK_OUTER);
+        }
+        ASSERT_TRUE(fired > 0, "Far field reached");
+        ASSERT_TRUE(safe, "Once in the far field, a ray stays outside DISK_OUTER");
+        Physics::Photon grazing{ vec3(0.0, 0.0, 18.0), vec3(1.0, 0.0, -1.5).normalize() };
+        ASSERT_TRUE(!Physics::inFarField(grazing, grazing.pos.length()), "Inbound ray with periapsis < DISK_OUTER");
+        Physics::Photon passing{ vec3(0.0, 0.0, 18.0), vec3(1.0, 0.0, -0.2).normalize() };
+        ASSERT_TRUE(Physics::inFarField(passing, passing.pos.length()), "Inbound ray passing outside DISK_OUTER");
+    }
+
+    // --------------------------------------------------
+    //  Test 6: Most of a wide-FOV frame's steps are gone;
+    //  float rays take the same exits
+    // --------------------------------------------------
+    {
+        Physics::TraceStats fast, stepped;
+        double worstFloat = 0.0;
+        for (const Physics::Photon& p : frame) {
+            Physics::HitRecord hit = Physics::tracePhoton(p, &fast);
+            traceStepped(p, &stepped);
+            Physics::BasicHitRecord<float> hf = Physics::tracePhoton(Physics::BasicPhoton<float>{ fvec3(p.pos), fvec3(p.vel) });
+            if (hit.target == Physics::HitTarget::BACKGROUND_SKY && hf.target == hit.target)
+                worstFloat = std::max(worstFloat, (hit.dir - vec3(hf.dir)).length());
+        }
+        std::cout << "  Wide-FOV frame: " << stepped.steps << " → " << fast.steps << " RK4 steps\n";
+        ASSERT_TRUE(fast.steps * 2 < stepped.steps, "Under half the stepped loop's steps");
+        ASSERT_NEAR(worstFloat, 0.0, 1e-4, "Float exits match double");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
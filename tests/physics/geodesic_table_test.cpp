@@ -0,0 +1,155 @@
+#include "physics/geodesic_table.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for the symmetry-reduced geodesic table
+//  Tests: orbital-plane geometry, analytic crossings, table
+//  lookups vs per-pixel tracePhoton, reuse across yaw
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+// Camera fan over a grid of directions around `cam` looking at the origin
+static std::vector<vec3> rayFan(const vec3& cam, int nx, int ny) {
+    vec3 fwd = (vec3(0, 0, 0) - cam).normalize();
+    vec3 right = fwd.cross(vec3(0, 1, 0)).normalize();
+    vec3 up = right.cross(fwd);
+    std::vector<vec3> dirs;
+    for (int y = 0; y < ny; y++) {
+        for (int x = 0; x < nx; x++) {
+            double u = -0.9 + 1.8 * x / (nx - 1);
+            double v = -0.6 + 1.2 * y / (ny - 1);
+            dirs.push_back((fwd + right * u + up * v).normalize());
+        }
+    }
+    return dirs;
+}
+
+int main() {
+    std::cout << "=== Geodesic Table Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: Orbital plane reproduces the ray and the
+    //  analytic crossing lies on y = 0
+    // --------------------------------------------------
+    {
+        vec3 cam(3.0, 4.5, 13.0);
+        vec3 dir = vec3(-0.2, -0.3, -1.0).normalize();
+        Physics::OrbitalPlane plane = Physics::makeOrbitalPlane(cam, dir);
+
+        vec3 rebuilt = plane.direction(plane.alpha);
+        ASSERT_TRUE((rebuilt - dir).length() < 1e-12, "Ray = cos(α) e1 + sin(α) e2");
+        ASSERT_NEAR(plane.e1.dot(plane.e2), 0.0, 1e-12, "Plane basis is orthogonal");
+
+        double phi0 = plane.firstDiskCrossing();
+        ASSERT_TRUE(phi0 > 0.0 && phi0 <= M_PI, "First crossing in (0, π]");
+        ASSERT_NEAR(plane.point(7.0, phi0).y, 0.0, 1e-12, "φ0 lies on the disk plane");
+        ASSERT_NEAR(plane.point(7.0, phi0 + M_PI).y, 0.0, 1e-12, "φ0 + π lies on the disk plane");
+
+        // Edge-on camera (e1.y = +0): a ray pointing down meets the plane again at π
+        Physics::OrbitalPlane edgeOn = Physics::makeOrbitalPlane(vec3(0.0, 0.0, 15.0), vec3(0.1, -0.3, -1.0));
+        ASSERT_NEAR(edgeOn.firstDiskCrossing(), M_PI, 1e-12, "Edge-on camera, ray pointing down: φ0 = π");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Table lookups agree with per-pixel tracing
+    // --------------------------------------------------
+    vec3 cam(0.0, 4.5, 14.0);
+    Physics::GeodesicTable table;
+    table.build(cam.length(), 2048);
+    std::vector<vec3> dirs = rayFan(cam, 24, 16);
+    {
+        int mismatched = 0, captured = 0, sky = 0, disk = 0;
+        double worstR = 0.0, worstDir = 0.0, worstY = 0.0;
+        for (const vec3& d : dirs) {
+            Physics::HitRecord ref = Physics::tracePhoton(Physics::Photon{ cam, d });
+            Physics::HitRecord hit = table.lookup(cam, d);
+            if (ref.target != hit.target) { mismatched++; continue; }
+            if (ref.target == Physics::HitTarget::BLACK_HOLE) captured++;
+            if (ref.target == Physics::HitTarget::BACKGROUND_SKY) {
+                sky++;
+                worstDir = std::max(worstDir, (ref.dir - hit.dir).length());
+            }
+            if (ref.target == Physics::HitTarget::ACCRETION_DISK) {
+                disk++;
+                worstR = std::max(worstR, std::abs(ref.diskR - hit.diskR));
+                worstY = std::max(worstY, std::abs(hit.pos.y));
+            }
+        }
+        ASSERT_TRUE(captured > 0 && sky > 0 && disk > 0, "Fan exercises all three outcomes");
+        ASSERT_TRUE(mismatched * 50 < static_cast<int>(dirs.size()), "Table classification matches for > 98% of rays");
+        // Fixed-step diskR is the post-step point, up to one STEP_SIZE off the plane
+        ASSERT_TRUE(worstR < 2.0 * Physics::STEP_SIZE, "Disk radii agree within the fixed step length");
+        ASSERT_TRUE(worstDir < 1e-2, "Escape directions agree");
+        ASSERT_TRUE(worstY == 0.0, "Table disk hits sit on y = 0");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Same table serves any camera at that radius
+    // --------------------------------------------------
+    {
+        // Rotate the camera 90° about the spin axis: same r0, same table
+        vec3 cam2(14.0, 4.5, 0.0);
+        int mismatched = 0;
+        for (const vec3& d : rayFan(cam2, 24, 16)) {
+            if (Physics::tracePhoton(Physics::Photon{ cam2, d }).target != table.lookup(cam2, d).target)
+                mismatched++;
+        }
+        ASSERT_TRUE(mismatched * 50 < static_cast<int>(dirs.size()), "Table is yaw-invariant");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Radial rays: inward captured, outward escapes
+    // --------------------------------------------------
+    {
+        vec3 inward = (vec3(0, 0, 0) - cam).normalize();
+        ASSERT_TRUE(table.lookup(cam, inward).target == Physics::HitTarget::BLACK_HOLE, "Radial infall captured");
+        ASSERT_TRUE(table.lookup(cam, inward * -1.0).target == Physics::HitTarget::BACKGROUND_SKY,
+                    "Radial outward ray escapes");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: Edge-on camera (pitch 0): rays pointing down
+    //  keep their disk hits
+    // --------------------------------------------------
+    {
+        vec3 flat(0.0, 0.0, 15.0);
+        Physics::GeodesicTable flatTable;
+        flatTable.build(flat.length(), 2048);
+        std::vector<vec3> flatDirs = rayFan(flat, 32, 24);
+        int mismatched = 0, downDisk = 0;
+        for (const vec3& d : flatDirs) {
+            Physics::HitRecord ref = Physics::tracePhoton(Physics::Photon{ flat, d });
+            Physics::HitRecord hit = flatTable.lookup(flat, d);
+            if (ref.target != hit.target) mismatched++;
+            else if (d.y < 0.0 && hit.target == Physics::HitTarget::ACCRETION_DISK) downDisk++;
+        }
+        ASSERT_TRUE(downDisk > 0, "Downward rays hit the disk");
+        ASSERT_TRUE(mismatched * 50 < static_cast<int>(flatDirs.size()), "Pitch 0: classification matches for > 98% of rays");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
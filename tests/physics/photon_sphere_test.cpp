@@ -0,0 +1,240 @@
+#include "physics/binet.hpp"
+#include "physics/photon_batch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for the winding step around the photon sphere
+//  Tests: invariant over a long winding, exit directions vs a
+//  fine reference, crossings counted through the winding phase,
+//  disk hits on the exact crossing, worst-case step cost,
+//  SIMD batch agreement
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+static const double CRITICAL = 1.0 / (27.0 * Physics::M * Physics::M);
+
+// Ray from r0 = 15 with invariant A = 1/b² = CRITICAL − eps (eps > 0 escapes),
+// in the orbital plane of inclination `tilt` that meets y = 0 first at φ = phi0
+static Physics::Photon nearCriticalRay(double eps, double tilt, double phi0) {
+    const double r0 = 15.0;
+    const vec3 node(1.0, 0.0, 0.0), rise(0.0, std::sin(tilt), std::cos(tilt));
+    vec3 e1 = node * std::cos(phi0) - rise * std::sin(phi0);
+    vec3 e2 = node * std::sin(phi0) + rise * std::cos(phi0);
+    double sinA = 1.0 / (r0 * std::sqrt(CRITICAL - eps + 2.0 * Physics::M / (r0 * r0 * r0)));
+    return { e1 * r0, e1 * -std::sqrt(1.0 - sinA * sinA) + e2 * sinA };
+}
+
+// The tracePhoton loop without a disk: steps until r <= RS or r > ESCAPE_RADIUS,
+// counting y = 0 crossings (RK4 everywhere unless `wind`); steps inside
+// PHOTON_BAND are tallied separately
+struct Walk {
+    Physics::Photon end;
+    long steps = 0, bandSteps = 0, crossings = 0;
+};
+
+static Walk walk(Physics::Photon p, bool wind, double dt = Physics::STEP_SIZE) {
+    Walk w;
+    while (true) {
+        double r = p.pos.length();
+        if (r <= Physics::RS || r > Physics::ESCAPE_RADIUS) break;
+        double old_y = p.pos.y;
+        if (wind && Physics::nearPhotonSphere(p, r)) Physics::windStep(p);
+        else Physics::stepRK4(p, dt);
+        w.steps++;
+        w.bandSteps += r < Physics::PHOTON_BAND;
+        w.crossings += (old_y > 0.0 && p.pos.y <= 0.0) || (old_y < 0.0 && p.pos.y >= 0.0);
+    }
+    // Newton steps back onto the escape sphere, as in far_field_test
+    for (int i = 0; i < 3 && p.pos.length() > Physics::ESCAPE_RADIUS; i++)
+        Physics::stepRK4(p, (Physics::ESCAPE_RADIUS - p.pos.length()) * p.pos.length() / p.pos.dot(p.vel));
+    w.end = p;
+    return w;
+}
+
+// Orbit angle swept from the ray's start until it leaves [RS, ESCAPE_RADIUS]
+// (Binet RK4 at dφ = 1e-4), and 1/u where it reaches φ = phiAt
+static double sweptAngle(const Physics::Photon& p, double phiAt = -1.0, double* rAt = nullptr) {
+    Physics::OrbitalPlane plane = Physics::makeOrbitalPlane(p.pos, p.vel);
+    double u = 1.0 / p.pos.length();
+    Physics::BinetState s{ u, -u * std::cos(plane.alpha) / std::sin(plane.alpha) };
+    double phi = 0.0;
+    while (s.u > 1.0 / Physics::ESCAPE_RADIUS && s.u < 1.0 / Physics::RS) {
+        double h = 1e-4;
+        if (phiAt > phi && phi + h >= phiAt) h = phiAt - phi;
+        Physics::stepBinet(s, h, Physics::M);
+        phi += h;
+        if (rAt && phi == phiAt) *rAt = 1.0 / s.u;
+    }
+    return phi;
+}
+
+int main() {
+    std::cout << "=== Photon Sphere Winding Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: Winding steps keep A = 1/b² and |r × v|
+    //  over many turns; the unstable circular orbit
+    //  stays on r = 3M for two turns
+    // --------------------------------------------------
+    {
+        Physics::Photon p = nearCriticalRay(1e-9, 0.7, 0.4);
+        while (!Physics::nearPhotonSphere(p, p.pos.length())) Physics::stepRK4(p, Physics::STEP_SIZE);
+        auto invariant = [](const Physics::Photon& q) {
+            double u = 1.0 / q.pos.length();
+            vec3 h = q.pos.cross(q.vel);
+            return q.vel.dot(q.vel) / h.dot(h) - 2.0 * Physics::M * u * u * u;
+        };
+        const double A0 = invariant(p), h0 = p.pos.cross(p.vel).length();
+        int winding = 0;
+        for (; winding < 2000 && Physics::nearPhotonSphere(p, p.pos.length()); winding++) Physics::windStep(p);
+        ASSERT_TRUE(winding * Physics::WIND_STEP > 10.0, "1e-9 below critical: winds for over 10 radians");
+        ASSERT_NEAR(invariant(p) / A0, 1.0, 1e-12, "A conserved through the winding");
+        ASSERT_NEAR(p.pos.cross(p.vel).length() / h0, 1.0, 1e-12, "|r × v| conserved");
+
+        Physics::Photon circular{ vec3(3.0, 0.0, 0.0), vec3(0.0, 0.0, 1.0) };
+        int turns = 0;
+        while (std::abs(circular.pos.length() - 3.0) < 1e-3 && turns < 1000) {
+            Physics::windStep(circular);
+            turns++;
+        }
+        ASSERT_TRUE(turns * Physics::WIND_STEP > 4.0 * M_PI, "Circular photon orbit held for 2 turns");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Exit directions vs a fine RK4 reference:
+    //  no worse than the fixed-step loop through the
+    //  winding, from 1e-2 to 1e-6 of critical
+    // --------------------------------------------------
+    {
+        double worstWind = 0.0, worstStepped = 0.0;
+        bool escaped = true;
+        for (double eps : { 1e-2, 1e-3, 1e-4, 1e-5, 1e-6 }) {
+            Physics::Photon p = nearCriticalRay(eps * CRITICAL, 0.0, 0.0);
+            vec3 ref = walk(p, false, 5e-4).end.vel.normalize();
+            Walk wound = walk(p, true), stepped = walk(p, false);
+            escaped = escaped && wound.end.pos.length() > Physics::RS;
+            worstWind = std::max(worstWind, (wound.end.vel.normalize() - ref).length());
+            worstStepped = std::max(worstStepped, (stepped.end.vel.normalize() - ref).length());
+        }
+        std::cout << "  Exit direction error: " << worstStepped << " stepped, " << worstWind << " winding\n";
+        ASSERT_TRUE(escaped, "Super-critical rays escape");
+        ASSERT_TRUE(worstWind <= worstStepped, "Worst exit error ≤ the fixed-step loop's");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Crossings through the winding phase are
+    //  counted once each: φ0 + kπ inside the swept angle
+    // --------------------------------------------------
+    {
+        bool counted = true;
+        int most = 0;
+        for (double eps : { 1e-3, 1e-5, 1e-7, -1e-5, -1e-7 })
+            for (double phi0 : { 0.3, 1.9 }) {
+                Physics::Photon p = nearCriticalRay(eps * CRITICAL, 1.0, phi0);
+                double swept = sweptAngle(p);
+                int expected = swept > phi0 ? static_cast<int>(std::floor((swept - phi0) / M_PI)) + 1 : 0;
+                long got = walk(p, true).crossings;
+                counted = counted && got == expected;
+                most = std::max(most, expected);
+            }
+        ASSERT_TRUE(counted, "Crossing count matches the swept orbit angle");
+        ASSERT_TRUE(most >= 5, "Several crossings inside the winding");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: tracePhoton's disk hits inside the winding
+    //  sit on the exact crossing radius
+    // --------------------------------------------------
+    {
+        double worst = 0.0;
+        bool allDisk = true;
+        for (double eps : { 1e-4, 1e-6, -1e-6 })
+            for (double phi0 : { 2.2, 2.6, 3.0 }) {
+                Physics::Photon p = nearCriticalRay(eps * CRITICAL, 1.0, phi0);
+                double rAt = 0.0;
+                sweptAngle(p, phi0, &rAt);
+                Physics::HitRecord hit = Physics::tracePhoton(p);
+                allDisk = allDisk && hit.target == Physics::HitTarget::ACCRETION_DISK && rAt < Physics::PHOTON_BAND;
+                worst = std::max(worst, std::abs(hit.diskR - rAt));
+            }
+        ASSERT_TRUE(allDisk, "First crossing inside the band hits the disk");
+        ASSERT_NEAR(worst, 0.0, 1e-6, "Disk radius within 1e-6 of the reference crossing");
+    }
+
+    // Near-critical fan: both sides of b_crit, in and out of the disk plane
+    std::vector<Physics::Photon> fan;
+    for (int i = 0; i < 48; i++) {
+        double eps = (i % 2 ? 1.0 : -1.0) * std::pow(10.0, -2.0 - 6.0 * (i / 2) / 23.0) * CRITICAL;
+        fan.push_back(nearCriticalRay(eps, i % 3 ? 0.0 : 0.8, 0.5 + 0.1 * i));
+    }
+
+    // --------------------------------------------------
+    //  Test 5: Worst-case cost per ray drops, mostly
+    //  inside the photon band
+    // --------------------------------------------------
+    {
+        long worstWind = 0, worstStepped = 0, bandWind = 0, bandStepped = 0;
+        for (const Physics::Photon& p : fan) {
+            Walk wound = walk(p, true), stepped = walk(p, false);
+            worstWind = std::max(worstWind, wound.steps);
+            worstStepped = std::max(worstStepped, stepped.steps);
+            bandWind += wound.bandSteps;
+            bandStepped += stepped.bandSteps;
+        }
+        std::cout << "  Worst ray: " << worstStepped << " → " << worstWind << " steps; inside the band "
+                  << bandStepped << " → " << bandWind << "\n";
+        ASSERT_TRUE(worstWind * 4 < worstStepped * 3, "Worst-case steps per ray down by a quarter");
+        ASSERT_TRUE(bandWind * 2 < bandStepped, "Under half the steps inside the band");
+    }
+
+    // --------------------------------------------------
+    //  Test 6: The SIMD batch takes the same winding steps
+    //  (double and float). Near critical, FMA contraction
+    //  differences grow by e^φ, so only targets are exact
+    // --------------------------------------------------
+    {
+        Physics::PhotonBatch batch;
+        Physics::BasicPhotonBatch<float> batchF;
+        for (const Physics::Photon& p : fan) {
+            batch.push(p);
+            batchF.push({ fvec3(p.pos), fvec3(p.vel) });
+        }
+        std::vector<Physics::HitRecord> hits = Physics::traceBatch(batch);
+        std::vector<Physics::BasicHitRecord<float>> hitsF = Physics::traceBatch(batchF);
+        bool same = true, sameF = true;
+        for (std::size_t i = 0; i < fan.size(); i++) {
+            Physics::HitRecord ref = Physics::tracePhoton(fan[i]);
+            Physics::BasicHitRecord<float> refF = Physics::tracePhoton(batchF.photon(i));
+            same = same && hits[i].target == ref.target && (hits[i].pos - ref.pos).length() < 1e-4;
+            sameF = sameF && hitsF[i].target == refF.target;
+        }
+        ASSERT_TRUE(same, "Double batch: same targets, end points within 1e-4");
+        ASSERT_TRUE(sameF, "Float batch: same targets");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
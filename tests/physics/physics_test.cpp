@@ -1,4 +1,5 @@
 #include "physics/raytracer.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -163,6 +164,69 @@ int main() {
         ASSERT_TRUE(acc.length() < 1e-6, "Acceleration → 0 at large r");
     }
 
+    // --------------------------------------------------
+    //  Test 10: Float and double paths agree on hit class
+    //  and disk radius across the photon sphere
+    //  Sweep b = b_crit ± 0.4 (b_crit = 3√3 M): captured
+    //  rays and disk hits wound near r = 3M
+    // --------------------------------------------------
+    {
+        const double b_crit = 3.0 * std::sqrt(3.0) * Physics::M;
+        vec3 cam(0.0, 0.3, 15.0);
+        vec3 er = cam.normalize();
+        vec3 side = (er.cross(vec3(0, 1, 0)).normalize() * 0.98 + vec3(0, 1, 0) * 0.2).normalize();
+
+        int mismatched = 0, captured = 0, disk = 0;
+        double maxDiskDiff = 0.0;
+        for (int i = 0; i <= 400; i++) {
+            double b = b_crit - 0.4 + 0.8 * i / 400.0;
+            double s = b / cam.length();
+            vec3 dir = (er * -std::sqrt(1.0 - s * s) + side * s).normalize();
+
+            Physics::HitRecord hd = Physics::tracePhoton(Physics::Photon{ cam, dir });
+            Physics::BasicHitRecord<float> hf = Physics::tracePhoton(Physics::BasicPhoton<float>{ fvec3(cam), fvec3(dir) });
+
+            if (hd.target != hf.target) { mismatched++; continue; }
+            if (hd.target == Physics::HitTarget::BLACK_HOLE) captured++;
+            if (hd.target == Physics::HitTarget::ACCRETION_DISK) {
+                disk++;
+                maxDiskDiff = std::max(maxDiskDiff, std::abs(hd.diskR - double(hf.diskR)));
+            }
+        }
+        ASSERT_TRUE(captured > 0 && disk > 0, "Photon-sphere sweep covers capture and disk hits");
+        ASSERT_TRUE(mismatched == 0, "Float/double hit classification agree near photon sphere");
+        ASSERT_NEAR(maxDiskDiff, 0.0, 1e-4, "Float/double disk radius within 1e-4 near photon sphere");
+    }
+
+    // --------------------------------------------------
+    //  Test 11: Float and double escape directions agree
+    //  Rays passing outside the disk from above the plane
+    // --------------------------------------------------
+    {
+        vec3 cam(0.0, 8.0, 14.0);
+        vec3 er = cam.normalize();
+        vec3 side(1.0, 0.0, 0.0);
+
+        int mismatched = 0, sky = 0;
+        double maxDirDiff = 0.0;
+        for (int i = 0; i <= 50; i++) {
+            double b = 13.0 + 2.5 * i / 50.0;
+            double s = b / cam.length();
+            vec3 dir = (er * -std::sqrt(1.0 - s * s) + side * s).normalize();
+
+            Physics::HitRecord hd = Physics::tracePhoton(Physics::Photon{ cam, dir });
+            Physics::BasicHitRecord<float> hf = Physics::tracePhoton(Physics::BasicPhoton<float>{ fvec3(cam), fvec3(dir) });
+
+            if (hd.target != hf.target) { mismatched++; continue; }
+            if (hd.target == Physics::HitTarget::BACKGROUND_SKY) {
+                sky++;
+                maxDirDiff = std::max(maxDirDiff, (hd.dir - vec3(hf.dir)).length());
+            }
+        }
+        ASSERT_TRUE(sky > 0 && mismatched == 0, "Float/double agree on escaping rays");
+        ASSERT_NEAR(maxDirDiff, 0.0, 1e-4, "Float/double escape direction within 1e-4");
+    }
+
     // --- Summary ---
     std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
     return tests_failed > 0 ? 1 : 0;
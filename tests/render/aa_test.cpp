@@ -0,0 +1,152 @@
+#include "render/adaptive_aa.hpp"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for adaptive supersampling
+//  Tests: untouched pixels equal renderFrame, 1× uniform mode,
+//  ray budget, edge error vs uniform 16×, G-buffer reuse
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+// RMS of x / (1 + x) differences, optionally over masked pixels only
+static double compressedRMS(const Image& a, const Image& b, const std::vector<bool>* mask = nullptr) {
+    double sum = 0.0;
+    long n = 0;
+    for (std::size_t i = 0; i < a.pixels.size(); i++) {
+        if (mask && !(*mask)[i / 3]) continue;
+        double d = Render::AA::compress(a.pixels[i]) - Render::AA::compress(b.pixels[i]);
+        sum += d * d;
+        n++;
+    }
+    return n ? std::sqrt(sum / n) : 0.0;
+}
+
+int main() {
+    std::cout << "=== Adaptive Anti-Aliasing Unit Tests ===\n\n";
+
+    Camera cam(15.0f, 0.3f, 0.15f);
+    Render::RenderSettings s;
+    s.width = 64;
+    s.height = 48;
+    ThreadPool pool(2);
+    Render::FrameCache primary;
+    Image full = Render::renderFrame(cam, s, pool, &primary);
+
+    // --------------------------------------------------
+    //  Test 1: Pixels that were not supersampled keep
+    //  their primary sample; stats add up
+    // --------------------------------------------------
+    Render::AAStats st;
+    Image adaptive = Render::renderFrameAA(cam, s, pool, {}, &st);
+    {
+        long changed = 0;
+        for (int y = 0; y < s.height; y++) {
+            for (int x = 0; x < s.width; x++) {
+                const float* a = adaptive.at(x, y);
+                const float* b = full.at(x, y);
+                changed += a[0] != b[0] || a[1] != b[1] || a[2] != b[2];
+            }
+        }
+        long aaPixels = st.edgePixels + st.smoothPixels;
+        ASSERT_TRUE(st.edgePixels > 0 && changed > 0, "Frame has supersampled edge pixels");
+        ASSERT_TRUE(changed <= aaPixels, "Only supersampled pixels differ from renderFrame");
+        ASSERT_TRUE(st.primaryRays == st.pixels && st.pixels == long(s.width) * s.height, "One primary ray per pixel");
+        ASSERT_TRUE(st.extraRays >= 16 * st.edgePixels + 4 * st.smoothPixels, "Edge pixels get 16, smooth 4 rays");
+        ASSERT_TRUE(aaPixels * 2 < st.pixels, "Under half the frame is supersampled");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Uniform 1× is exactly renderFrame
+    // --------------------------------------------------
+    {
+        Render::AASettings one;
+        one.uniformSamples = 1;
+        Render::AAStats s1;
+        Image img = Render::renderFrameAA(cam, s, pool, one, &s1);
+        ASSERT_TRUE(img.pixels == full.pixels, "uniformSamples = 1 equals renderFrame");
+        ASSERT_TRUE(s1.extraRays == 0 && s1.raysPerPixel() == 1.0, "No extra rays at 1×");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Ray budget caps extra rays, serving outcome
+    //  edges before radius / colour divergence
+    // --------------------------------------------------
+    {
+        Render::AASettings capped;
+        capped.rayBudget = 1.0;
+        Render::AAStats sb;
+        Render::renderFrameAA(cam, s, pool, capped, &sb);
+        ASSERT_TRUE(sb.extraRays <= long(capped.rayBudget * sb.pixels), "Extra rays within the budget");
+        ASSERT_TRUE(sb.budgetDowngrades > 0, "Budget downgraded some candidates");
+        ASSERT_TRUE(sb.edgePixels > 0 && (sb.smoothPixels == 0 || sb.edgePixels == st.edgePixels),
+                    "Edge pixels are served before smooth ones");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Along outcome edges (shadow, ring, disk rim)
+    //  adaptive AA beats no AA against uniform 16×, and
+    //  costs less than uniform 4×
+    // --------------------------------------------------
+    {
+        Render::AASettings ref;
+        ref.uniformSamples = 16;
+        Render::AAStats sr;
+        Image reference = Render::renderFrameAA(cam, s, pool, ref, &sr);
+
+        std::vector<bool> edges(static_cast<std::size_t>(s.width) * s.height, false);
+        long edgeCount = 0;
+        for (int y = 0; y < s.height; y++) {
+            for (int x = 0; x < s.width; x++) {
+                auto target = [&](int px, int py) { return primary.gbuffer.hits[std::size_t(py) * s.width + px].target; };
+                bool edge = (x + 1 < s.width && target(x + 1, y) != target(x, y)) ||
+                            (x > 0 && target(x - 1, y) != target(x, y)) ||
+                            (y + 1 < s.height && target(x, y + 1) != target(x, y)) ||
+                            (y > 0 && target(x, y - 1) != target(x, y));
+                edges[std::size_t(y) * s.width + x] = edge;
+                edgeCount += edge;
+            }
+        }
+        ASSERT_TRUE(edgeCount == st.edgePixels, "Edge classification matches the primary G-buffer");
+        ASSERT_TRUE(sr.extraRays == 16 * sr.pixels && sr.primaryRays == 0, "Uniform 16× traces 16 rays per pixel");
+        ASSERT_NEAR(compressedRMS(adaptive, reference, &edges), 0.0, 1e-6, "Edge pixels match the 16× reference");
+        ASSERT_TRUE(compressedRMS(adaptive, reference) < compressedRMS(full, reference), "Whole frame closer than 1×");
+        ASSERT_TRUE(st.raysPerPixel() < 4.0, "Cheaper than uniform 4×");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: A matching G-buffer is reshaded, not retraced
+    // --------------------------------------------------
+    {
+        Render::FrameCache cache;
+        Render::AAStats first, second;
+        Image a = Render::renderFrameAA(cam, s, pool, {}, &first, &cache);
+        Image b = Render::renderFrameAA(cam, s, pool, {}, &second, &cache);
+        ASSERT_TRUE(a.pixels == b.pixels, "Cached frame is identical");
+        ASSERT_TRUE(first.primaryRays == first.pixels && second.primaryRays == 0, "Second frame skips primary rays");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,236 @@
+#include "render/animation.hpp"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================
+//  Unit tests for the offline animation pipeline
+//  Tests: bounded queue, keyframe splines, ACES port, PNG
+//  container, end-to-end sequence with bounded memory, frame
+//  file patterns
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+static std::uint32_t be32(const std::vector<char>& b, std::size_t at) {
+    return (std::uint32_t(std::uint8_t(b[at])) << 24) | (std::uint32_t(std::uint8_t(b[at + 1])) << 16) |
+           (std::uint32_t(std::uint8_t(b[at + 2])) << 8) | std::uint32_t(std::uint8_t(b[at + 3]));
+}
+
+int main() {
+    std::cout << "=== Animation Pipeline Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: BoundedQueue never exceeds its capacity,
+    //  keeps FIFO order and drains after close()
+    // --------------------------------------------------
+    {
+        Render::BoundedQueue<int> q(3);
+        std::vector<int> got;
+        std::thread consumer([&] {
+            while (auto v = q.pop()) {
+                got.push_back(*v);
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+        for (int i = 0; i < 50; i++) q.push(i);
+        q.close();
+        consumer.join();
+
+        bool ordered = got.size() == 50;
+        for (int i = 0; ordered && i < 50; i++) ordered = got[i] == i;
+        ASSERT_TRUE(ordered, "All items delivered in order");
+        ASSERT_TRUE(q.peakSize() <= 3, "Queue depth bounded by capacity");
+        ASSERT_TRUE(!q.push(99), "push after close() fails");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Keyframe splines hit keys, hold exactly,
+    //  and do not overshoot
+    // --------------------------------------------------
+    {
+        Render::CameraPath path;
+        path.add({ 10, 12.0f, 1.0f, 0.2f, vec3() });
+        path.add({ 0, 15.0f, 0.0f, 0.3f, vec3() });
+        path.add({ 5, 15.0f, 0.0f, 0.3f, vec3() });
+        path.add({ 20, 8.0f, 1.5f, 0.1f, vec3(1.0, 0.0, 0.0) });
+
+        ASSERT_TRUE(path.getKeys().front().frame == 0, "Keys sorted by frame");
+        ASSERT_NEAR(path.sample(10).radius, 12.0f, 1e-6f, "Passes through a key");
+        ASSERT_NEAR(path.sample(-4).yaw, 0.0f, 1e-9f, "Held before the first key");
+        ASSERT_NEAR(path.sample(25).center.x, 1.0, 1e-12, "Held after the last key");
+
+        bool exactHold = true, monotone = true;
+        float prev = path.sample(5).radius;
+        for (double f = 0.0; f <= 5.0; f += 0.25) exactHold = exactHold && path.sample(f).radius == 15.0f;
+        for (double f = 5.0; f <= 20.0; f += 0.25) {
+            float r = path.sample(f).radius;
+            monotone = monotone && r <= prev && r >= 8.0f;
+            prev = r;
+        }
+        ASSERT_TRUE(exactHold, "Hold between equal keys is bit-exact");
+        ASSERT_TRUE(monotone, "Monotone keys interpolate without overshoot");
+
+        Camera a, b;
+        path.apply(a, 2.0);
+        std::uint64_t rev = a.revision;
+        path.apply(a, 4.0);
+        path.apply(b, 2.0);
+        ASSERT_TRUE(a.revision == rev, "Held frames keep the camera revision");
+        ASSERT_TRUE(a.position.x == b.position.x && a.position.z == b.position.z, "apply() is deterministic");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: ACES port matches bloom_final.frag
+    // --------------------------------------------------
+    {
+        float x = 0.8f * Render::DEFAULT_EXPOSURE;
+        float aces = (x * (2.51f * x + 0.03f)) / (x * (2.43f * x + 0.59f) + 0.14f);
+        float expected = std::pow(aces, 1.0f / 2.2f) * 255.0f;
+        ASSERT_NEAR(float(Render::encodeDisplay(0.8f, Render::DEFAULT_EXPOSURE)), expected, 0.51f, "Mid-grey encode");
+        ASSERT_TRUE(Render::encodeDisplay(0.0f, 1.2f) == 0, "Black stays black");
+        ASSERT_TRUE(Render::encodeDisplay(1e6f, 1.2f) == 255, "Highlights clamp to white");
+        ASSERT_TRUE(Render::encodeDisplay(-1.0f, 1.2f) == 0, "Negative input clamps");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: PNG container: checksums and stored blocks
+    // --------------------------------------------------
+    {
+        const std::uint8_t iend[] = { 'I', 'E', 'N', 'D' };
+        const char* wiki = "Wikipedia";
+        ASSERT_TRUE(PngDetail::crc32(iend, 4) == 0xAE426082u, "CRC-32 of IEND");
+        ASSERT_TRUE(PngDetail::adler32(reinterpret_cast<const std::uint8_t*>(wiki), 9) == 0x11E60398u,
+                    "Adler-32 reference value");
+
+        // Wide enough that the scanlines need two stored blocks
+        LdrImage img(300, 80);
+        for (std::size_t i = 0; i < img.pixels.size(); i++) img.pixels[i] = static_cast<std::uint8_t>(i * 7);
+        std::vector<char> png = encodePNG(img);
+
+        ASSERT_TRUE(std::memcmp(png.data(), "\x89PNG\r\n\x1a\n", 8) == 0, "PNG signature");
+        ASSERT_TRUE(be32(png, 16) == 300 && be32(png, 20) == 80, "IHDR dimensions");
+
+        // Walk the chunks, verify every CRC, and inflate the stored blocks by hand
+        bool crcOk = true;
+        std::vector<std::uint8_t> idat;
+        std::size_t at = 8;
+        while (at + 12 <= png.size()) {
+            std::uint32_t len = be32(png, at);
+            const auto* body = reinterpret_cast<const std::uint8_t*>(png.data() + at + 4);
+            crcOk = crcOk && PngDetail::crc32(body, len + 4) == be32(png, at + 8 + len);
+            if (std::memcmp(body, "IDAT", 4) == 0) idat.insert(idat.end(), body + 4, body + 4 + len);
+            at += 12 + len;
+        }
+        ASSERT_TRUE(crcOk && at == png.size(), "All chunk CRCs valid");
+
+        std::vector<std::uint8_t> raw;
+        std::size_t p = 2;
+        bool last = false;
+        int blocks = 0;
+        while (!last && p + 5 <= idat.size()) {
+            last = idat[p] & 1;
+            std::size_t len = idat[p + 1] | (idat[p + 2] << 8);
+            raw.insert(raw.end(), idat.begin() + p + 5, idat.begin() + p + 5 + len);
+            p += 5 + len;
+            blocks++;
+        }
+        bool pixelsOk = raw.size() == 80u * (300 * 3 + 1) && blocks == 2;
+        for (int y = 0; pixelsOk && y < 80; y++)
+            pixelsOk = raw[y * 901] == 0 && std::memcmp(&raw[y * 901 + 1], &img.pixels[y * 900], 900) == 0;
+        ASSERT_TRUE(pixelsOk, "Scanlines round-trip through the stored blocks");
+        ASSERT_TRUE(PngDetail::adler32(raw.data(), raw.size()) ==
+                    ((std::uint32_t(idat[p]) << 24) | (idat[p + 1] << 16) | (idat[p + 2] << 8) | idat[p + 3]),
+                    "zlib Adler-32 trailer");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: End to end: every frame written, held
+    //  frames only reshade, in-flight frames bounded
+    // --------------------------------------------------
+    {
+        namespace fs = std::filesystem;
+        fs::path dir = fs::temp_directory_path() / "blackhole_animation_test";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+
+        Render::CameraPath path;
+        path.add({ 0, 15.0f, 0.0f, 0.3f, vec3() });
+        path.add({ 5, 15.0f, 0.0f, 0.3f, vec3() });
+        path.add({ 9, 13.0f, 0.4f, 0.2f, vec3() });
+
+        Render::RenderSettings s;
+        s.width = 32;
+        s.height = 24;
+        s.tileSize = 8;
+        Render::AnimationSettings anim;
+        anim.firstFrame = 0;
+        anim.lastFrame = 9;
+        anim.queueDepth = 1;
+        anim.outPattern = (dir / "f_%02d.pfm").string();
+
+        ThreadPool pool(2);
+        Render::AnimationStats stats = Render::renderSequence(path, s, anim, pool);
+        ASSERT_TRUE(stats.framesWritten == 10 && stats.failedWrites == 0, "All 10 frames written");
+        ASSERT_TRUE(stats.traces == 5, "Held frames 0..5 traced once, 6..9 each re-traced");
+        ASSERT_TRUE(stats.peakFramesInFlight <= 2 * anim.queueDepth + 3, "Frames in flight stay bounded");
+
+        // Frame 7 on disk equals a direct render of the same camera and time
+        Camera cam;
+        path.apply(cam, 7);
+        s.time = static_cast<float>(7 / anim.fps);
+        std::vector<char> direct = encodePFM(Render::renderFrame(cam, s, pool));
+        std::ifstream in(dir / "f_07.pfm", std::ios::binary);
+        std::vector<char> onDisk((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        ASSERT_TRUE(onDisk == direct, "Pipelined frame matches a direct render");
+
+        anim.outPattern = (dir / "missing" / "f_%02d.pfm").string();
+        anim.lastFrame = 1;
+        stats = Render::renderSequence(path, s, anim, pool);
+        ASSERT_TRUE(stats.failedWrites == 2 && stats.framesWritten == 0, "Write failures are counted, not fatal");
+
+        fs::remove_all(dir);
+    }
+
+    // --------------------------------------------------
+    //  Test 6: Frame patterns: one %d is formatted, any
+    //  other conversion is never passed to snprintf
+    // --------------------------------------------------
+    {
+        ASSERT_TRUE(validFramePattern("out/f_%04d.png") && validFramePattern("%d%%.pfm"), "One %d accepted");
+        ASSERT_TRUE(!validFramePattern("f.png") && !validFramePattern("%d_%d.png") &&
+                    !validFramePattern("%s.png") && !validFramePattern("%f.png") && !validFramePattern("f_%"),
+                    "Zero, two or non-int conversions rejected");
+        ASSERT_TRUE(framePath("out/f_%04d.png", 7) == "out/f_0007.png", "Zero-padded frame number");
+        ASSERT_TRUE(framePath("out.v2/%s.png", 7) == "out.v2/%s_0007.png", "Invalid pattern: number before the extension");
+        ASSERT_TRUE(framePath("out.v2/frames", 7) == "out.v2/frames_0007", "Invalid pattern without extension");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
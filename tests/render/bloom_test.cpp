@@ -0,0 +1,169 @@
+#include "render/bloom.hpp"
+#include <cmath>
+#include <iostream>
+
+// ============================================================
+//  Unit tests for the bloom CPU reference
+//  Tests: bilinear fetches, mip chain sizes, energy of the down
+//  and up kernels, symmetry, radius and footprint vs Gaussian,
+//  composite against toneMap
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+static double total(const Image& img, int channel = 0) {
+    double sum = 0.0;
+    for (std::size_t i = channel; i < img.pixels.size(); i += 3) sum += img.pixels[i];
+    return sum;
+}
+
+// Fraction of the channel-0 energy further than `r` (in frame-relative units) from the centre
+static double energyBeyond(const Image& img, double r) {
+    double far = 0.0;
+    for (int y = 0; y < img.height; y++)
+        for (int x = 0; x < img.width; x++) {
+            double dx = (x + 0.5) / img.width - 0.5, dy = (y + 0.5) / img.height - 0.5;
+            if (std::sqrt(dx * dx + dy * dy) > r) far += img.at(x, y)[0];
+        }
+    return far / total(img);
+}
+
+// 2×2 block of `value` straddling the centre of an even-sized frame
+static Image centredSpot(int size, float value) {
+    Image img(size, size);
+    for (int y = size / 2 - 1; y <= size / 2; y++)
+        for (int x = size / 2 - 1; x <= size / 2; x++) img.set(x, y, value, value * 0.5f, value * 0.25f);
+    return img;
+}
+
+int main() {
+    std::cout << "=== Bloom Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: Bilinear fetches and chain sizes
+    // --------------------------------------------------
+    {
+        Image img(4, 2);
+        img.set(1, 0, 1.0f, 0.0f, 0.0f);
+        img.set(2, 0, 3.0f, 0.0f, 0.0f);
+        float t[3];
+        Render::Bloom::sample(img, 1.5f / 4, 0.5f / 2, t);
+        ASSERT_NEAR(t[0], 1.0f, 1e-6f, "Texel centre fetch is exact");
+        Render::Bloom::sample(img, 2.0f / 4, 0.5f / 2, t);
+        ASSERT_NEAR(t[0], 2.0f, 1e-6f, "Fetch between texels averages them");
+        Render::Bloom::sample(img, -1.0f, 0.5f / 2, t);
+        ASSERT_NEAR(t[0], 0.0f, 1e-6f, "Outside the frame clamps to the edge texel");
+
+        auto sizes = Render::Bloom::chainSizes(160, 90, 5);
+        ASSERT_TRUE(sizes.size() == 5 && sizes[0] == std::make_pair(80, 45) && sizes[2] == std::make_pair(20, 11) &&
+                    sizes[4] == std::make_pair(5, 2), "Each level halves (rounding down)");
+        auto tiny = Render::Bloom::chainSizes(3, 2, 4);
+        ASSERT_TRUE(tiny[1] == std::make_pair(1, 1) && tiny[3] == std::make_pair(1, 1), "Levels bottom out at 1×1");
+
+        Image bloom = Render::bloomDualFilter(Image(160, 90));
+        ASSERT_TRUE(bloom.width == 80 && bloom.height == 45, "Dual-filter bloom comes back at half resolution");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Kernels are normalized — a flat image stays flat
+    // --------------------------------------------------
+    {
+        Image flat(64, 48);
+        for (int y = 0; y < flat.height; y++)
+            for (int x = 0; x < flat.width; x++) flat.set(x, y, 2.0f, 1.0f, 0.5f);
+        double worst = 0.0;
+        for (const Image& b : { Render::bloomDualFilter(flat), Render::bloomGaussian(flat) })
+            for (int y = 0; y < b.height; y++)
+                for (int x = 0; x < b.width; x++)
+                    worst = std::max(worst, double(std::abs(b.at(x, y)[0] - 2.0f) + std::abs(b.at(x, y)[2] - 0.5f)));
+        // bloom_blur.frag's weights sum to 0.9999994, which 16 passes compound
+        ASSERT_NEAR(worst, 0.0, 1e-4, "Flat image passes through both pipelines unchanged");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Energy is conserved away from the edges
+    //  (texel sums scale by the area ratio of each level)
+    // --------------------------------------------------
+    {
+        Image spot = centredSpot(128, 100.0f);
+        Image down = Render::Bloom::downsample(spot, 1.0f);
+        ASSERT_NEAR(total(down) * 4.0, total(spot), 1e-3, "Downsample conserves energy");
+        Image up = Render::Bloom::upsample(down, 128, 128, 1.0f);
+        ASSERT_NEAR(total(up) / 4.0, total(down), 1e-3, "Upsample conserves energy");
+
+        Render::BloomSettings s;
+        s.levels = 3;
+        Image bloom = Render::bloomDualFilter(spot, s);
+        ASSERT_NEAR(total(bloom) * 4.0 / total(spot), 1.0, 1e-4, "Whole chain conserves energy");
+        ASSERT_NEAR(total(bloom, 2) / total(bloom, 0), 0.25, 1e-6, "Channels are filtered independently");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: A centred spot blooms symmetrically
+    // --------------------------------------------------
+    {
+        Image bloom = Render::bloomDualFilter(centredSpot(128, 100.0f));
+        double worst = 0.0;
+        for (int y = 0; y < bloom.height; y++)
+            for (int x = 0; x < bloom.width; x++) {
+                float v = bloom.at(x, y)[0];
+                worst = std::max(worst, double(std::abs(v - bloom.at(bloom.width - 1 - x, y)[0])));
+                worst = std::max(worst, double(std::abs(v - bloom.at(x, bloom.height - 1 - y)[0])));
+                worst = std::max(worst, double(std::abs(v - bloom.at(y, x)[0])));
+            }
+        ASSERT_NEAR(worst, 0.0, 1e-5, "Mirror and transpose symmetric");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: Radius and depth widen the glow; the default
+    //  chain reaches further than the 8-iteration Gaussian
+    // --------------------------------------------------
+    {
+        Image spot = centredSpot(256, 100.0f);
+        Render::BloomSettings narrow, wide, shallow;
+        wide.radius = 2.0f;
+        shallow.levels = 2;
+        double base = energyBeyond(Render::bloomDualFilter(spot, narrow), 0.05);
+        ASSERT_TRUE(energyBeyond(Render::bloomDualFilter(spot, wide), 0.05) > base, "Larger radius spreads further");
+        ASSERT_TRUE(energyBeyond(Render::bloomDualFilter(spot, shallow), 0.05) < base, "Fewer levels spread less");
+        ASSERT_TRUE(base > energyBeyond(Render::bloomGaussian(spot), 0.05), "Wider footprint than the Gaussian");
+    }
+
+    // --------------------------------------------------
+    //  Test 6: Composite matches toneMap without bloom and
+    //  lifts the halo with it
+    // --------------------------------------------------
+    {
+        Image scene = centredSpot(64, 50.0f);
+        scene.set(3, 5, 0.2f, 0.3f, 0.4f);
+        Image bloom = Render::bloomDualFilter(scene);
+        ASSERT_TRUE(Render::compositeBloom(scene, bloom, 0.0f).pixels == Render::toneMap(scene).pixels,
+                    "Strength 0 composite == toneMap");
+        LdrImage lit = Render::compositeBloom(scene, bloom, 0.15f);
+        LdrImage plain = Render::toneMap(scene);
+        std::size_t halo = (static_cast<std::size_t>(32) * 64 + 36) * 3;
+        ASSERT_TRUE(lit.pixels[halo] > plain.pixels[halo], "Bloom brightens pixels next to the spot");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,155 @@
+#include "render/wavefront_renderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// ============================================================
+//  Unit tests for batched camera ray generation
+//  Tests: agreement with primaryRayDir, field caching across
+//  pose / size / FOV changes, jittered rays, float batches,
+//  field reuse by the wavefront renderer
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+// Largest component difference between the batch and primaryRayDir at
+// pixel centre + offset(x, y)
+template<typename T, typename Offset>
+static double worstDirection(const Physics::BasicPhotonBatch<T>& rays, const Camera& cam, int w, int h, Offset&& offset) {
+    double worst = 0.0;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            double jx, jy;
+            offset(x, y, jx, jy);
+            vec3 d = Render::primaryRayDir(cam, x + jx, y + jy, w, h);
+            std::size_t i = static_cast<std::size_t>(y) * w + x;
+            worst = std::max({ worst, std::abs(rays.vx[i] - d.x), std::abs(rays.vy[i] - d.y), std::abs(rays.vz[i] - d.z) });
+        }
+    }
+    return worst;
+}
+
+int main() {
+    std::cout << "=== Camera Ray Generation Unit Tests (" << simd::ISA << ") ===\n\n";
+
+    Camera cam(15.0f, 0.7f, 0.25f);
+    const int W = 37, H = 23;   // Not a multiple of any lane count
+    auto centre = [](int, int, double& jx, double& jy) { jx = jy = 0.5; };
+
+    // --------------------------------------------------
+    //  Test 1: Pixel-centre rays match primaryRayDir
+    // --------------------------------------------------
+    Render::CameraRays rays;
+    Physics::PhotonBatch batch;
+    rays.generate(cam, W, H, batch);
+    {
+        ASSERT_TRUE(batch.size() == std::size_t(W) * H, "One ray per pixel");
+        ASSERT_NEAR(worstDirection(batch, cam, W, H, centre), 0.0, 1e-12, "Directions match primaryRayDir");
+        bool origins = true;
+        for (std::size_t i = 0; i < batch.size(); i++)
+            origins = origins && batch.x[i] == cam.position.x && batch.y[i] == cam.position.y && batch.z[i] == cam.position.z;
+        ASSERT_TRUE(origins, "Every ray starts at the camera");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: The camera-space field is rebuilt only on
+    //  resize or FOV change, not on a pose change
+    // --------------------------------------------------
+    {
+        Camera moved = cam;
+        moved.yaw += 1.3f;
+        moved.pitch -= 0.4f;
+        moved.radius = 9.0f;
+        moved.update();
+        rays.generate(moved, W, H, batch);
+        ASSERT_TRUE(rays.rebuilds() == 1, "Pose change reuses the field");
+        ASSERT_NEAR(worstDirection(batch, moved, W, H, centre), 0.0, 1e-12, "Rotated field matches the new pose");
+
+        rays.generate(moved, W + 1, H, batch);
+        ASSERT_TRUE(rays.rebuilds() == 2 && batch.size() == std::size_t(W + 1) * H, "Resize rebuilds");
+
+        moved.fov_scale = 0.6f;
+        moved.update();
+        rays.generate(moved, W + 1, H, batch);
+        ASSERT_TRUE(rays.rebuilds() == 3, "FOV change rebuilds");
+        ASSERT_NEAR(worstDirection(batch, moved, W + 1, H, centre), 0.0, 1e-12, "New FOV matches primaryRayDir");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Jittered rays pass through jitterOffset,
+    //  deterministic per seed, offsets cover the pixel
+    // --------------------------------------------------
+    {
+        Physics::PhotonBatch a, b, c;
+        rays.generateJittered(cam, W, H, 7, a);
+        rays.generateJittered(cam, W, H, 7, b);
+        rays.generateJittered(cam, W, H, 8, c);
+        auto offset7 = [](int x, int y, double& jx, double& jy) { Render::jitterOffset(x, y, 7, jx, jy); };
+        ASSERT_NEAR(worstDirection(a, cam, W, H, offset7), 0.0, 1e-12, "Jittered rays match primaryRayDir at the offsets");
+        ASSERT_TRUE(a.vx == b.vx && a.vy == b.vy && a.vx != c.vx, "Same seed repeats, new seed differs");
+
+        double sum = 0.0, lo = 1.0, hi = 0.0;
+        for (int y = 0; y < H; y++) {
+            for (int x = 0; x < W; x++) {
+                double jx, jy;
+                Render::jitterOffset(x, y, 7, jx, jy);
+                sum += jx + jy;
+                lo = std::min({ lo, jx, jy });
+                hi = std::max({ hi, jx, jy });
+            }
+        }
+        ASSERT_NEAR(sum / (2.0 * W * H), 0.5, 0.05, "Offsets average to the pixel centre");
+        ASSERT_TRUE(lo >= 0.0 && hi < 1.0 && hi - lo > 0.9, "Offsets span [0, 1)");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Float batches for the float tracers
+    // --------------------------------------------------
+    {
+        Render::BasicCameraRays<float> frays;
+        Physics::BasicPhotonBatch<float> fbatch;
+        frays.generate(cam, W, H, fbatch);
+        ASSERT_NEAR(worstDirection(fbatch, cam, W, H, centre), 0.0, 1e-6, "Float directions within float rounding");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: The wavefront renderer keeps the field in the
+    //  FrameCache across camera moves
+    // --------------------------------------------------
+    {
+        Render::RenderSettings s;
+        s.width = 24;
+        s.height = 16;
+        ThreadPool pool(2);
+        Render::FrameCache cache;
+        Camera moving = cam;
+        for (int frame = 0; frame < 3; frame++) {
+            moving.yaw += 0.2f;
+            moving.update();
+            Render::renderFrameWavefront(moving, s, pool, {}, nullptr, &cache);
+        }
+        ASSERT_TRUE(cache.rays.rebuilds() == 1, "Three poses, one field build");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
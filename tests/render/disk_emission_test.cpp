@@ -0,0 +1,153 @@
+#include "render/disk_emission.hpp"
+#include <cmath>
+#include <iostream>
+
+// ============================================================
+//  Unit tests for the baked disk emission map
+//  Tests: particle layers == dot × flicker, texels ==
+//  Shading::diskPattern at their centres, seamless wrap in φ,
+//  row-band rebakes and thread-count independence, supersampling
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+static bool sameTexels(const Render::DiskEmissionMap& a, const Render::DiskEmissionMap& b) {
+    return a.angular == b.angular && a.radial == b.radial && a.texels == b.texels;
+}
+
+int main() {
+    std::cout << "=== Disk Emission Map Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: A layer is its static dot times a flicker,
+    //  and where one dot is lit the pattern's single
+    //  flicker seed reproduces the 8 flickering layers
+    //  (-march=native fuses the hash's multiply-adds
+    //  differently per call site, which nudges dot edges
+    //  and flicker phases: compare to 1% of a full dot,
+    //  at 98% of the points)
+    // --------------------------------------------------
+    {
+        int layersChecked = 0, layersOff = 0, checked = 0, off = 0;
+        for (int k = 0; k < 20000; k++) {
+            float r = 3.0f + 12.0f * Shading::hash(static_cast<float>(k), 1.0f);
+            float angle = 6.0f * Shading::hash(static_cast<float>(k), 2.0f) - 3.0f;
+            float time = 10.0f * Shading::hash(static_cast<float>(k), 3.0f);
+            float omega = std::sqrt(static_cast<float>(Physics::M) / (r * r * r));
+            float flowAngle = angle + time * omega;
+
+            float layers = 0.0f;
+            int lit = 0;
+            for (const Shading::ParticleLayerSpec& l : Shading::DISK_LAYERS) {
+                float rnd;
+                float dot = Shading::particleDot(r, flowAngle, l.rScale, l.aScale, l.dotSize, l.threshold, l.seed, rnd);
+                float layer = Shading::particleLayer(r, angle, time, l.rScale, l.aScale, l.dotSize, l.threshold, l.seed);
+                layersChecked++;
+                layersOff += std::abs(layer - dot * Shading::particleFlicker(rnd, time)) >= 0.01f;
+                layers += dot * Shading::particleFlicker(rnd, time) * l.weight;
+                lit += dot > 0.0f;
+            }
+            if (lit != 1) continue;
+            checked++;
+            Shading::DiskPattern p = Shading::diskPattern(r, flowAngle);
+            off += std::abs(p.particles * Shading::particleFlicker(p.rnd, time) - layers) >= 0.01f;
+        }
+        ASSERT_TRUE(layersOff * 50 < layersChecked, "particleLayer == particleDot × particleFlicker");
+        ASSERT_TRUE(checked > 100 && off * 50 < checked, "One lit dot: pattern × its flicker == the 8 layers");
+    }
+
+    ThreadPool serial(1), pool(4);
+    const int A = 256, R = 48;
+    Render::DiskEmissionMap map = Render::bakeDiskEmission(A, R, 3.0f, 15.0f, pool);
+
+    // --------------------------------------------------
+    //  Test 2: One sample per texel is exactly the CPU
+    //  (= GLSL) pattern at the texel centre, away from
+    //  the wrap's cross-fade
+    // --------------------------------------------------
+    {
+        ASSERT_TRUE(map.angular == A && map.radial == R && map.bytes() == std::size_t(A) * R * 3 * sizeof(float),
+                    "A × R RGB floats");
+        ASSERT_TRUE(std::abs(map.radius(-0.5) - 3.0f) < 1e-6f && std::abs(map.radius(R - 0.5) - 15.0f) < 1e-5f &&
+                    std::abs(map.angle(-0.5) + M_PI) < 1e-6, "Rows span [rMin, rMax], columns [−π, π)");
+        bool exact = true;
+        int lit = 0;
+        for (int j = 0; j < R; j++)
+            for (int i = 0; i < A; i++) {
+                if (map.angle(i) + M_PI < Render::DiskEmissionMap::SEAM_BLEND) continue;
+                Shading::DiskPattern p = Shading::diskPattern(map.radius(j), map.angle(i));
+                const float* t = map.texel(i, j);
+                exact = exact && t[0] == p.particles && t[1] == p.rnd && t[2] == p.glow;
+                lit += t[0] > 0.0f;
+            }
+        ASSERT_TRUE(exact, "Texels == Shading::diskPattern at their centres");
+        ASSERT_TRUE(lit > 0, "Particles present");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: φ wraps without a seam: the last and first
+    //  columns of the smooth glow differ no more than any
+    //  neighbouring pair does
+    // --------------------------------------------------
+    {
+        Render::DiskEmissionMap fine = Render::bakeDiskEmission(4096, 8, 3.0f, 15.0f, pool);
+        double seam = 0.0, step = 0.0;
+        for (int j = 0; j < fine.radial; j++) {
+            seam = std::max(seam, double(std::abs(fine.texel(0, j)[2] - fine.texel(fine.angular - 1, j)[2])));
+            for (int i = 0; i + 1 < fine.angular; i++)
+                step = std::max(step, double(std::abs(fine.texel(i + 1, j)[2] - fine.texel(i, j)[2])));
+        }
+        ASSERT_TRUE(seam <= step, "Glow continuous across φ = ±π");
+
+        // The raw pattern is not periodic: without the cross-fade there would be a jump
+        double jump = 0.0;
+        for (int j = 0; j < fine.radial; j++)
+            jump = std::max(jump, double(std::abs(Shading::diskPattern(fine.radius(j), fine.angle(-0.5)).glow -
+                                                  Shading::diskPattern(fine.radius(j), fine.angle(4095.5)).glow)));
+        ASSERT_TRUE(jump > 4.0 * step, "Procedural glow jumps at the wrap");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Rebaking a band of rows reproduces the full
+    //  bake; the pool size does not matter
+    // --------------------------------------------------
+    {
+        Render::DiskEmissionMap band = map;
+        for (int j = 10; j < 20; j++)
+            for (int i = 0; i < A; i++) band.texel(i, j)[0] = -1.0f;
+        Render::bakeDiskEmissionRows(band, 10, 20, serial);
+        ASSERT_TRUE(sameTexels(band, map), "Rows 10–19 rebaked in place");
+        ASSERT_TRUE(sameTexels(map, Render::bakeDiskEmission(A, R, 3.0f, 15.0f, serial)), "4 threads == 1 thread");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: A supersampled texel averages particles and
+    //  glow over the texels it covers at twice the size
+    // --------------------------------------------------
+    {
+        Render::DiskEmissionMap coarse = Render::bakeDiskEmission(A / 2, R / 2, 3.0f, 15.0f, pool, 2);
+        bool mean = true;
+        for (int j = 0; j < R / 2; j++)
+            for (int i = 0; i < A / 2; i++)
+                for (int c : { 0, 2 }) {
+                    double sum = 0.0;
+                    for (int dy = 0; dy < 2; dy++)
+                        for (int dx = 0; dx < 2; dx++) sum += map.texel(2 * i + dx, 2 * j + dy)[c];
+                    mean = mean && std::abs(coarse.texel(i, j)[c] - 0.25 * sum) < 1e-5;
+                }
+        ASSERT_TRUE(mean, "2×2 samples == box filter of the 2× bake");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
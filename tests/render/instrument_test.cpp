@@ -0,0 +1,151 @@
+#include "render/cpu_renderer.hpp"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ============================================================
+//  Unit tests for the renderer instrumentation
+//  (always built with BLACKHOLE_INSTRUMENT=1)
+//  Tests: per-ray counters vs direct TraceStats, termination
+//  classes, tile events, heatmaps, Chrome trace export
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+static int count(const std::string& text, const std::string& needle) {
+    int n = 0;
+    for (std::size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) n++;
+    return n;
+}
+
+int main() {
+    std::cout << "=== Instrumentation Unit Tests ===\n\n";
+
+    Camera cam(15.0f, 0.4f, 0.25f);
+    Render::RenderSettings s;
+    s.width = 40;
+    s.height = 30;
+    s.tileSize = 8;
+    ThreadPool pool(2);
+
+    // --------------------------------------------------
+    //  Test 1: Per-ray counters equal a direct trace
+    // --------------------------------------------------
+    Render::FrameProfile profile;
+    Image image = Render::renderFrame(cam, s, pool, nullptr, &profile);
+    {
+        bool stepsMatch = true, classMatch = true;
+        for (int y = 0; y < s.height; y += 3) {
+            for (int x = 0; x < s.width; x += 3) {
+                vec3 dir = Render::primaryRayDir(cam, x + 0.5, y + 0.5, s.width, s.height);
+                Physics::TraceStats stats;
+                Physics::HitRecord hit = Physics::tracePhoton(Physics::Photon{ cam.position, dir }, &stats);
+                const Render::RayCounters& c = profile.ray(x, y);
+                stepsMatch = stepsMatch && c.traced && c.steps == stats.steps && c.crossings == stats.crossings;
+                Render::Termination expected = hit.target == Physics::HitTarget::ACCRETION_DISK ? Render::Termination::Disk
+                    : hit.target == Physics::HitTarget::BACKGROUND_SKY ? Render::Termination::Escaped
+                    : Render::Termination::Captured;
+                classMatch = classMatch && c.termination == expected;
+            }
+        }
+        ASSERT_TRUE(stepsMatch, "Steps and plane crossings match tracePhoton's TraceStats");
+        ASSERT_TRUE(classMatch, "Termination classes match the hit targets");
+
+        Render::ProfileSummary sum = profile.summarize();
+        long classified = 0;
+        for (long t : sum.terminations) classified += t;
+        ASSERT_TRUE(sum.rays == s.width * s.height && classified == sum.rays, "Every pixel counted once");
+        ASSERT_TRUE(sum.terminations[int(Render::Termination::Disk)] > 0 &&
+                    sum.terminations[int(Render::Termination::Escaped)] > 0, "Scene has disk and sky rays");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Tiles: one event each, steps add up
+    // --------------------------------------------------
+    {
+        const auto& tiles = profile.getTiles();
+        long tileSteps = 0;
+        bool timed = true;
+        for (const auto& t : tiles) {
+            tileSteps += t.steps;
+            timed = timed && t.durationUs > 0.0 && t.startUs >= 0.0 && t.worker < pool.size();
+        }
+        ASSERT_TRUE(tiles.size() == Render::makeTiles(s.width, s.height, s.tileSize).size(), "One event per tile");
+        ASSERT_TRUE(tileSteps == profile.summarize().steps, "Tile step totals add up to the frame");
+        ASSERT_TRUE(timed, "Tiles carry wall time and worker id");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Step budget: rays above the GPU's MAX_STEPS
+    //  are classified as budget-exhausted
+    // --------------------------------------------------
+    {
+        Render::FrameProfile tight;
+        tight.stepBudget = 300;
+        Render::renderFrame(cam, s, pool, nullptr, &tight);
+        Render::ProfileSummary sum = tight.summarize();
+        long over = 0;
+        for (int y = 0; y < s.height; y++)
+            for (int x = 0; x < s.width; x++) over += profile.ray(x, y).steps > 300;
+        ASSERT_TRUE(over > 0 && sum.terminations[int(Render::Termination::StepBudget)] == over,
+                    "Rays over the step budget are flagged");
+
+        Physics::AdaptiveSettings cfg;
+        cfg.maxSteps = 3;
+        Physics::TraceStats stats;
+        Physics::tracePhotonAdaptive(Physics::Photon{ cam.position, cam.forward * -1.0 }, cfg, &stats);
+        ASSERT_TRUE(stats.exhausted, "Adaptive tracer reports an exhausted budget");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Exports
+    // --------------------------------------------------
+    {
+        LdrImage steps = profile.stepsHeatmap();
+        LdrImage term = profile.terminationMap();
+        ASSERT_TRUE(steps.width == s.width && steps.height == s.height && term.pixels.size() == image.pixels.size(),
+                    "Heatmaps match the frame size");
+
+        std::string trace = profile.chromeTrace("test");
+        ASSERT_TRUE(trace.rfind("{\"displayTimeUnit\"", 0) == 0, "Trace is a JSON object");
+        ASSERT_TRUE(count(trace, "\"ph\":\"X\"") == static_cast<int>(profile.getTiles().size()),
+                    "One complete event per tile");
+        ASSERT_TRUE(count(trace, "{") == count(trace, "}") && count(trace, "[") == count(trace, "]"),
+                    "Brackets balance");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: Reshaded frames record tiles but no rays
+    // --------------------------------------------------
+    {
+        Render::FrameCache cache;
+        Render::renderFrame(cam, s, pool, &cache);
+        Render::FrameProfile reshade;
+        Render::renderFrame(cam, s, pool, &cache, &reshade);
+        ASSERT_TRUE(reshade.summarize().rays == 0 && !reshade.getTiles().empty(),
+                    "G-buffer reshade: tile timings only");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,430 @@
+#include "core/camera.hpp"
+#include "core/display.hpp"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for the offscreen Display and PBO readback ring
+//  Tests: EGL context + full pipeline, frame content, ring
+//  readback vs blocking glReadPixels, in-order delivery, full
+//  ring back-pressure, resize, render scale, pass timings,
+//  program binary cache, quality variants, baked sky and disk,
+//  readback disabled
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+static void drawFrame(Display& display, Camera& camera, int frame) {
+    camera.yaw = frame * 0.05f;
+    camera.update();
+    display.setCameraRevision(camera.revision);
+    display.markInput();
+    display.useSceneShader();
+    display.setUniform2f("uResolution", (float)display.getWidth(), (float)display.getHeight());
+    display.setUniform1f("uTime", frame * 0.1f);
+    display.setUniform1f("uStepSize", 0.08f);
+    display.setUniform1f("uFovScale", camera.fov_scale);
+    display.setUniform3f("uCamPos", (float)camera.position.x, (float)camera.position.y, (float)camera.position.z);
+    display.setUniform3f("uCamForward", (float)camera.forward.x, (float)camera.forward.y, (float)camera.forward.z);
+    display.setUniform3f("uCamRight", (float)camera.right.x, (float)camera.right.y, (float)camera.right.z);
+    display.setUniform3f("uCamUp", (float)camera.up.x, (float)camera.up.y, (float)camera.up.z);
+    display.draw();
+}
+
+static int luma(const LdrImage& img, int x, int y) {
+    const std::uint8_t* p = &img.pixels[(static_cast<std::size_t>(y) * img.width + x) * 3];
+    return p[0] + p[1] + p[2];
+}
+
+int main() {
+    std::cout << "=== Offscreen Display Unit Tests ===\n\n";
+
+    const int W = 64, H = 48;
+    Display::setProgramCacheDir("offscreen_test_cache");
+    Display display(W, H, BLACKHOLE_SHADER_DIR, 3);
+    Camera camera(15.0f, 0.0f, 0.3f);
+
+    // --------------------------------------------------
+    //  Test 1: EGL context and a full frame
+    // --------------------------------------------------
+    ASSERT_TRUE(display.isReady() && display.isOffscreen(), "Offscreen display initialised");
+    if (!display.isReady()) {
+        std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+        return 1;
+    }
+    {
+        drawFrame(display, camera, 0);
+        LdrImage img = display.readFrameSync();
+        int brightest = 0;
+        for (int y = 0; y < H; y++)
+            for (int x = 0; x < W; x++) brightest = std::max(brightest, luma(img, x, y));
+        ASSERT_TRUE(img.width == W && img.height == H, "Frame has the display size");
+        // The shadow picks up some bloom, so compare against the disk
+        ASSERT_TRUE(brightest > 300, "Disk lit somewhere in the frame");
+        ASSERT_TRUE(luma(img, W / 2, H / 2) * 4 < brightest, "Shadow at the centre of the frame");
+
+        LdrImage async;
+        std::uint64_t id = 99;
+        ASSERT_TRUE(display.takeFrame(async, &id, true) && id == 0 && async.pixels == img.pixels,
+                    "PBO readback == blocking glReadPixels");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Frames come back in draw order with the
+    //  content of a blocking read of the same frame
+    // --------------------------------------------------
+    {
+        std::vector<LdrImage> reference;
+        std::vector<std::uint64_t> order;
+        bool same = true;
+        for (int f = 1; f <= 6; f++) {
+            drawFrame(display, camera, f);
+            reference.push_back(display.readFrameSync());
+            LdrImage img;
+            std::uint64_t id;
+            while (display.takeFrame(img, &id)) {
+                order.push_back(id);
+                same = same && id >= 1 && id <= 6 && img.pixels == reference[id - 1].pixels;
+            }
+        }
+        LdrImage img;
+        std::uint64_t id;
+        while (display.takeFrame(img, &id, true)) {
+            order.push_back(id);
+            same = same && id >= 1 && id <= 6 && img.pixels == reference[id - 1].pixels;
+        }
+        bool inOrder = order.size() == 6;
+        for (std::size_t i = 0; inOrder && i < order.size(); i++) inOrder = order[i] == i + 1;
+        ASSERT_TRUE(inOrder, "Every frame delivered once, in draw order");
+        ASSERT_TRUE(same, "Each frame matches its blocking read");
+        ASSERT_TRUE(reference[0].pixels != reference[5].pixels, "Frames differ as the camera orbits");
+        ASSERT_TRUE(!display.takeFrame(img, &id) && display.framesInFlight() == 0, "Nothing left after draining");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: A full ring waits for its oldest frame and
+    //  keeps it, so nothing is dropped
+    // --------------------------------------------------
+    {
+        std::uint64_t stallsBefore = display.getReadbackStats().stalls;
+        for (int f = 7; f < 14; f++) drawFrame(display, camera, f);
+        ASSERT_TRUE(display.framesInFlight() == 7, "All 7 undrained frames held");
+        ASSERT_TRUE(display.getReadbackStats().stalls - stallsBefore == 4, "4 ring-full waits with 3 buffers");
+
+        LdrImage img;
+        std::uint64_t id, expect = 7;
+        bool inOrder = true;
+        while (display.takeFrame(img, &id, true)) inOrder = inOrder && id == expect++;
+        ASSERT_TRUE(inOrder && expect == 14, "Held frames delivered in order");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Resize reallocates the output and readback
+    // --------------------------------------------------
+    {
+        display.resize(40, 30);
+        drawFrame(display, camera, 0);
+        LdrImage img;
+        ASSERT_TRUE(display.takeFrame(img, nullptr, true) && img.width == 40 && img.height == 30 &&
+                    luma(img, 20, 15) < 150, "Resized frame read back at the new size");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: A reduced render scale still composites a
+    //  window-size frame; dynamic resolution reacts to the
+    //  measured scene-pass time
+    // --------------------------------------------------
+    {
+        display.setRenderScale(0.5f);
+        drawFrame(display, camera, 0);
+        LdrImage img;
+        ASSERT_TRUE(display.getSceneWidth() == 20 && display.getSceneHeight() == 15, "Scene targets at half size");
+        ASSERT_TRUE(display.takeFrame(img, nullptr, true) && img.width == 40 && img.height == 30 &&
+                    luma(img, 20, 15) < 150, "Upscaled frame at window size with the shadow centred");
+
+        ResolutionSettings rs;
+        rs.targetMs = 1e-4;   // Unreachable: every measured frame is over budget
+        rs.minScale = 0.25f;
+        display.setDynamicResolution(true, rs);
+        for (int f = 1; f <= 30; f++) drawFrame(display, camera, f);
+        while (display.takeFrame(img, nullptr, true)) {}
+        ASSERT_TRUE(display.getLastSceneMs() > 0.0, "Scene pass timed on the GPU");
+        ASSERT_NEAR(display.getRenderScale(), 0.25f, 1e-6f, "Over budget drives the scale to its minimum");
+        display.setDynamicResolution(false);
+        ASSERT_TRUE(display.getRenderScale() == 1.0f && display.getSceneWidth() == 40, "Disabling restores full scale");
+    }
+
+    // --------------------------------------------------
+    //  Test 6: Per-pass GPU timings add up to the frame,
+    //  in both bloom modes; the overlay draws its graph
+    // --------------------------------------------------
+    {
+        LdrImage img;
+        for (int f = 0; f < 6; f++) drawFrame(display, camera, f);
+        while (display.takeFrame(img, nullptr, true)) {}
+        drawFrame(display, camera, 6);   // Collects the frames the drain finished
+        const FrameTelemetry& t = display.getTelemetry();
+        auto last = [&](const char* name) { return t.find(name) ? t.find(name)->last() : -1.0; };
+        double passes = last("scene") + last("composite");
+        int levels = 0;
+        for (int i = 0; t.find("bloom_down" + std::to_string(i)); i++, levels++)
+            passes += last(("bloom_down" + std::to_string(i)).c_str());
+        for (int i = 0; i + 1 < levels; i++) passes += last(("bloom_up" + std::to_string(i)).c_str());
+        ASSERT_TRUE(levels > 0 && last("scene") > 0.0 && last("composite") >= 0.0, "Scene, bloom and composite timed");
+        ASSERT_NEAR(passes, last("gpu_frame"), 1e-3, "Pass times sum to the GPU frame time");
+        ASSERT_TRUE(last("input_latency") >= last("gpu_frame"), "Input latency covers the GPU frame");
+        ASSERT_TRUE(t.summary("cpu_frame").count >= 6 && t.summary("cpu_frame").p99 >= t.summary("cpu_frame").p50 &&
+                    t.summary("cpu_submit").count >= 6, "CPU frame pacing recorded");
+
+        display.setBloomMode(BloomMode::Gaussian);
+        for (int f = 0; f < 4; f++) drawFrame(display, camera, f);
+        while (display.takeFrame(img, nullptr, true)) {}
+        drawFrame(display, camera, 4);
+        ASSERT_TRUE(t.find("blur0") && t.find("blur15") && !t.find("blur16"), "One timer per Gaussian iteration");
+        display.setBloomMode(BloomMode::DualFilter);
+
+        display.setTimingOverlay(true);
+        drawFrame(display, camera, 0);
+        display.setTimingOverlay(false);
+        while (display.takeFrame(img, nullptr, true)) {}
+        const std::uint8_t* p = &img.pixels[(static_cast<std::size_t>(img.height - 1 - 9) * img.width + 9) * 3];
+        bool barColour = (p[0] == 51 && p[1] == 230 && p[2] == 77) || (p[0] == 255 && p[1] == 204 && p[2] == 26) ||
+                         (p[0] == 255 && p[1] == 51 && p[2] == 51);
+        ASSERT_TRUE(barColour, "Overlay bar drawn in the bottom-left corner");
+    }
+
+    // --------------------------------------------------
+    //  Test 7: Program binary cache — hit after a write,
+    //  recompiles on changed sources or a bad file
+    // --------------------------------------------------
+    {
+        const std::string dir = "offscreen_test_programs";
+        std::filesystem::remove_all(dir);
+        const std::string vert = "#version 330 core\nlayout(location = 0) in vec2 aPos;\n"
+                                 "void main() { gl_Position = vec4(aPos, 0.0, 1.0); }\n";
+        const std::string frag = "#version 330 core\nuniform vec3 uTint;\nout vec4 FragColor;\n"
+                                 "void main() { FragColor = vec4(uTint, 1.0); }\n";
+        int builds = 0;
+        auto build = [&](const std::string& fragSrc) {
+            return [&, fragSrc](bool retrievable) {
+                builds++;
+                auto compile = [](GLenum type, const std::string& src) {
+                    GLuint sh = glCreateShader(type);
+                    const char* text = src.c_str();
+                    glShaderSource(sh, 1, &text, nullptr);
+                    glCompileShader(sh);
+                    return sh;
+                };
+                GLuint v = compile(GL_VERTEX_SHADER, vert), f = compile(GL_FRAGMENT_SHADER, fragSrc);
+                GLuint prog = glCreateProgram();
+                glAttachShader(prog, v);
+                glAttachShader(prog, f);
+                if (retrievable) glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+                glLinkProgram(prog);
+                glDeleteShader(v);
+                glDeleteShader(f);
+                return prog;
+            };
+        };
+        auto usable = [](GLuint prog) {
+            GLint linked = 0;
+            glGetProgramiv(prog, GL_LINK_STATUS, &linked);
+            bool ok = linked && glGetUniformLocation(prog, "uTint") >= 0;
+            glDeleteProgram(prog);
+            return ok;
+        };
+
+        ProgramCache first(dir);
+        if (!first.enabled()) {
+            std::cout << "  (driver exposes no program binary formats: cache checks skipped)\n";
+        } else {
+            bool ok = usable(first.get("tint", vert, frag, build(frag)));
+            ASSERT_TRUE(ok && builds == 1 && first.getStats().misses == 1 && first.getStats().written == 1,
+                        "Cold cache compiles and writes the binary");
+
+            ProgramCache warm(dir);
+            ok = usable(warm.get("tint", vert, frag, build(frag)));
+            ASSERT_TRUE(ok && builds == 1 && warm.getStats().hits == 1, "Warm cache restores without compiling");
+
+            std::string edited = frag + "// edited\n";
+            ProgramCache changed(dir);
+            ok = usable(changed.get("tint", vert, edited, build(edited)));
+            ASSERT_TRUE(ok && builds == 2 && changed.getStats().misses == 1 && changed.getStats().written == 1,
+                        "Changed source misses and replaces the entry");
+
+            // Right header, garbage binary: the driver refuses it and we recompile
+            {
+                std::fstream f(dir + "/tint.bin", std::ios::in | std::ios::out | std::ios::binary);
+                f.seekp(40);
+                const char junk[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+                f.write(junk, sizeof(junk));
+            }
+            ProgramCache corrupt(dir);
+            ok = usable(corrupt.get("tint", vert, edited, build(edited)));
+            ASSERT_TRUE(ok && builds == 3 && corrupt.getStats().rejected + corrupt.getStats().hits == 1,
+                        "Corrupted binary falls back to compiling");
+
+            std::filesystem::resize_file(dir + "/tint.bin", 10);
+            ProgramCache truncated(dir);
+            ok = usable(truncated.get("tint", vert, edited, build(edited)));
+            ASSERT_TRUE(ok && builds == 4 && truncated.getStats().misses == 1, "Truncated file falls back to compiling");
+
+            ProgramCache off("");
+            ok = usable(off.get("tint", vert, frag, build(frag)));
+            ASSERT_TRUE(ok && builds == 5 && !off.enabled(), "Empty dir disables the cache");
+            ASSERT_TRUE(display.getProgramCacheStats().written + display.getProgramCacheStats().hits == 7,
+                        "Display cached all 7 programs");
+        }
+        std::filesystem::remove_all(dir);
+    }
+
+    // --------------------------------------------------
+    //  Test 8: Quality variants — switch, uniforms carried
+    //  over, brightness kept, defines reach the shaders
+    // --------------------------------------------------
+    {
+        auto frameStats = [&](int& brightest, double& mean) {
+            LdrImage img = display.readFrameSync();
+            brightest = 0;
+            mean = 0.0;
+            for (int y = 0; y < img.height; y++)
+                for (int x = 0; x < img.width; x++) {
+                    brightest = std::max(brightest, luma(img, x, y));
+                    mean += luma(img, x, y);
+                }
+            mean /= static_cast<double>(img.width) * img.height;
+            return img;
+        };
+
+        ASSERT_TRUE(display.getQuality() == QualitySettings::high() && display.getQualityVariantCount() == 1,
+                    "Starts on the high preset");
+        drawFrame(display, camera, 3);
+        int highMax;
+        double highMean;
+        LdrImage highImg = frameStats(highMax, highMean);
+
+        display.setQuality(QualitySettings::low());
+        display.finishQuality();
+        ASSERT_TRUE(!display.qualityPending() && display.getQuality() == QualitySettings::low() &&
+                    display.getQualityVariantCount() == 2, "Switched to low once linked");
+
+        // No setUniform calls: the camera and time must carry over to the new programs
+        display.draw();
+        int lowMax;
+        double lowMean;
+        frameStats(lowMax, lowMean);
+        ASSERT_TRUE(lowMax > 300 && lowMean > 0.5 * highMean && lowMean < 2.0 * highMean,
+                    "Low preset: same view, comparable brightness");
+
+        ASSERT_TRUE(display.setQuality(QualitySettings::high()) && display.getQualityVariantCount() == 2,
+                    "Switching back reuses the built variant");
+
+        // 16 steps never reach the disk or ESCAPE_R: only the photon-ring glow is left
+        QualitySettings starved;
+        starved.maxSteps = 1;
+        display.setQuality(starved);
+        display.finishQuality();
+        ASSERT_TRUE(display.getQuality().maxSteps == 16 && display.getQuality().tag().rfind("custom-", 0) == 0,
+                    "Custom settings clamped and tagged");
+        display.draw();
+        LdrImage starvedImg = display.readFrameSync();
+        // Without the disk whole regions of the frame change, not just a few stars
+        int changed = 0;
+        for (int y = 0; y < highImg.height; y++)
+            for (int x = 0; x < highImg.width; x++)
+                changed += std::abs(luma(highImg, x, y) - luma(starvedImg, x, y)) > 64;
+        ASSERT_TRUE(changed > highImg.width * highImg.height / 30, "QUALITY_MAX_STEPS reaches the shaders (no disk)");
+
+        if (ProgramCache(display.getProgramCacheDir()).enabled()) {
+            ASSERT_TRUE(std::filesystem::exists(display.getProgramCacheDir() + "/scene-low.bin") &&
+                        std::filesystem::exists(display.getProgramCacheDir() + "/gbuffer_trace-low.bin"),
+                        "Variants cached under their preset name");
+        }
+        display.setQuality(QualitySettings::high());
+    }
+
+    // --------------------------------------------------
+    //  Test 9: The baked sky and disk stand in for the
+    //  procedural ones — same frame apart from filtering
+    // --------------------------------------------------
+    {
+        ASSERT_TRUE(display.getStarfieldBakeMs() > 0.0, "Starfield cube map baked at start-up");
+        drawFrame(display, camera, 3);
+        LdrImage baked = display.readFrameSync();
+
+        QualitySettings procedural;
+        procedural.bakedStarfield = false;
+        display.setQuality(procedural);
+        display.finishQuality();
+        display.draw();
+        LdrImage hashed = display.readFrameSync();
+        display.setQuality(QualitySettings::high());
+
+        double diff = 0.0, mean = 0.0;
+        int far = 0;
+        const int pixels = baked.width * baked.height;
+        for (int y = 0; y < baked.height; y++)
+            for (int x = 0; x < baked.width; x++) {
+                int d = std::abs(luma(baked, x, y) - luma(hashed, x, y));
+                diff += d;
+                mean += luma(hashed, x, y);
+                far += d > 96;
+            }
+        ASSERT_TRUE(diff < 0.1 * mean, "Baked and procedural frames agree on average");
+        ASSERT_TRUE(far < pixels / 50, "Only isolated star pixels differ");
+
+        // Filtered disk particles: same brightness overall, softer dots
+        ASSERT_TRUE(display.getDiskEmissionBakeMs() > 0.0, "Disk emission map baked at start-up");
+        QualitySettings proceduralDisk;
+        proceduralDisk.bakedDisk = false;
+        display.setQuality(proceduralDisk);
+        display.finishQuality();
+        display.draw();
+        LdrImage particles = display.readFrameSync();
+        display.setQuality(QualitySettings::high());
+        double bakedSum = 0.0, particleSum = 0.0;
+        for (int y = 0; y < baked.height; y++)
+            for (int x = 0; x < baked.width; x++) {
+                bakedSum += luma(baked, x, y);
+                particleSum += luma(particles, x, y);
+            }
+        ASSERT_TRUE(std::abs(bakedSum - particleSum) < 0.1 * particleSum, "Baked and procedural disk equally bright");
+    }
+
+    // --------------------------------------------------
+    //  Test 10: Depth 0 disables the ring
+    // --------------------------------------------------
+    {
+        FrameReadback none(0);
+        none.queue(0, 4, 4, 0);
+        LdrImage img;
+        ASSERT_TRUE(none.pending() == 0 && !none.poll(img) && none.getStats().frames == 0,
+                    "Depth-0 ring queues nothing");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+#include "render/progressive.hpp"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for progressive refinement
+//  Tests: convergence to renderFrame, preview cost and error,
+//  pass reporting, odd frame sizes, thin-feature refinement
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+int main() {
+    std::cout << "=== Progressive Refinement Unit Tests ===\n\n";
+
+    Camera cam(15.0f, 0.3f, 0.2f);
+    Render::RenderSettings s;
+    s.width = 96;
+    s.height = 64;
+    s.tileSize = 16;
+    ThreadPool pool(2);
+    Image full = Render::renderFrame(cam, s, pool);
+
+    // --------------------------------------------------
+    //  Test 1: Converged result is the full-res frame,
+    //  and passes report monotone progress
+    // --------------------------------------------------
+    {
+        std::vector<Render::ProgressivePass> passes;
+        Image out = Render::renderProgressive(cam, s, pool, {}, [&](const Image&, const Render::ProgressivePass& p) {
+            passes.push_back(p);
+        });
+        ASSERT_TRUE(out.pixels == full.pixels, "Converged image equals renderFrame");
+
+        bool monotone = true;
+        for (std::size_t i = 1; i < passes.size(); i++)
+            monotone = monotone && passes[i].totalTraced > passes[i - 1].totalTraced && passes[i].index == int(i);
+        ASSERT_TRUE(passes.size() >= 3 && monotone, "Several passes with growing trace counts");
+        ASSERT_TRUE(passes.back().final && passes.back().totalTraced == long(s.width) * s.height,
+                    "Last pass is exact and traced every pixel once");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: The refined preview is cheap and close
+    // --------------------------------------------------
+    {
+        Render::ProgressiveSettings ps;
+        ps.converge = false;
+        long traced = 0;
+        bool anyFinal = false;
+        Image preview = Render::renderProgressive(cam, s, pool, ps, [&](const Image&, const Render::ProgressivePass& p) {
+            traced = p.totalTraced;
+            anyFinal = anyFinal || p.final;
+        });
+
+        double err = 0.0, mean = 0.0;
+        for (std::size_t i = 0; i < full.pixels.size(); i++) {
+            err += std::abs(preview.pixels[i] - full.pixels[i]);
+            mean += std::abs(full.pixels[i]);
+        }
+        ASSERT_TRUE(traced * 2 < long(s.width) * s.height, "Preview traces under half the pixels");
+        ASSERT_TRUE(err < 0.1 * mean, "Preview within 10% mean absolute error");
+        ASSERT_TRUE(!anyFinal, "Preview is not reported as exact");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: The shadow edge gets fully traced: every
+    //  pixel whose 4-neighbourhood changes HitTarget to
+    //  BLACK_HOLE is exact in the preview
+    // --------------------------------------------------
+    {
+        Render::ProgressiveSettings ps;
+        ps.converge = false;
+        ps.baseSpacing = 4;
+        Image preview = Render::renderProgressive(cam, s, pool, ps);
+
+        auto target = [&](int x, int y) {
+            vec3 dir = Render::primaryRayDir(cam, x + 0.5, y + 0.5, s.width, s.height);
+            return Physics::tracePhoton(Physics::Photon{ cam.position, dir }).target;
+        };
+        int edge = 0, exact = 0;
+        for (int y = 1; y < s.height - 1; y++) {
+            for (int x = 1; x < s.width - 1; x++) {
+                bool captured = target(x, y) == Physics::HitTarget::BLACK_HOLE;
+                if (captured == (target(x + 1, y) == Physics::HitTarget::BLACK_HOLE)) continue;
+                edge++;
+                const float* a = preview.at(x, y);
+                const float* b = full.at(x, y);
+                exact += a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+            }
+        }
+        ASSERT_TRUE(edge > 0, "Frame contains a shadow edge");
+        ASSERT_TRUE(exact * 10 >= edge * 9, "At least 90% of shadow-edge pixels are traced exactly");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Odd and degenerate frame sizes
+    // --------------------------------------------------
+    {
+        bool allMatch = true;
+        const int sizes[][2] = { { 37, 23 }, { 1, 17 }, { 19, 1 }, { 5, 5 } };
+        for (const auto& wh : sizes) {
+            Render::RenderSettings o = s;
+            o.width = wh[0];
+            o.height = wh[1];
+            Render::ProgressiveSettings ps;
+            ps.baseSpacing = 8;
+            allMatch = allMatch &&
+                       Render::renderProgressive(cam, o, pool, ps).pixels == Render::renderFrame(cam, o, pool).pixels;
+        }
+        ASSERT_TRUE(allMatch, "Odd and 1-pixel frames converge to renderFrame");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,138 @@
+#include "core/quality.hpp"
+#include "core/shader_library.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+// ============================================================
+//  Unit tests for the shader quality presets
+//  Tests: preset names, cost ordering and reach, clamping and
+//  tags, #define blocks vs the defaults in geodesic.glsl,
+//  injection after #version
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+// "#define QUALITY_X value" lines → { QUALITY_X: value }
+static std::map<std::string, double> qualityDefines(const std::string& source) {
+    std::map<std::string, double> out;
+    std::istringstream in(source);
+    for (std::string line; std::getline(in, line);) {
+        std::istringstream words(line);
+        std::string directive, name, value;
+        words >> directive >> name >> value;
+        if (directive == "#define" && name.rfind("QUALITY_", 0) == 0) out[name] = std::strtod(value.c_str(), nullptr);
+    }
+    return out;
+}
+
+int main() {
+    std::cout << "=== Quality Preset Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: Presets by name; tag() names them back
+    // --------------------------------------------------
+    {
+        bool roundTrip = QualitySettings::presetNames().size() == 4;
+        for (const std::string& name : QualitySettings::presetNames()) {
+            QualitySettings q;
+            roundTrip = roundTrip && QualitySettings::fromName(name, q) && q.tag() == name;
+        }
+        ASSERT_TRUE(roundTrip, "low/medium/high/ultra parse and tag as themselves");
+
+        QualitySettings q = QualitySettings::low();
+        ASSERT_TRUE(!QualitySettings::fromName("extreme", q) && q == QualitySettings::low(),
+                    "Unknown name rejected, settings untouched");
+        ASSERT_TRUE(QualitySettings() == QualitySettings::high(), "Default is high");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Each step up does at least as much work,
+    //  and every preset can still step past ESCAPE_R
+    // --------------------------------------------------
+    {
+        const QualitySettings presets[] = { QualitySettings::low(), QualitySettings::medium(), QualitySettings::high(),
+                                            QualitySettings::ultra() };
+        bool ordered = true, reach = true;
+        for (int i = 0; i < 4; i++) {
+            const QualitySettings& q = presets[i];
+            reach = reach && q.maxSteps * q.stepScale * 0.08f >= 50.0f;   // uStepSize 0.08, ESCAPE_R 50
+            if (i == 0) continue;
+            const QualitySettings& p = presets[i - 1];
+            ordered = ordered && q.maxSteps > p.maxSteps && q.stepScale < p.stepScale &&
+                      q.particleLayers >= p.particleLayers && q.fbmOctaves >= p.fbmOctaves &&
+                      q.diskCrossings >= p.diskCrossings;
+        }
+        ASSERT_TRUE(ordered, "Presets ordered by cost");
+        ASSERT_TRUE(reach, "maxSteps × step reaches ESCAPE_R at every preset");
+        ASSERT_TRUE(QualitySettings::ultra().clamped() == QualitySettings::ultra() &&
+                    QualitySettings::low().clamped() == QualitySettings::low(), "Presets are within the limits");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Clamping and custom tags
+    // --------------------------------------------------
+    {
+        QualitySettings q;
+        q.maxSteps = 1;
+        q.particleLayers = 12;
+        q.diskCrossings = 9;
+        q.fbmOctaves = 0;
+        q.stepScale = 100.0f;
+        QualitySettings c = q.clamped();
+        ASSERT_TRUE(c.maxSteps == 16 && c.particleLayers == 8 && c.diskCrossings == 4 && c.fbmOctaves == 1 &&
+                    c.stepScale == 4.0f, "Out-of-range knobs clamped");
+
+        QualitySettings custom = QualitySettings::high();
+        custom.particleLayers = 6;
+        ASSERT_TRUE(custom.tag() == "custom-s1000x1.000-p6-f4-c4-b1-d1", "Custom tag spells out every knob");
+        custom.fbmOctaves = 3;
+        ASSERT_TRUE(custom.tag() != "custom-s1000x1.000-p6-f4-c4-b1-d1", "Different settings, different cache names");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: The high preset's #defines are the shader
+    //  defaults, so it renders exactly as before
+    // --------------------------------------------------
+    {
+        std::map<std::string, double> high = qualityDefines(QualitySettings::high().defines());
+        std::map<std::string, double> defaults = qualityDefines(ShaderLibrary(BLACKHOLE_SHADER_DIR).load("geodesic.glsl"));
+        ASSERT_TRUE(high.size() == 7 && high == defaults, "high == geodesic.glsl defaults, all 7 knobs");
+
+        std::map<std::string, double> low = qualityDefines(QualitySettings::low().defines());
+        ASSERT_TRUE(low["QUALITY_MAX_STEPS"] == 400 && low["QUALITY_STEP_SCALE"] == 2.0 &&
+                    low["QUALITY_PARTICLE_LAYERS"] == 3 && low["QUALITY_DISK_CROSSINGS"] == 2,
+                    "Low preset #defines");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: Defines go right after #version, with a
+    //  #line so errors keep the file's numbering
+    // --------------------------------------------------
+    {
+        const std::string src = "#version 330 core\nout vec4 c;\nvoid main() { c = vec4(1.0); }\n";
+        const std::string defs = "#define QUALITY_MAX_STEPS 16\n";
+        ASSERT_TRUE(ShaderLibrary::withDefines(src, defs) ==
+                    "#version 330 core\n#define QUALITY_MAX_STEPS 16\n#line 2\nout vec4 c;\nvoid main() { c = vec4(1.0); }\n",
+                    "Injected after #version");
+        ASSERT_TRUE(ShaderLibrary::withDefines("\n#version 330 core\nx\n", defs) ==
+                    "\n#version 330 core\n#define QUALITY_MAX_STEPS 16\n#line 3\nx\n", "Leading blank line counted");
+        ASSERT_TRUE(ShaderLibrary::withDefines("x\n", defs) == "#define QUALITY_MAX_STEPS 16\n#line 1\nx\n",
+                    "No #version: defines first");
+        ASSERT_TRUE(ShaderLibrary::withDefines(src, "") == src, "No defines, source unchanged");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
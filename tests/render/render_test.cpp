@@ -0,0 +1,243 @@
+#include "render/cpu_renderer.hpp"
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for the headless CPU renderer
+//  Tests: work-stealing pool, tiling, ray generation, frames
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+int main() {
+    std::cout << "=== Headless Renderer Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: parallelFor runs every index exactly once
+    //  Uneven per-index cost forces the workers to steal
+    // --------------------------------------------------
+    {
+        ThreadPool pool(4);
+        const std::size_t count = 1000;
+        std::vector<std::atomic<int>> hits(count);
+        for (auto& h : hits) h = 0;
+
+        pool.parallelFor(count, [&](std::size_t i, unsigned) {
+            volatile double sink = 0.0;
+            for (std::size_t k = 0; k < (i % 7) * 2000; k++) sink = sink + std::sqrt(double(k));
+            hits[i]++;
+        });
+
+        bool allOnce = true;
+        for (auto& h : hits) allOnce = allOnce && (h == 1);
+        ASSERT_TRUE(allOnce, "Every index executed exactly once");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Pool is reusable across many jobs
+    // --------------------------------------------------
+    {
+        ThreadPool pool(3);
+        std::atomic<long> total{0};
+        for (int job = 0; job < 50; job++) {
+            pool.parallelFor(17, [&](std::size_t i, unsigned) { total += static_cast<long>(i); });
+        }
+        ASSERT_TRUE(total == 50L * (16 * 17 / 2), "Back-to-back jobs all complete");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Tiles cover the frame, including ragged edges
+    // --------------------------------------------------
+    {
+        auto tiles = Render::makeTiles(50, 33, 16);
+        long area = 0;
+        for (const auto& t : tiles) area += long(t.x1 - t.x0) * (t.y1 - t.y0);
+        ASSERT_TRUE(tiles.size() == 12, "50x33 frame with 16px tiles → 4x3 tiles");
+        ASSERT_TRUE(area == 50L * 33, "Tiles cover every pixel once");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Centre ray looks straight down camera.forward
+    // --------------------------------------------------
+    {
+        Camera cam(15.0f, 0.4f, 0.2f);
+        vec3 d = Render::primaryRayDir(cam, 50.0, 30.0, 100, 60);
+        ASSERT_NEAR(d.dot(cam.forward), 1.0, 1e-9, "Centre pixel ray = forward");
+
+        // Top-left corner: up and left of forward
+        vec3 tl = Render::primaryRayDir(cam, 0.0, 0.0, 100, 60);
+        ASSERT_TRUE(tl.dot(cam.up) > 0.0 && tl.dot(cam.right) < 0.0, "Row 0 is top, column 0 is left");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: Multithreaded frame matches single-threaded frame
+    // --------------------------------------------------
+    {
+        Camera cam(15.0f, 0.0f, 0.3f);
+        Render::RenderSettings s;
+        s.width = 48;
+        s.height = 32;
+        s.tileSize = 8;
+
+        ThreadPool one(1), many(4);
+        Image a = Render::renderFrame(cam, s, one);
+        Image b = Render::renderFrame(cam, s, many);
+
+        bool same = a.pixels == b.pixels;
+        bool finite = true;
+        for (float v : a.pixels) finite = finite && std::isfinite(v);
+        ASSERT_TRUE(same, "Frame is independent of thread count");
+        ASSERT_TRUE(finite, "Frame has no NaN/Inf");
+
+        // Looking at the hole from r=15: centre pixel is in the shadow (only glow left)
+        const float* c = a.at(24, 16);
+        vec3 glow = Shading::photonGlow(Render::primaryRayDir(cam, 24.5, 16.5, 48, 32), cam.position);
+        ASSERT_NEAR(c[0], glow.x, 1e-5, "Centre pixel is black hole shadow + glow");
+    }
+
+    // --------------------------------------------------
+    //  Test 6: Adaptive and Binet engines render the same scene
+    // --------------------------------------------------
+    {
+        Camera cam(15.0f, 0.0f, 0.3f);
+        Render::RenderSettings s;
+        s.width = 48;
+        s.height = 32;
+        s.tileSize = 8;
+
+        ThreadPool pool(2);
+        Image fixed = Render::renderFrame(cam, s, pool);
+        s.integrator = Render::Integrator::AdaptiveDOPRI5;
+        Image adaptive = Render::renderFrame(cam, s, pool);
+        s.integrator = Render::Integrator::Binet;
+        Image binet = Render::renderFrame(cam, s, pool);
+
+        // Pixels differ only where the disk crossing moved by < 1 step
+        int differing = 0, differingBinet = 0;
+        for (std::size_t i = 0; i < fixed.pixels.size(); i += 3) {
+            if (std::abs(fixed.pixels[i] - adaptive.pixels[i]) > 0.05f) differing++;
+            if (std::abs(fixed.pixels[i] - binet.pixels[i]) > 0.05f) differingBinet++;
+        }
+        const float* c = adaptive.at(24, 16);
+        ASSERT_NEAR(c[0], fixed.at(24, 16)[0], 1e-5, "Adaptive centre pixel is the same shadow");
+        ASSERT_TRUE(differing < s.width * s.height / 10, "Adaptive frame agrees with fixed-step frame");
+        ASSERT_TRUE(differingBinet < s.width * s.height / 10, "Binet frame agrees with fixed-step frame");
+    }
+
+    // --------------------------------------------------
+    //  Test 7: Symmetry-table frame, table reused across yaw
+    // --------------------------------------------------
+    {
+        Camera cam(15.0f, 0.0f, 0.3f);
+        Render::RenderSettings s;
+        s.width = 48;
+        s.height = 32;
+        s.tileSize = 8;
+
+        ThreadPool pool(2);
+        Image fixed = Render::renderFrame(cam, s, pool);
+        s.integrator = Render::Integrator::SymmetryTable;
+        s.tableSize = 512;
+        Render::FrameCache cache;
+        Image table = Render::renderFrame(cam, s, pool, &cache);
+
+        int differing = 0;
+        for (std::size_t i = 0; i < fixed.pixels.size(); i += 3) {
+            if (std::abs(fixed.pixels[i] - table.pixels[i]) > 0.05f) differing++;
+        }
+        ASSERT_TRUE(differing < s.width * s.height / 10, "Table frame agrees with fixed-step frame");
+
+        // Yaw keeps the camera radius, so the cached orbits stay valid
+        cam.yaw += 1.0f;
+        cam.update();
+        Image reused = Render::renderFrame(cam, s, pool, &cache);
+        Image rebuilt = Render::renderFrame(cam, s, pool);
+        ASSERT_TRUE(reused.pixels == rebuilt.pixels, "Cached table reused across yaw matches a fresh table");
+    }
+
+    // --------------------------------------------------
+    //  Test 8: Geodesic G-buffer: static camera only reshades,
+    //  and the reshaded frame equals a full render
+    // --------------------------------------------------
+    {
+        Camera cam(15.0f, 0.2f, 0.3f);
+        Render::RenderSettings s;
+        s.width = 48;
+        s.height = 32;
+        s.tileSize = 8;
+
+        ThreadPool pool(2);
+        Render::FrameCache cache;
+        Render::renderFrame(cam, s, pool, &cache);
+        s.time = 2.5f;
+        Image reshaded = Render::renderFrame(cam, s, pool, &cache);
+        Image direct = Render::renderFrame(cam, s, pool);
+        ASSERT_TRUE(cache.gbuffer.traces == 1, "Time-only change reuses the traced geodesics");
+        ASSERT_TRUE(reshaded.pixels == direct.pixels, "Reshaded frame matches a full render");
+
+        cam.update();
+        Render::renderFrame(cam, s, pool, &cache);
+        ASSERT_TRUE(cache.gbuffer.traces == 1, "Camera::update() without motion keeps the cache");
+
+        cam.yaw += 0.05f;
+        cam.update();
+        Render::renderFrame(cam, s, pool, &cache);
+        s.integrator = Render::Integrator::Binet;
+        Render::renderFrame(cam, s, pool, &cache);
+        ASSERT_TRUE(cache.gbuffer.traces == 3, "Camera motion and integrator change re-trace");
+    }
+
+    // --------------------------------------------------
+    //  Test 9: Camera revision only moves on real changes
+    // --------------------------------------------------
+    {
+        Camera cam(15.0f, 0.0f, 0.3f);
+        std::uint64_t r0 = cam.revision;
+        cam.update();
+        ASSERT_TRUE(cam.revision == r0, "Idle update() keeps the revision");
+        cam.pitch += 0.1f;
+        cam.update();
+        ASSERT_TRUE(cam.revision == r0 + 1, "Pitch change bumps the revision");
+        cam.fov_scale *= 0.5f;
+        cam.update();
+        ASSERT_TRUE(cam.revision == r0 + 2, "FOV change bumps the revision");
+    }
+
+    // --------------------------------------------------
+    //  Test 10: Instrumentation compiles out by default
+    // --------------------------------------------------
+    {
+        Camera cam;
+        Render::RenderSettings s;
+        s.width = 16;
+        s.height = 12;
+        ThreadPool pool(1);
+        Render::FrameProfile profile;
+        Render::renderFrame(cam, s, pool, nullptr, &profile);
+        ASSERT_TRUE(profile.empty() == !BLACKHOLE_INSTRUMENT, "FrameProfile filled only in instrumented builds");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,144 @@
+#include "core/resolution.hpp"
+#include <cmath>
+#include <iostream>
+#include <random>
+
+// ============================================================
+//  Unit tests for the dynamic resolution controller
+//  Driven by a simulated scene pass whose cost is ∝ scale².
+//  Tests: convergence under the budget, no oscillation at the
+//  band edge or under noise, immediate shrink on a spike,
+//  delayed growth, snapping and clamping, forced scales
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+// Scene pass costing `fullMs` at scale 1
+static double cost(double fullMs, float scale) { return fullMs * scale * scale; }
+
+static bool onStep(float scale, float step) {
+    float n = scale / step;
+    return std::abs(n - std::round(n)) < 1e-4f;
+}
+
+int main() {
+    std::cout << "=== Dynamic Resolution Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: An over-budget scene converges inside the
+    //  band and stays there
+    // --------------------------------------------------
+    {
+        ResolutionController rc;
+        const double fullMs = 30.0;   // 2.5× the 12 ms budget at full scale
+        for (int f = 0; f < 200; f++) rc.update(cost(fullMs, rc.scale()));
+        long settledChanges = rc.changes();
+        for (int f = 0; f < 200; f++) rc.update(cost(fullMs, rc.scale()));
+        double ms = cost(fullMs, rc.scale());
+        ASSERT_TRUE(ms <= 12.0 * 1.15 && ms >= 12.0 * 0.85, "Converged cost inside the ±15% band");
+        ASSERT_TRUE(settledChanges <= 3, "Converges in a few changes");
+        ASSERT_TRUE(rc.changes() == settledChanges, "No changes once converged");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: No oscillation when the cost sits right at
+    //  the band edge, or under ±10% frame noise
+    // --------------------------------------------------
+    {
+        ResolutionController rc;
+        rc.setScale(0.75f);
+        long before = rc.changes();
+        const double fullMs = 12.0 * 1.15 / (0.75 * 0.75);   // Exactly on the upper edge at 0.75
+        for (int f = 0; f < 500; f++) rc.update(cost(fullMs, rc.scale()) * 0.999);
+        ASSERT_TRUE(rc.changes() == before && rc.scale() == 0.75f, "Band edge holds the scale");
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> noise(0.9, 1.1);
+        ResolutionController noisy;
+        for (int f = 0; f < 1000; f++) noisy.update(cost(20.0, noisy.scale()) * noise(rng));
+        ASSERT_TRUE(noisy.changes() <= 4, "Noisy frames don't make the scale flap");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: A spike shrinks on the first frame; growth
+    //  waits for settleFrames under-budget frames
+    // --------------------------------------------------
+    {
+        ResolutionSettings s;
+        ResolutionController rc(s);
+        for (int f = 0; f < 50; f++) rc.update(cost(10.0, rc.scale()));
+        ASSERT_TRUE(rc.scale() == 1.0f && rc.changes() == 0, "Under budget at full scale stays there");
+
+        ASSERT_TRUE(rc.update(cost(80.0, rc.scale())), "Spike shrinks immediately");
+        ASSERT_TRUE(rc.scale() < 1.0f, "... to a lower scale");
+
+        // Back to a cheap scene: the settle period and the under-band run both gate growth
+        float shrunk = rc.scale();
+        int waited = 0;
+        while (rc.scale() == shrunk && waited < 100) {
+            rc.update(cost(4.0, rc.scale()));
+            waited++;
+        }
+        ASSERT_TRUE(waited >= 2 * s.settleFrames, "Growth waits out settle + settleFrames under budget");
+        ASSERT_TRUE(rc.scale() > shrunk, "... then grows");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Scales are multiples of step within limits
+    // --------------------------------------------------
+    {
+        ResolutionSettings s;
+        s.minScale = 0.5f;
+        s.maxScale = 1.0f;
+        ResolutionController rc(s);
+        bool snapped = true;
+        for (double fullMs : { 13.9, 15.0, 21.0, 33.0, 200.0, 5.0 }) {
+            for (int f = 0; f < 60; f++) {
+                rc.update(cost(fullMs, rc.scale()));
+                snapped = snapped && onStep(rc.scale(), s.step);
+            }
+        }
+        ASSERT_TRUE(snapped, "Every scale is a multiple of step");
+
+        ResolutionController heavy(s);
+        for (int f = 0; f < 60; f++) heavy.update(1000.0);
+        ASSERT_NEAR(heavy.scale(), 0.5f, 1e-6f, "Clamped at minScale however slow");
+        ResolutionController light(s);
+        for (int f = 0; f < 60; f++) light.update(0.1);
+        ASSERT_NEAR(light.scale(), 1.0f, 1e-6f, "Clamped at maxScale however fast");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: setScale snaps, clamps and restarts settling
+    // --------------------------------------------------
+    {
+        ResolutionController rc;
+        rc.setScale(0.7f);
+        ASSERT_NEAR(rc.scale(), 0.6875f, 1e-6f, "setScale snaps down to a step");
+        rc.setScale(0.1f);
+        ASSERT_NEAR(rc.scale(), 0.5f, 1e-6f, "setScale clamps to minScale");
+        ASSERT_TRUE(!rc.update(1000.0), "Settle period follows a forced scale");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,84 @@
+#include "core/shader_library.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+// ============================================================
+//  Unit tests for the shader source library
+//  Tests: every shader embedded, embedded == on-disk sources
+//  after #include splicing, include-once, missing files
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+static int count(const std::string& text, const std::string& needle) {
+    int n = 0;
+    for (std::size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) n++;
+    return n;
+}
+
+int main() {
+    std::cout << "=== Shader Library Unit Tests ===\n\n";
+
+    const std::string dir = BLACKHOLE_SHADER_DIR;
+    ShaderLibrary disk(dir), embedded;
+
+    // --------------------------------------------------
+    //  Test 1: Every file in src/shaders is embedded
+    // --------------------------------------------------
+    std::vector<std::string> onDisk;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        std::string ext = entry.path().extension().string();
+        if (ext == ".vert" || ext == ".frag" || ext == ".glsl") onDisk.push_back(entry.path().filename().string());
+    }
+    std::sort(onDisk.begin(), onDisk.end());
+    std::vector<std::string> names = ShaderLibrary::embeddedNames();
+    ASSERT_TRUE(ShaderLibrary::hasEmbedded() && embedded.isEmbedded() && !disk.isEmbedded(), "Built with embedded shaders");
+    ASSERT_TRUE(!onDisk.empty() && names == onDisk, "Embedded set == src/shaders");
+
+    // --------------------------------------------------
+    //  Test 2: Embedded and on-disk sources are identical
+    //  after #include splicing
+    // --------------------------------------------------
+    {
+        bool same = true;
+        for (const std::string& name : onDisk) {
+            std::string a = disk.load(name), b = embedded.load(name);
+            same = same && !a.empty() && a == b;
+        }
+        ASSERT_TRUE(same, "Embedded sources == files, includes resolved");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Includes are spliced once each, with #line
+    // --------------------------------------------------
+    {
+        std::string scene = embedded.load("blackhole.frag");
+        std::string geodesic = embedded.load("geodesic.glsl");
+        ASSERT_TRUE(count(scene, "\n#include") == 0, "No #include left for the GLSL compiler");
+        ASSERT_TRUE(count(scene, geodesic) == 1, "geodesic.glsl spliced once (shading.glsl includes it too)");
+        ASSERT_TRUE(scene.rfind("#version 330 core", 0) == 0 && count(scene, "#line ") >= 2,
+                    "#version first, #line after each include");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Missing files load as ""
+    // --------------------------------------------------
+    {
+        ASSERT_TRUE(embedded.load("missing.frag").empty() && disk.load("missing.frag").empty(),
+                    "Missing shader loads as empty");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
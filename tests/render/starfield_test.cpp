@@ -0,0 +1,150 @@
+#include "render/starfield.hpp"
+#include <cmath>
+#include <iostream>
+
+// ============================================================
+//  Unit tests for the baked starfield cube map
+//  Tests: face directions vs GL cube-map face selection, texels
+//  == Shading::starfield at their centres, thread-count
+//  independence, supersampled texels, stars present
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+// What the GPU does with a samplerCube direction (OpenGL 4.6 §8.13, table 8.19)
+static void selectFace(const vec3& d, int& face, double& s, double& t) {
+    double ax = std::abs(d.x), ay = std::abs(d.y), az = std::abs(d.z);
+    double sc, tc, ma;
+    if (ax >= ay && ax >= az) {
+        face = d.x > 0 ? 0 : 1;
+        sc = d.x > 0 ? -d.z : d.z;
+        tc = -d.y;
+        ma = ax;
+    } else if (ay >= az) {
+        face = d.y > 0 ? 2 : 3;
+        sc = d.x;
+        tc = d.y > 0 ? d.z : -d.z;
+        ma = ay;
+    } else {
+        face = d.z > 0 ? 4 : 5;
+        sc = d.z > 0 ? d.x : -d.x;
+        tc = -d.y;
+        ma = az;
+    }
+    s = 0.5 * (sc / ma + 1.0);
+    t = 0.5 * (tc / ma + 1.0);
+}
+
+static bool sameTexels(const Render::StarfieldCubemap& a, const Render::StarfieldCubemap& b) {
+    if (a.size != b.size) return false;
+    for (int f = 0; f < 6; f++)
+        if (a.faces[f] != b.faces[f]) return false;
+    return true;
+}
+
+int main() {
+    std::cout << "=== Starfield Cube Map Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: cubeFaceDirection inverts the GPU's face
+    //  selection, so texel (i, j) is where it is sampled
+    // --------------------------------------------------
+    {
+        bool roundTrip = true, unit = true;
+        for (int face = 0; face < 6; face++)
+            for (int j = 0; j < 8; j++)
+                for (int i = 0; i < 8; i++) {
+                    double s = (i + 0.5) / 8.0, t = (j + 0.5) / 8.0;
+                    vec3 d = Render::cubeFaceDirection(face, s, t);
+                    int f;
+                    double s2, t2;
+                    selectFace(d, f, s2, t2);
+                    roundTrip = roundTrip && f == face && std::abs(s2 - s) < 1e-12 && std::abs(t2 - t) < 1e-12;
+                    unit = unit && std::abs(d.length() - 1.0) < 1e-12;
+                }
+        ASSERT_TRUE(roundTrip, "Every texel centre maps back to its face and (s, t)");
+        ASSERT_TRUE(unit, "Directions are unit length");
+    }
+
+    ThreadPool serial(1), pool(4);
+
+    // --------------------------------------------------
+    //  Test 2: One sample per texel is exactly the CPU
+    //  (= GLSL) starfield at the texel centre
+    // --------------------------------------------------
+    const int N = 64;
+    Render::StarfieldCubemap map = Render::bakeStarfield(N, pool);
+    {
+        ASSERT_TRUE(map.size == N && map.bytes() == 6u * N * N * 3 * sizeof(float), "6 faces of N×N RGB floats");
+        bool exact = true;
+        for (int face = 0; face < 6; face++)
+            for (int j = 0; j < N; j += 3)
+                for (int i = 0; i < N; i += 5) {
+                    vec3 c = Shading::starfield(Render::cubeFaceDirection(face, (i + 0.5) / N, (j + 0.5) / N));
+                    const float* p = map.texel(face, i, j);
+                    exact = exact && p[0] == static_cast<float>(c.x) && p[1] == static_cast<float>(c.y) &&
+                            p[2] == static_cast<float>(c.z);
+                }
+        ASSERT_TRUE(exact, "Texels == Shading::starfield at their centres");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: The bake does not depend on the pool size
+    // --------------------------------------------------
+    {
+        ASSERT_TRUE(sameTexels(map, Render::bakeStarfield(N, serial)), "4 threads == 1 thread");
+        ASSERT_TRUE(sameTexels(Render::bakeStarfield(16, pool, 3), Render::bakeStarfield(16, serial, 3)),
+                    "Supersampled bake is deterministic too");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: A supersampled texel is the mean of the
+    //  texels it covers at the finer size
+    // --------------------------------------------------
+    {
+        Render::StarfieldCubemap coarse = Render::bakeStarfield(N / 2, pool, 2);
+        bool mean = true;
+        for (int face = 0; face < 6; face++)
+            for (int j = 0; j < N / 2; j++)
+                for (int i = 0; i < N / 2; i++)
+                    for (int c = 0; c < 3; c++) {
+                        double sum = 0.0;
+                        for (int dy = 0; dy < 2; dy++)
+                            for (int dx = 0; dx < 2; dx++) sum += map.texel(face, 2 * i + dx, 2 * j + dy)[c];
+                        mean = mean && std::abs(coarse.texel(face, i, j)[c] - 0.25 * sum) < 1e-6;
+                    }
+        ASSERT_TRUE(mean, "2×2 samples == box filter of the 2N bake");
+    }
+
+    // --------------------------------------------------
+    //  Test 5: The sky has stars on every face, and is
+    //  mostly black between them
+    // --------------------------------------------------
+    {
+        Render::StarfieldCubemap sky = Render::bakeStarfield(256, pool);
+        bool everyFace = true;
+        long lit = 0, total = 0;
+        for (int face = 0; face < 6; face++) {
+            long faceLit = 0;
+            for (std::size_t k = 0; k < sky.faces[face].size(); k += 3) faceLit += sky.faces[face][k] > 0.0f;
+            everyFace = everyFace && faceLit > 0;
+            lit += faceLit;
+            total += static_cast<long>(sky.faces[face].size() / 3);
+        }
+        ASSERT_TRUE(everyFace, "Stars on every face");
+        ASSERT_TRUE(lit * 20 < total, "Under 5% of texels lit");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,138 @@
+#include "core/frame_timing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+// ============================================================
+//  Unit tests for the frame timing telemetry
+//  Tests: nearest-rank percentiles, rolling window eviction,
+//  summaries, series order, text report, CSV rows, periodic dump
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+int main() {
+    std::cout << "=== Frame Timing Telemetry Unit Tests ===\n\n";
+
+    // --------------------------------------------------
+    //  Test 1: Percentiles over 1..100 (inserted shuffled)
+    // --------------------------------------------------
+    {
+        RollingHistogram h(100);
+        for (int i = 0; i < 100; i++) h.add((i * 37) % 100 + 1);
+        ASSERT_NEAR(h.percentile(50.0), 50.0, 1e-9, "p50 of 1..100");
+        ASSERT_NEAR(h.percentile(95.0), 95.0, 1e-9, "p95 of 1..100");
+        ASSERT_NEAR(h.percentile(99.0), 99.0, 1e-9, "p99 of 1..100");
+        ASSERT_NEAR(h.percentile(100.0), 100.0, 1e-9, "p100 is the max");
+        ASSERT_NEAR(h.percentile(0.0), 1.0, 1e-9, "p0 is the min");
+
+        RollingHistogram::Summary s = h.summary();
+        ASSERT_TRUE(s.count == 100 && s.p50 == 50.0 && s.p95 == 95.0 && s.p99 == 99.0 && s.max == 100.0,
+                    "Summary agrees with percentile()");
+        ASSERT_NEAR(s.mean, 50.5, 1e-9, "Mean of 1..100");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: The window keeps only the newest samples,
+    //  so a regression shows up once it fills the window
+    // --------------------------------------------------
+    {
+        RollingHistogram h(10);
+        ASSERT_TRUE(h.count() == 0 && h.percentile(50.0) == 0.0 && h.last() == 0.0, "Empty window reports 0");
+        for (int i = 0; i < 10; i++) h.add(5.0);
+        for (int i = 0; i < 3; i++) h.add(20.0);
+        ASSERT_TRUE(h.count() == 10 && h.last() == 20.0, "Window capped at its size");
+        ASSERT_TRUE(h.at(0) == 5.0 && h.at(9) == 20.0 && h.at(6) == 5.0 && h.at(7) == 20.0, "at() runs oldest to newest");
+        ASSERT_NEAR(h.percentile(50.0), 5.0, 1e-9, "3 slow frames in 10: p50 unchanged");
+        ASSERT_NEAR(h.percentile(95.0), 20.0, 1e-9, "... but p95 catches them");
+        for (int i = 0; i < 10; i++) h.add(20.0);
+        ASSERT_NEAR(h.percentile(50.0), 20.0, 1e-9, "Old samples evicted");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Series keep first-recorded order; report
+    //  and CSV carry every series
+    // --------------------------------------------------
+    {
+        FrameTelemetry t(60);
+        for (int f = 0; f < 30; f++) {
+            t.record("scene", 8.0 + f % 3);
+            t.record("bloom_down0", 0.5);
+            t.record("composite", 0.25);
+        }
+        auto names = t.names();
+        ASSERT_TRUE(names.size() == 3 && names[0] == "scene" && names[1] == "bloom_down0" && names[2] == "composite",
+                    "Series listed in pipeline order");
+        ASSERT_TRUE(t.find("blur0") == nullptr && t.summary("blur0").count == 0, "Unknown series is empty");
+        ASSERT_NEAR(t.summary("scene").p99, 10.0, 1e-9, "Per-series percentiles");
+
+        std::string report = t.report();
+        ASSERT_TRUE(report.find("scene") != std::string::npos && report.find("composite") != std::string::npos &&
+                    std::count(report.begin(), report.end(), '\n') == 4, "Report: header + one line per series");
+
+        const char* path = "telemetry_test.csv";
+        std::remove(path);
+        bool ok = t.appendCsv(path, 1.0) && t.appendCsv(path, 2.0);
+        std::ifstream in(path);
+        std::string line, header;
+        std::getline(in, header);
+        int rows = 0;
+        bool sceneRow = false;
+        while (std::getline(in, line)) {
+            rows++;
+            if (line.rfind("2.000,scene,30,", 0) == 0) sceneRow = true;
+        }
+        ASSERT_TRUE(ok && header == "time_s,series,count,mean_ms,p50_ms,p95_ms,p99_ms,max_ms" && rows == 6,
+                    "CSV: one header, then a row per series per dump");
+        ASSERT_TRUE(sceneRow, "CSV row has time, name and sample count");
+        std::remove(path);
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Periodic dump fires once per interval
+    // --------------------------------------------------
+    {
+        FrameTelemetry t;
+        t.record("cpu_frame", 16.0);
+        ASSERT_TRUE(!t.tick(0.0) && !t.tick(100.0), "Disabled by default");
+
+        const char* path = "telemetry_dump_test.csv";
+        std::remove(path);
+        t.setDump(1.0, path, false);
+        int dumps = 0;
+        for (int f = 0; f <= 300; f++) dumps += t.tick(f / 100.0);   // 3 s at 100 Hz
+        ASSERT_TRUE(dumps == 3, "One dump per second");
+        std::ifstream in(path);
+        int lines = 0;
+        for (std::string line; std::getline(in, line);) lines++;
+        ASSERT_TRUE(lines == 4, "Each dump appended to the CSV");
+        std::remove(path);
+
+        t.setDump(0.0);
+        ASSERT_TRUE(!t.tick(10.0), "Interval 0 turns it off");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}
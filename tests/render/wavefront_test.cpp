@@ -0,0 +1,158 @@
+#include "render/wavefront_renderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// ============================================================
+//  Unit tests for the wavefront photon scheduler
+//  Tests: identical hits to traceBatch for any wave length and
+//  pool size, every ray delivered once, step accounting vs
+//  tracePhoton, lane utilization vs pack-at-a-time, frames
+// ============================================================
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define ASSERT_TRUE(cond, name) \
+    if (cond) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << "\n"; \
+    }
+
+#define ASSERT_NEAR(val, expected, tol, name) \
+    if (std::abs((val) - (expected)) < (tol)) { \
+        tests_passed++; \
+    } else { \
+        tests_failed++; \
+        std::cerr << "  FAIL: " << name << " — expected " << expected << " ± " << tol \
+                  << ", got " << val << "\n"; \
+    }
+
+static bool sameHit(const Physics::HitRecord& a, const Physics::HitRecord& b) {
+    return a.target == b.target && a.diskR == b.diskR && a.pos.x == b.pos.x && a.pos.y == b.pos.y &&
+           a.pos.z == b.pos.z && a.dir.x == b.dir.x && a.dir.y == b.dir.y && a.dir.z == b.dir.z;
+}
+
+int main() {
+    std::cout << "=== Wavefront Scheduler Unit Tests (" << simd::ISA << ", "
+              << simd::dpack::N << " lanes) ===\n\n";
+
+    // Camera fan across the shadow edge, the disk and open sky, so
+    // ray lengths vary from a few hundred steps to near-critical orbits.
+    // 203 rays: not a multiple of any lane count.
+    Physics::PhotonBatch batch;
+    Camera cam(15.0f, 0.3f, 0.15f);
+    for (int i = 0; i < 203; i++) {
+        double px = 4.0 + 0.29 * i, py = 20.0 + 6.0 * std::sin(i * 0.37);
+        batch.push({ cam.position, Render::primaryRayDir(cam, px, py, 64, 48) });
+    }
+    std::vector<Physics::HitRecord> reference = Physics::traceBatch(batch);
+
+    // --------------------------------------------------
+    //  Test 1: Same HitRecords as traceBatch, whatever the
+    //  wave length and pool size
+    // --------------------------------------------------
+    {
+        bool allSame = true;
+        const int configs[][2] = { { 16, 256 }, { 1, 7 }, { 5, 1 }, { 64, 1000 }, { 0, 32 } };
+        for (const auto& c : configs) {
+            Physics::WavefrontSettings ws;
+            ws.stepsPerWave = c[0];
+            ws.slots = c[1];
+            std::vector<Physics::HitRecord> hits = Physics::traceWavefront(batch, ws);
+            for (std::size_t i = 0; i < hits.size(); i++) allSame = allSame && sameHit(hits[i], reference[i]);
+        }
+        ASSERT_TRUE(allSame, "traceWavefront == traceBatch for every wave length / pool size");
+
+        Physics::PhotonBatch empty;
+        Physics::WavefrontStats st;
+        ASSERT_TRUE(Physics::traceWavefront(empty, {}, &st).empty() && st.waves == 0, "Empty source → no waves");
+    }
+
+    // --------------------------------------------------
+    //  Test 2: Every id is finished exactly once
+    // --------------------------------------------------
+    {
+        std::vector<int> seen(batch.size(), 0);
+        std::size_t cursor = 0;
+        Physics::Wavefront wavefront;
+        Physics::WavefrontStats st = wavefront.run(
+            [&](Physics::Photon& p, std::size_t& id) {
+                if (cursor == batch.size()) return false;
+                id = cursor;
+                p = batch.photon(cursor++);
+                return true;
+            },
+            [&](std::size_t id, const Physics::HitRecord&) { seen[id]++; });
+        ASSERT_TRUE(std::all_of(seen.begin(), seen.end(), [](int n) { return n == 1; }), "Each ray finished once");
+        ASSERT_TRUE(st.rays == long(batch.size()) && st.waves > 1, "All rays pulled over several waves");
+    }
+
+    // --------------------------------------------------
+    //  Test 3: Live lane steps equal tracePhoton's steps;
+    //  compaction keeps lanes fuller than pack-at-a-time
+    // --------------------------------------------------
+    {
+        long scalarSteps = 0;
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            Physics::TraceStats ts;
+            Physics::tracePhoton(batch.photon(i), &ts);
+            scalarSteps += ts.steps;
+        }
+
+        Physics::WavefrontStats wave, packs;
+        Physics::traceWavefront(batch, {}, &wave);
+        Physics::WavefrontSettings toCompletion;
+        toCompletion.stepsPerWave = 0;
+        toCompletion.slots = simd::dpack::N;
+        Physics::traceWavefront(batch, toCompletion, &packs);
+
+        ASSERT_TRUE(wave.laneSteps == scalarSteps && packs.laneSteps == scalarSteps,
+                    "Live lane steps equal the scalar step count");
+        ASSERT_TRUE(wave.utilization() > packs.utilization(), "Wavefront utilization beats pack-at-a-time");
+        ASSERT_TRUE(wave.utilization() > 0.9, "Wavefront lanes over 90% busy");
+        ASSERT_TRUE(wave.packSteps < packs.packSteps, "Fewer pack steps than pack-at-a-time");
+    }
+
+    // --------------------------------------------------
+    //  Test 4: Frames match renderFrame (double and float),
+    //  other integrators fall back to it
+    // --------------------------------------------------
+    {
+        Render::RenderSettings s;
+        s.width = 48;
+        s.height = 32;
+        ThreadPool pool(3);
+
+        double worst = 0.0;
+        Physics::WavefrontStats st;
+        Image wave = Render::renderFrameWavefront(cam, s, pool, {}, &st);
+        Image tiles = Render::renderFrame(cam, s, pool);
+        for (std::size_t i = 0; i < wave.pixels.size(); i++)
+            worst = std::max(worst, double(std::abs(wave.pixels[i] - tiles.pixels[i])));
+        ASSERT_NEAR(worst, 0.0, 1e-4, "Wavefront frame matches renderFrame");
+        ASSERT_TRUE(st.rays == long(s.width) * s.height, "One ray per pixel across workers");
+
+        s.precision = Render::Precision::Float;
+        Physics::WavefrontStats fst;
+        Image fwave = Render::renderFrameWavefront(cam, s, pool, {}, &fst);
+        Image ftiles = Render::renderFrame(cam, s, pool);
+        long differ = 0;
+        for (std::size_t i = 0; i < fwave.pixels.size(); i++) differ += std::abs(fwave.pixels[i] - ftiles.pixels[i]) > 1e-2f;
+        ASSERT_TRUE(differ * 100 < long(fwave.pixels.size()) && fst.lanes == simd::fpack::N,
+                    "Float frame within 1% of renderFrame, float lane width");
+
+        s.precision = Render::Precision::Double;
+        s.integrator = Render::Integrator::Binet;
+        Physics::WavefrontStats bst;
+        ASSERT_TRUE(Render::renderFrameWavefront(cam, s, pool, {}, &bst).pixels == Render::renderFrame(cam, s, pool).pixels &&
+                    bst.rays == 0, "Non-RK4 integrators fall back to renderFrame");
+    }
+
+    // --- Summary ---
+    std::cout << "\nResults: " << tests_passed << " passed, " << tests_failed << " failed\n";
+    return tests_failed > 0 ? 1 : 0;
+}